@@ -16,6 +16,8 @@ endif()
 
 option(SERAC_ENABLE_LUMBERJACK "Enable Axom's Lumberjack component" ON)
 
+option(SERAC_ENABLE_J2_AD_TANGENT "Compute the tangent of the J2 material with dual numbers instead of the hand-coded tangent" OFF)
+
 # Only enable Serac's code checks by default if it is the top-level project
 # or a user overrides it
 if("${CMAKE_PROJECT_NAME}" STREQUAL "serac")
@@ -60,6 +60,7 @@ endif()
 # Options that change behavior
 #--------------------------------------------------------------------------
 set(SERAC_USE_LUMBERJACK ${SERAC_ENABLE_LUMBERJACK})
+set(SERAC_USE_J2_AD_TANGENT ${SERAC_ENABLE_J2_AD_TANGENT})
 
 
 #------------------------------------------------------------------------------
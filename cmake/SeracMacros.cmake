@@ -125,3 +125,47 @@ macro(serac_convert_to_native_escaped_file_path path output)
     file(TO_NATIVE_PATH ${path} ${output})
     string(REPLACE "\\" "\\\\"  ${output} "${${output}}")
 endmacro(serac_convert_to_native_escaped_file_path)
+
+
+#------------------------------------------------------------------------------
+# serac_add_benchmark( NAME          <name>
+#                      SOURCES       [source1 [source2 ...]]
+#                      DEPENDS_ON    [dep1 [dep2 ...]]
+#                      NUM_MPI_TASKS <num tasks> )
+#
+# Adds a Google Benchmark executable and registers a short run of it with ctest
+# under the "benchmark" label. The executable is also added to the
+# serac_benchmarks target, which builds all of the benchmarks.
+#------------------------------------------------------------------------------
+macro(serac_add_benchmark)
+
+    set(options)
+    set(singleValueArgs NAME NUM_MPI_TASKS)
+    set(multiValueArgs  SOURCES DEPENDS_ON)
+
+    # Parse the arguments to the macro
+    cmake_parse_arguments(arg
+         "${options}" "${singleValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    if(NOT DEFINED arg_NUM_MPI_TASKS)
+        set(arg_NUM_MPI_TASKS 1)
+    endif()
+
+    if(NOT TARGET serac_benchmarks)
+        add_custom_target(serac_benchmarks)
+    endif()
+
+    blt_add_executable( NAME        ${arg_NAME}
+                        SOURCES     ${arg_SOURCES}
+                        OUTPUT_DIR  ${TEST_OUTPUT_DIRECTORY}
+                        DEPENDS_ON  gbenchmark ${arg_DEPENDS_ON}
+                        FOLDER      serac/benchmarks)
+
+    # Each benchmark runs a single iteration here, full runs are done by calling the executable directly
+    blt_add_benchmark(  NAME          ${arg_NAME}
+                        COMMAND       ${arg_NAME} "--benchmark_min_time=0.0 --v=3 --benchmark_format=console"
+                        NUM_MPI_TASKS ${arg_NUM_MPI_TASKS})
+
+    add_dependencies(serac_benchmarks ${arg_NAME})
+
+endmacro(serac_add_benchmark)
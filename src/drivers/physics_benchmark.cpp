@@ -0,0 +1,400 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file physics_benchmark.cpp
+ *
+ * @brief End-to-end benchmarks of the physics modules on generated meshes
+ *
+ * Builds a loaded bar of a given size and polynomial order, runs a fixed number of timesteps of one of the physics
+ * modules on it, and reports the wall time of each phase. The problem is either fixed (strong scaling) or grows with
+ * the number of ranks (weak scaling), so that runs at different scales can be compared.
+ */
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "CLI11/CLI11.hpp"
+#include "mfem.hpp"
+
+#include "serac/infrastructure/initialize.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/infrastructure/step_log.hpp"
+#include "serac/infrastructure/terminator.hpp"
+#include "serac/numerics/mesh_utils.hpp"
+#include "serac/physics/thermal_solid.hpp"
+#include "serac/physics/utilities/state_manager.hpp"
+
+namespace {
+
+/**
+ * @brief The parameters of a benchmark run
+ */
+struct BenchmarkOptions {
+  /**
+   * @brief The physics module to run, one of "solid", "thermal_conduction", or "thermal_solid"
+   */
+  std::string physics = "solid";
+
+  /**
+   * @brief The shape of the bar, one of "cuboid" or "cylinder"
+   */
+  std::string geometry = "cuboid";
+
+  /**
+   * @brief The polynomial order of the fields
+   */
+  int order = 1;
+
+  /**
+   * @brief The number of elements across the bar, and along it on a single rank
+   */
+  int elements = 4;
+
+  /**
+   * @brief The number of uniform refinements of the mesh before it is distributed
+   */
+  int serial_refinements = 0;
+
+  /**
+   * @brief The number of uniform refinements of the mesh after it is distributed
+   */
+  int parallel_refinements = 0;
+
+  /**
+   * @brief Whether the bar is lengthened in proportion to the number of ranks
+   */
+  bool weak_scaling = false;
+
+  /**
+   * @brief The number of timesteps
+   */
+  int steps = 5;
+
+  /**
+   * @brief The timestep
+   */
+  double dt = 0.1;
+
+  /**
+   * @brief Whether the dynamic rather than the quasi-static form of the equations is solved
+   */
+  bool dynamic = false;
+
+  /**
+   * @brief The file the per-step performance is written to, if any
+   */
+  std::optional<std::string> performance_log;
+};
+
+/**
+ * @brief Defines the command line, parses it, and exits on a request for help or an invalid argument
+ *
+ * @param[in] argc The number of arguments
+ * @param[in] argv The arguments
+ * @return The parameters of the run
+ */
+BenchmarkOptions parseCommandLine(int argc, char* argv[])
+{
+  BenchmarkOptions options;
+  std::string      scaling = "strong";
+  std::string      performance_log;
+
+  CLI::App app{"Serac physics benchmark: times a fixed number of steps of a physics module on a generated bar"};
+  app.add_option("--physics", options.physics, "The physics module to run.")
+      ->check(CLI::IsMember({"solid", "thermal_conduction", "thermal_solid"}));
+  app.add_option("--geometry", options.geometry, "The shape of the bar.")->check(CLI::IsMember({"cuboid", "cylinder"}));
+  app.add_option("-o, --order", options.order, "The polynomial order of the fields.")->check(CLI::PositiveNumber);
+  app.add_option("-n, --elements", options.elements,
+                 "The number of elements across the bar, and along it per rank. The cylinder takes this as the "
+                 "number of refinements of its cross section instead.")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--serial-refinements", options.serial_refinements,
+                 "The number of uniform refinements before the mesh is distributed.")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--parallel-refinements", options.parallel_refinements,
+                 "The number of uniform refinements after the mesh is distributed.")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--scaling", scaling,
+                 "Strong scaling solves the same problem on any number of ranks, weak scaling lengthens the bar in "
+                 "proportion to the number of ranks.")
+      ->check(CLI::IsMember({"strong", "weak"}));
+  app.add_option("--steps", options.steps, "The number of timesteps.")->check(CLI::PositiveNumber);
+  app.add_option("--dt", options.dt, "The timestep.")->check(CLI::PositiveNumber);
+  app.add_flag("--dynamic", options.dynamic, "Solves the dynamic rather than the quasi-static equations.");
+  auto performance_log_opt =
+      app.add_option("--performance-log", performance_log,
+                     "Writes the wall time of each phase of every timestep to the given file, as CSV if it ends in "
+                     ".csv and as JSON Lines otherwise.");
+
+  try {
+    app.parse(argc, argv);
+  } catch (const CLI::ParseError& e) {
+    serac::logger::flush();
+    if (e.get_name() == "CallForHelp") {
+      SLIC_INFO_ROOT(app.help());
+      serac::exitGracefully();
+    } else {
+      SLIC_ERROR_ROOT(CLI::FailureMessage::simple(&app, e));
+    }
+  }
+
+  options.weak_scaling = (scaling == "weak");
+  if (performance_log_opt->count() > 0) {
+    options.performance_log = performance_log;
+  }
+  return options;
+}
+
+/**
+ * @brief The boundary attributes of the ends of the bar
+ */
+struct BarEnds {
+  /**
+   * @brief The end at z = 0, which is held fixed
+   */
+  int fixed;
+
+  /**
+   * @brief The opposite end, which is loaded
+   */
+  int loaded;
+};
+
+/**
+ * @brief Builds the bar and distributes it over the ranks
+ *
+ * @param[in] options The parameters of the run
+ * @param[in] num_ranks The number of ranks
+ * @return The distributed mesh and the boundary attributes of its ends
+ */
+std::pair<std::unique_ptr<mfem::ParMesh>, BarEnds> buildBar(const BenchmarkOptions& options, int num_ranks)
+{
+  // Weak scaling stacks one copy of the single-rank bar per rank along its axis
+  const int length = options.weak_scaling ? num_ranks : 1;
+
+  if (options.geometry == "cylinder") {
+    // Each refinement of the cross section halves its elements, so the elements along the axis follow
+    const int lengthwise = (2 << options.elements) * length;
+    auto      mesh       = serac::buildCylinderMesh(options.elements, lengthwise, 0.5, length);
+
+    // The extruded cross section keeps its boundary attribute on the side, and the ends are numbered after it
+    return {serac::mesh::refineAndDistribute(std::move(mesh), options.serial_refinements, options.parallel_refinements),
+            {2, 3}};
+  }
+
+  // The faces of a cuboid are numbered bottom (z = 0), front, right, back, left, and top
+  auto mesh = serac::buildCuboidMesh(options.elements, options.elements, options.elements * length, 1.0, 1.0, length);
+  return {serac::mesh::refineAndDistribute(std::move(mesh), options.serial_refinements, options.parallel_refinements),
+          {1, 6}};
+}
+
+/**
+ * @brief Returns the solver options of the solid mechanics module
+ *
+ * @param[in] dynamic Whether the dynamic equations are solved
+ */
+serac::Solid::SolverOptions solidOptions(bool dynamic)
+{
+  const serac::IterativeSolverOptions linear_options = {.rel_tol     = 1.0e-6,
+                                                        .abs_tol     = 1.0e-10,
+                                                        .print_level = 0,
+                                                        .max_iter    = 500,
+                                                        .lin_solver  = serac::LinearSolver::GMRES,
+                                                        .prec        = serac::HypreBoomerAMGPrec{}};
+
+  const serac::NonlinearSolverOptions nonlinear_options = {
+      .rel_tol = 1.0e-4, .abs_tol = 1.0e-8, .max_iter = 10, .print_level = 1};
+
+  if (dynamic) {
+    return {linear_options, nonlinear_options,
+            serac::Solid::TimesteppingOptions{serac::TimestepMethod::AverageAcceleration,
+                                              serac::DirichletEnforcementMethod::RateControl}};
+  }
+  return {linear_options, nonlinear_options};
+}
+
+/**
+ * @brief Returns the solver options of the thermal conduction module
+ *
+ * @param[in] dynamic Whether the dynamic equations are solved
+ */
+serac::ThermalConduction::SolverOptions thermalOptions(bool dynamic)
+{
+  auto options = dynamic ? serac::ThermalConduction::defaultDynamicOptions()
+                         : serac::ThermalConduction::defaultQuasistaticOptions();
+
+  // The conductivity is constant, so the diffusion element matrices are kept within a step
+  options.cache_element_matrices = true;
+  return options;
+}
+
+/**
+ * @brief Sets up the loads, boundary conditions, and material of the bar
+ *
+ * The fixed end is clamped and held at zero temperature, the loaded end is pulled sideways, and the bar is heated
+ * throughout.
+ *
+ * @tparam PhysicsType The type of the physics module
+ * @param[in] physics The physics module
+ * @param[in] ends The boundary attributes of the ends of the bar
+ */
+template <typename PhysicsType>
+void setUpBar(PhysicsType& physics, const BarEnds& ends)
+{
+  constexpr int dim = 3;
+
+  if constexpr (!std::is_same_v<PhysicsType, serac::ThermalConduction>) {
+    mfem::Vector zero(dim);
+    zero = 0.0;
+    physics.setDisplacementBCs({ends.fixed}, std::make_shared<mfem::VectorConstantCoefficient>(zero));
+
+    mfem::Vector traction(dim);
+    traction    = 0.0;
+    traction(0) = 1.0e-3;
+    physics.setTractionBCs({ends.loaded}, std::make_shared<mfem::VectorConstantCoefficient>(traction), false);
+
+    auto mu = std::make_unique<mfem::ConstantCoefficient>(0.25);
+    auto K  = std::make_unique<mfem::ConstantCoefficient>(5.0);
+    if constexpr (std::is_same_v<PhysicsType, serac::Solid>) {
+      physics.setMaterialParameters(std::move(mu), std::move(K));
+    } else {
+      physics.setSolidMaterialParameters(std::move(mu), std::move(K));
+    }
+  }
+
+  if constexpr (!std::is_same_v<PhysicsType, serac::Solid>) {
+    physics.setTemperatureBCs({ends.fixed}, std::make_shared<mfem::ConstantCoefficient>(0.0));
+    physics.setConductivity(std::make_unique<mfem::ConstantCoefficient>(0.5));
+    physics.setSource(std::make_unique<mfem::ConstantCoefficient>(1.0));
+
+    mfem::ConstantCoefficient initial_temperature(0.0);
+    physics.setTemperature(initial_temperature);
+  }
+}
+
+/**
+ * @brief Builds and sets up the physics module on the mesh registered with the StateManager
+ *
+ * @param[in] options The parameters of the run
+ * @param[in] ends The boundary attributes of the ends of the bar
+ */
+std::unique_ptr<serac::BasePhysics> buildPhysics(const BenchmarkOptions& options, const BarEnds& ends)
+{
+  if (options.physics == "thermal_conduction") {
+    auto physics = std::make_unique<serac::ThermalConduction>(options.order, thermalOptions(options.dynamic));
+    setUpBar(*physics, ends);
+    return physics;
+  }
+
+  if (options.physics == "thermal_solid") {
+    auto physics = std::make_unique<serac::ThermalSolid>(options.order, thermalOptions(options.dynamic),
+                                                         solidOptions(options.dynamic));
+    setUpBar(*physics, ends);
+    physics->setCouplingScheme(serac::CouplingScheme::OperatorSplit);
+    return physics;
+  }
+
+  auto physics = std::make_unique<serac::Solid>(options.order, solidOptions(options.dynamic));
+  setUpBar(*physics, ends);
+  return physics;
+}
+
+}  // namespace
+
+/**
+ * @brief The physics benchmark driver
+ *
+ * @param[in] argc Number of input arguments
+ * @param[in] argv The vector of input arguments
+ *
+ * @return The return code
+ */
+int main(int argc, char* argv[])
+{
+  const int num_ranks = serac::initialize(argc, argv).first;
+
+  const auto options = parseCommandLine(argc, argv);
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "physics_benchmark");
+
+  BarEnds ends{};
+  {
+    SERAC_PROFILE_SCOPE("Benchmark mesh");
+    auto bar = buildBar(options, num_ranks);
+    ends     = bar.second;
+    serac::StateManager::setMesh(std::move(bar.first));
+  }
+
+  std::unique_ptr<serac::BasePhysics> physics;
+  {
+    SERAC_PROFILE_SCOPE("Benchmark setup");
+    physics = buildPhysics(options, ends);
+    physics->completeSetup();
+  }
+
+  long long dofs = 0;
+  for (const auto& state : physics->getState()) {
+    dofs += state.get().space().GlobalTrueVSize();
+  }
+  const long long elements = serac::StateManager::mesh().GetGlobalNE();
+
+  SLIC_INFO_ROOT(fmt::format("Benchmarking {0} on a {1} of {2} elements of order {3} ({4} state DOFs) on {5} ranks",
+                             options.physics, options.geometry, elements, options.order, dofs, num_ranks));
+
+  std::optional<serac::profiling::StepLog> step_log;
+  if (options.performance_log) {
+    step_log.emplace(*options.performance_log);
+  }
+
+  serac::profiling::TimerRecord& timesteps = serac::profiling::timer("Benchmark timesteps");
+  double                         t         = 0.0;
+  for (int step = 1; step <= options.steps; step++) {
+    if (step_log) {
+      step_log->beginStep();
+    }
+
+    double dt = options.dt;
+    {
+      serac::profiling::ScopedTimer timing(timesteps);
+      physics->advanceTimestep(dt);
+    }
+    t += dt;
+
+    if (!physics->converged()) {
+      SLIC_WARNING_ROOT("Nonlinear solve did not converge on step " << step);
+    }
+
+    if (step_log) {
+      step_log->endStep({.cycle                   = step,
+                         .time                    = t,
+                         .dt                      = dt,
+                         .converged               = physics->converged(),
+                         .nonlinear_residual_norm = physics->nonlinearResidualNorm(),
+                         .linear_residual_norm    = physics->linearResidualNorm()});
+    }
+  }
+
+  // The slowest rank sets the pace
+  double seconds       = static_cast<double>(timesteps.nanoseconds) / 1.0e9;
+  double slowest_ranks = 0.0;
+  MPI_Allreduce(&seconds, &slowest_ranks, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  const double seconds_per_step = slowest_ranks / options.steps;
+  SLIC_INFO_ROOT(fmt::format("{0} steps in {1:.3f} s: {2:.4f} s per step, {3:.3e} DOFs per second per rank",
+                             options.steps, slowest_ranks, seconds_per_step,
+                             static_cast<double>(dofs) / seconds_per_step / num_ranks));
+
+  physics->reportMemoryUsage("Memory usage at exit");
+
+  // Reports the time of every phase, summarized over the ranks
+  serac::exitGracefully();
+}
@@ -25,6 +25,9 @@
 #include "serac/infrastructure/input.hpp"
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/output.hpp"
+#include "serac/infrastructure/output_scheduler.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/infrastructure/step_log.hpp"
 #include "serac/infrastructure/terminator.hpp"
 #include "serac/numerics/mesh_utils.hpp"
 #include "serac/physics/thermal_solid.hpp"
@@ -48,6 +51,14 @@ void defineInputFileSchema(axom::inlet::Inlet& inlet)
   // The output type (visit, glvis, paraview, etc)
   serac::input::defineOutputTypeInputFileSchema(inlet.getGlobalContainer());
 
+  // How often each kind of output is written
+  auto& schedule_table = inlet.addStruct("output_schedule", "When visualization, restart, and field output is written");
+  serac::output::ScheduleInputOptions::defineInputFileSchema(schedule_table);
+
+  // The layout of the restart files
+  auto& restart_table = inlet.addStruct("restart_format", "Layout of the restart files");
+  serac::StateManager::RestartOptions::defineInputFileSchema(restart_table);
+
   // The mesh options
   auto& mesh_table = inlet.addStruct("main_mesh", "The main mesh for the problem");
   serac::mesh::InputOptions::defineInputFileSchema(mesh_table);
@@ -85,6 +96,13 @@ int main(int argc, char* argv[])
       serac::cli::defineAndParse(argc, argv, "Serac: a high order nonlinear thermomechanical simulation code");
   serac::cli::printGiven(cli_opts);
 
+  // Switch to the asynchronous logger before any of the verbose output
+  if (auto interval = cli_opts.find("async_log"); interval != cli_opts.end()) {
+    serac::logger::AsyncOptions async_options;
+    async_options.interval = std::chrono::milliseconds(std::stoi(interval->second));
+    serac::logger::enableAsync(async_options);
+  }
+
   // Read input file
   std::string input_file_path = "";
   auto        search          = cli_opts.find("input_file");
@@ -123,6 +141,10 @@ int main(int argc, char* argv[])
   // Save input values to file
   datastore.getRoot()->getGroup("input_file")->save("serac_input.json", "json");
 
+  if (inlet.getGlobalContainer().getChildContainers().at("restart_format")->isUserProvided()) {
+    serac::StateManager::setRestartOptions(inlet["restart_format"].get<serac::StateManager::RestartOptions>());
+  }
+
   // Not restarting, so we need to create the mesh and register it with the StateManager
   if (!restart_cycle) {
     // Build the mesh
@@ -164,20 +186,48 @@ int main(int argc, char* argv[])
 
   // Complete the solver setup
   main_physics->completeSetup();
+  main_physics->reportMemoryUsage("Memory usage after setup");
 
-  // Initialize/set the time information
-  double t       = 0;
+  // Initialize/set the time information, a restart continues from the loaded time
+  double t       = main_physics->time();
   double t_final = inlet["t_final"];
   double dt      = inlet["dt"];
 
-  bool last_step = false;
+  // A restart may already be at the final time
+  bool last_step = (t >= t_final - 1e-8 * dt);
 
   // FIXME: This and the FromInlet specialization are hacked together,
   // should be inlet["output_type"].get<OutputType>()
-  main_physics->initializeOutput(inlet.getGlobalContainer().get<serac::OutputType>(), "serac");
+  const auto output_type = inlet.getGlobalContainer().get<serac::OutputType>();
+  main_physics->initializeOutput(output_type, "serac");
+  main_physics->setAsyncOutput(inlet["async_output"].get<bool>());
+  main_physics->setAggregatedOutput(inlet["output_writers"].get<int>(), inlet["compress_output"].get<bool>());
+
+  // Read the output cadences, by default visualization files are written every cycle, restart files are
+  // not written separately, and the fields are extracted on the last step if requested on the command line
+  serac::output::ScheduleInputOptions schedule_options;
+  if (inlet.getGlobalContainer().getChildContainers().at("output_schedule")->isUserProvided()) {
+    schedule_options = inlet["output_schedule"].get<serac::output::ScheduleInputOptions>();
+  }
+  using serac::output::Cadence;
+  using serac::output::OutputScheduler;
+  OutputScheduler visualization_schedule(schedule_options.visualization.value_or(Cadence::everyCycle()), t);
+  OutputScheduler restart_schedule(schedule_options.restart.value_or(Cadence::never()), t);
+  OutputScheduler fields_schedule(
+      schedule_options.fields.value_or(output_fields ? Cadence::lastStepOnly() : Cadence::never()), t);
+
+  // Write the performance of each timestep if the user asked for it
+  std::optional<serac::profiling::StepLog> step_log;
+  if (auto log_file = cli_opts.find("performance_log"); log_file != cli_opts.end()) {
+    step_log.emplace(log_file->second);
+  }
 
   // Enter the time step loop.
-  for (int ti = 1; !last_step; ti++) {
+  for (int ti = main_physics->cycle() + 1; !last_step; ti++) {
+    if (step_log) {
+      step_log->beginStep();
+    }
+
     // Compute the real timestep. This may be less than dt for the last timestep.
     double dt_real = std::min(dt, t_final - t);
 
@@ -190,16 +240,56 @@ int main(int argc, char* argv[])
     // Solve the physics module appropriately
     main_physics->advanceTimestep(dt_real);
 
-    // Output a visualization file
-    main_physics->outputState();
-
     // Determine if this is the last timestep
     last_step = (t >= t_final - 1e-8 * dt);
-  }
 
-  if (output_fields) {
-    serac::output::outputFields(datastore, serac::StateManager::collectionName(), t, serac::output::Language::JSON);
+    std::vector<serac::output::OutputEvent> events;
+    if (last_step) {
+      events.push_back(serac::output::OutputEvent::LastStep);
+    }
+    if (!main_physics->converged()) {
+      SLIC_WARNING_ROOT("Nonlinear solve did not converge on step " << ti);
+      events.push_back(serac::output::OutputEvent::SolveFailure);
+    }
+
+    {
+      SERAC_PROFILE_SCOPE("Output");
+
+      // Output a visualization file
+      const bool visualization_written = visualization_schedule.check(ti, t, events);
+      if (visualization_written) {
+        main_physics->outputState();
+      }
+
+      // Sidre visualization output already saves the restart data
+      if (restart_schedule.check(ti, t, events) &&
+          !(visualization_written && output_type == serac::OutputType::SidreVisIt)) {
+        serac::StateManager::save(main_physics->time(), main_physics->cycle());
+      }
+
+      if (fields_schedule.check(ti, t, events)) {
+        // Only distinguish the files by cycle when the user asked for more than one of them
+        std::optional<int> fields_cycle;
+        if (schedule_options.fields) {
+          fields_cycle = ti;
+        }
+        serac::output::outputFields(datastore, serac::StateManager::collectionName(), t,
+                                    serac::output::Language::JSON, fields_cycle);
+      }
+    }
+
+    if (step_log) {
+      step_log->endStep({.cycle                   = ti,
+                         .time                    = t,
+                         .dt                      = dt_real,
+                         .converged               = main_physics->converged(),
+                         .nonlinear_residual_norm = main_physics->nonlinearResidualNorm(),
+                         .linear_residual_norm    = main_physics->linearResidualNorm()});
+    }
   }
 
+  // Solver hierarchies such as AMG are built on the first solve, so they only appear here
+  main_physics->reportMemoryUsage("Memory usage at exit");
+
   serac::exitGracefully();
 }
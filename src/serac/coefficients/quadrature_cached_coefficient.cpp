@@ -0,0 +1,66 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/coefficients/quadrature_cached_coefficient.hpp"
+
+#include <algorithm>
+
+namespace serac::mfem_ext {
+
+QuadratureCachedCoefficient::QuadratureCachedCoefficient(std::unique_ptr<mfem::Coefficient>&& coef, mfem::Mesh& mesh,
+                                                         const int order)
+    : coef_(std::move(coef)),
+      constant_(dynamic_cast<const mfem::ConstantCoefficient*>(coef_.get())),
+      space_(&mesh, order),
+      values_(&space_),
+      element_valid_(static_cast<std::size_t>(mesh.GetNE()), false)
+{
+}
+
+double QuadratureCachedCoefficient::Eval(mfem::ElementTransformation& Tr, const mfem::IntegrationPoint& ip)
+{
+  if (constant_) {
+    return constant_->constant;
+  }
+
+  const int element = Tr.ElementNo;
+  if (Tr.ElementType != mfem::ElementTransformation::ELEMENT || element < 0 ||
+      element >= static_cast<int>(element_valid_.size())) {
+    return coef_->Eval(Tr, ip);
+  }
+
+  // Only points of the cached rule have a slot in the quadrature function
+  const auto& ir = space_.GetElementIntRule(element);
+  if (ip.index < 0 || ip.index >= ir.GetNPoints() || &ir.IntPoint(ip.index) != &ip) {
+    return coef_->Eval(Tr, ip);
+  }
+
+  values_.GetElementValues(element, element_values_);
+  if (!element_valid_[static_cast<std::size_t>(element)]) {
+    // Fill the whole element while its transformation is at hand
+    for (int i = 0; i < ir.GetNPoints(); i++) {
+      const mfem::IntegrationPoint& point = ir.IntPoint(i);
+      Tr.SetIntPoint(&point);
+      element_values_(i) = coef_->Eval(Tr, point);
+    }
+    Tr.SetIntPoint(&ip);
+    element_valid_[static_cast<std::size_t>(element)] = true;
+  }
+  return element_values_(ip.index);
+}
+
+void QuadratureCachedCoefficient::setTime(const double t)
+{
+  if (t != GetTime()) {
+    invalidate();
+  }
+  SetTime(t);
+  coef_->SetTime(t);
+}
+
+void QuadratureCachedCoefficient::invalidate() { std::fill(element_valid_.begin(), element_valid_.end(), false); }
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,109 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file quadrature_cached_coefficient.hpp
+ *
+ * @brief A coefficient that stores its values at quadrature points between evaluations
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief Caches the values of a coefficient at the quadrature points of a mesh
+ *
+ * Integrators evaluate their coefficients at every quadrature point each time a residual or
+ * Jacobian is assembled, even when the values have not changed. This wraps a coefficient and
+ * stores its values in an mfem::QuadratureFunction the first time each element is visited, so
+ * later evaluations are a lookup. The cached values are reused until invalidate() is called or the
+ * time changes through setTime().
+ *
+ * Only evaluations at the points of the integration rule of the given order are cached. Evaluations
+ * anywhere else, e.g. on boundary elements or with a different rule, are passed through to the
+ * wrapped coefficient.
+ */
+class QuadratureCachedCoefficient : public mfem::Coefficient {
+public:
+  /**
+   * @brief Construct a new Quadrature Cached Coefficient object
+   *
+   * @param[in] coef The coefficient to cache
+   * @param[in] mesh The mesh on which the coefficient is evaluated
+   * @param[in] order The order of the integration rule used by the integrator that evaluates the coefficient
+   */
+  QuadratureCachedCoefficient(std::unique_ptr<mfem::Coefficient>&& coef, mfem::Mesh& mesh, const int order);
+
+  /**
+   * @brief Evaluate the coefficient at a quadrature point
+   *
+   * @param[in] Tr The element transformation for the evaluation
+   * @param[in] ip The integration point for the evaluation
+   * @return The value of the coefficient at the quadrature point
+   */
+  double Eval(mfem::ElementTransformation& Tr, const mfem::IntegrationPoint& ip) override;
+
+  /**
+   * @brief Set the time of the wrapped coefficient, discarding the cached values if it changed
+   *
+   * @param[in] t The new time
+   */
+  void setTime(const double t);
+
+  /**
+   * @brief Discard the cached values, e.g. after the mesh or a state the coefficient depends on has changed
+   */
+  void invalidate();
+
+  /**
+   * @brief Returns the wrapped coefficient
+   */
+  mfem::Coefficient& coefficient() { return *coef_; }
+
+  /**
+   * @brief Returns the size of the cached values in bytes
+   */
+  std::size_t cacheBytes() const { return static_cast<std::size_t>(values_.Capacity()) * sizeof(double); }
+
+private:
+  /**
+   * @brief The wrapped coefficient
+   */
+  std::unique_ptr<mfem::Coefficient> coef_;
+
+  /**
+   * @brief The value of the wrapped coefficient if it is constant, in which case nothing is cached
+   */
+  const mfem::ConstantCoefficient* constant_;
+
+  /**
+   * @brief The quadrature points at which the values are cached
+   */
+  mfem::QuadratureSpace space_;
+
+  /**
+   * @brief The cached values
+   */
+  mfem::QuadratureFunction values_;
+
+  /**
+   * @brief A view of the cached values of a single element
+   */
+  mfem::Vector element_values_;
+
+  /**
+   * @brief Whether the cached values of each element are current
+   */
+  std::vector<bool> element_valid_;
+};
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,323 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/async_log_stream.hpp"
+
+#include <algorithm>
+
+namespace serac::logger {
+
+AsyncLogSink::AsyncLogSink(MPI_Comm comm, const AsyncOptions& options)
+    : interval_(options.interval),
+      next_exchange_(std::chrono::steady_clock::now() + options.interval),
+      queue_(std::max<std::size_t>(options.capacity, 1))
+{
+  MPI_Comm_dup(comm, &comm_);
+  MPI_Comm_rank(comm_, &rank_);
+  MPI_Comm_size(comm_, &num_ranks_);
+  rank_string_ = std::to_string(rank_);
+  flush_markers_.resize(static_cast<std::size_t>(num_ranks_), 0);
+
+  worker_ = std::thread([this]() { run(); });
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_one();
+  worker_.join();
+
+  // Messages that were never forwarded are better written out of order than lost
+  writeLocally();
+  flushDestinations();
+
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (!finalized) {
+    for (auto& pending : in_flight_) {
+      MPI_Cancel(&pending.request);
+      MPI_Wait(&pending.request, MPI_STATUS_IGNORE);
+    }
+    MPI_Comm_free(&comm_);
+  }
+}
+
+std::size_t AsyncLogSink::attach(AsyncLogStream* stream, std::ostream* destination)
+{
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  streams_.push_back(stream);
+
+  auto found = std::find(destinations_.begin(), destinations_.end(), destination);
+  if (found != destinations_.end()) {
+    return static_cast<std::size_t>(found - destinations_.begin());
+  }
+  destinations_.push_back(destination);
+  outgoing_.emplace_back();
+  return destinations_.size() - 1;
+}
+
+void AsyncLogSink::detach(AsyncLogStream* stream)
+{
+  // The queued messages may refer to the stream, so they are formatted while it is still alive
+  drain();
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  streams_.erase(std::remove(streams_.begin(), streams_.end(), stream), streams_.end());
+}
+
+void AsyncLogSink::enqueue(Record& record)
+{
+  const bool error = record.level == axom::slic::message::Error;
+
+  // The background thread never waits while the queue is nonempty, so a full queue only needs patience
+  while (!queue_.tryPush(record)) {
+    std::this_thread::yield();
+  }
+
+  // Only wake the background thread when it may be waiting, the common case is a lock-free push
+  if (idle_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    work_available_.notify_one();
+  }
+
+  if (error) {
+    // Errors usually end the run, so they are written now by the rank that logged them
+    error_logged_ = true;
+    flush();
+  } else {
+    exchangeIfDue();
+  }
+}
+
+void AsyncLogSink::exchange()
+{
+  if (num_ranks_ == 1) {
+    return;
+  }
+
+  if (rank_ == 0) {
+    int        arrived = 0;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_, &arrived, &status);
+    while (arrived) {
+      receive(status);
+      MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_, &arrived, &status);
+    }
+    return;
+  }
+
+  completeSends(false);
+
+  std::vector<std::string> buffers;
+  {
+    // If the background thread is busy with the buffers, they are sent at the next opportunity instead
+    std::unique_lock<std::mutex> lock(output_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      return;
+    }
+    buffers.resize(outgoing_.size());
+    outgoing_.swap(buffers);
+  }
+  send(std::move(buffers));
+}
+
+void AsyncLogSink::flush()
+{
+  drain();
+
+  if (error_logged_) {
+    writeLocally();
+    flushDestinations();
+    return;
+  }
+
+  if (rank_ == 0) {
+    // Every other rank ends its contribution with a marker, which follows its messages
+    auto missing_marker = [this]() {
+      return std::any_of(flush_markers_.begin() + 1, flush_markers_.end(), [](int markers) { return markers == 0; });
+    };
+    while (missing_marker()) {
+      MPI_Status status;
+      MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_, &status);
+      receive(status);
+    }
+    // A fast rank may already have sent the marker of the next flush, so markers are counted rather than flagged
+    std::for_each(flush_markers_.begin() + 1, flush_markers_.end(), [](int& markers) { markers--; });
+  } else {
+    std::vector<std::string> buffers;
+    {
+      std::lock_guard<std::mutex> lock(output_mutex_);
+      buffers.resize(outgoing_.size());
+      outgoing_.swap(buffers);
+    }
+    send(std::move(buffers));
+
+    PendingSend marker{std::make_unique<std::string>(), MPI_REQUEST_NULL};
+    MPI_Isend(marker.buffer->data(), 0, MPI_CHAR, 0, FLUSH_TAG, comm_, &marker.request);
+    in_flight_.push_back(std::move(marker));
+    completeSends(true);
+  }
+
+  flushDestinations();
+  next_exchange_ = std::chrono::steady_clock::now() + interval_;
+}
+
+void AsyncLogSink::run()
+{
+  Record record;
+  while (true) {
+    while (queue_.tryPop(record)) {
+      const auto text        = record.source->format(record, rank_string_);
+      const auto destination = record.source->destination();
+      {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        if (rank_ == 0) {
+          *destinations_[destination] << text;
+        } else {
+          outgoing_[destination] += text;
+        }
+      }
+      formatted_++;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.notify_all();
+    if (stop_) {
+      return;
+    }
+    idle_ = true;
+    work_available_.wait(lock, [this]() { return stop_ || queue_.pushed() != formatted_; });
+    idle_ = false;
+  }
+}
+
+void AsyncLogSink::drain()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_available_.notify_one();
+  work_done_.wait(lock, [this]() { return queue_.pushed() == formatted_; });
+}
+
+void AsyncLogSink::exchangeIfDue()
+{
+  if (num_ranks_ == 1) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  if (now < next_exchange_) {
+    return;
+  }
+  next_exchange_ = now + interval_;
+  exchange();
+}
+
+void AsyncLogSink::send(std::vector<std::string>&& buffers)
+{
+  for (std::size_t i = 0; i < buffers.size(); i++) {
+    if (buffers[i].empty()) {
+      continue;
+    }
+    PendingSend pending{std::make_unique<std::string>(std::move(buffers[i])), MPI_REQUEST_NULL};
+    MPI_Isend(pending.buffer->data(), static_cast<int>(pending.buffer->size()), MPI_CHAR, 0, static_cast<int>(i),
+              comm_, &pending.request);
+    in_flight_.push_back(std::move(pending));
+  }
+}
+
+void AsyncLogSink::completeSends(bool wait)
+{
+  for (auto& pending : in_flight_) {
+    int done = 1;
+    if (wait) {
+      MPI_Wait(&pending.request, MPI_STATUS_IGNORE);
+    } else {
+      MPI_Test(&pending.request, &done, MPI_STATUS_IGNORE);
+    }
+    if (done) {
+      pending.buffer.reset();
+    }
+  }
+  in_flight_.erase(std::remove_if(in_flight_.begin(), in_flight_.end(),
+                                  [](const PendingSend& pending) { return !pending.buffer; }),
+                   in_flight_.end());
+}
+
+void AsyncLogSink::receive(const MPI_Status& status)
+{
+  int size = 0;
+  MPI_Get_count(&status, MPI_CHAR, &size);
+  std::string text(static_cast<std::size_t>(size), '\0');
+  MPI_Recv(text.data(), size, MPI_CHAR, status.MPI_SOURCE, status.MPI_TAG, comm_, MPI_STATUS_IGNORE);
+
+  if (status.MPI_TAG == FLUSH_TAG) {
+    flush_markers_[static_cast<std::size_t>(status.MPI_SOURCE)]++;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  *destinations_[static_cast<std::size_t>(status.MPI_TAG)] << text;
+}
+
+void AsyncLogSink::writeLocally()
+{
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  for (std::size_t i = 0; i < outgoing_.size(); i++) {
+    if (!outgoing_[i].empty()) {
+      *destinations_[i] << outgoing_[i];
+      outgoing_[i].clear();
+    }
+  }
+}
+
+void AsyncLogSink::flushDestinations()
+{
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  for (auto destination : destinations_) {
+    destination->flush();
+  }
+}
+
+AsyncLogStream::AsyncLogStream(std::shared_ptr<AsyncLogSink> sink, std::ostream* destination,
+                               const std::string& format)
+    : sink_(std::move(sink))
+{
+  setFormatString(format);
+  destination_ = sink_->attach(this, destination);
+}
+
+AsyncLogStream::~AsyncLogStream() { sink_->detach(this); }
+
+void AsyncLogStream::append(axom::slic::message::Level level, const std::string& message,
+                            const std::string& tag_name, const std::string& file_name, int line, bool)
+{
+  AsyncLogSink::Record record{this, level, message, tag_name, file_name, line};
+  sink_->enqueue(record);
+}
+
+void AsyncLogStream::push()
+{
+  // The streams share a sink, so only one of them needs to act for all of them
+  if (sink_->leader() == this) {
+    sink_->exchange();
+  }
+}
+
+void AsyncLogStream::flush()
+{
+  if (sink_->leader() == this) {
+    sink_->flush();
+  }
+}
+
+std::string AsyncLogStream::format(const AsyncLogSink::Record& record, const std::string& rank)
+{
+  return getFormatedMessage(axom::slic::message::getLevelAsString(record.level), record.message, record.tag, rank,
+                            record.file, record.line);
+}
+
+}  // namespace serac::logger
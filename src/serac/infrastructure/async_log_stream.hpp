@@ -0,0 +1,501 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file async_log_stream.hpp
+ *
+ * @brief SLIC log streams that format and write messages on a background thread
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "axom/slic.hpp"
+#include "mpi.h"
+
+namespace serac::logger {
+
+/**
+ * @brief Options for the asynchronous log streams
+ */
+struct AsyncOptions {
+  /**
+   * @brief The number of messages that can be queued before a logging call waits for the background thread
+   */
+  std::size_t capacity = 4096;
+
+  /**
+   * @brief The minimum time between forwarding the messages of the other ranks to rank 0
+   */
+  std::chrono::milliseconds interval{500};
+};
+
+namespace detail {
+
+/**
+ * @brief A fixed-capacity, lock-free queue with a single producer and a single consumer
+ *
+ * @tparam T The type of the elements, which are moved in and out of preallocated slots
+ */
+template <typename T>
+class RingBuffer {
+public:
+  /**
+   * @brief Allocates the slots
+   * @param[in] capacity The minimum number of elements the buffer holds, rounded up to a power of two
+   */
+  explicit RingBuffer(const std::size_t capacity)
+  {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    slots_.resize(size);
+    mask_ = size - 1;
+  }
+
+  /**
+   * @brief Appends an element, called only by the producer
+   * @param[inout] value The element, which is moved from on success
+   * @return Whether there was room for the element
+   */
+  bool tryPush(T& value)
+  {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+      return false;
+    }
+    slots_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element, called only by the consumer
+   * @param[out] value The removed element
+   * @return Whether there was an element to remove
+   */
+  bool tryPop(T& value)
+  {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_seq_cst)) {
+      return false;
+    }
+    value = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Returns the total number of elements that have ever been pushed
+   */
+  std::size_t pushed() const { return tail_.load(std::memory_order_seq_cst); }
+
+  /**
+   * @brief Returns the number of elements the buffer holds
+   */
+  std::size_t capacity() const { return slots_.size(); }
+
+private:
+  /**
+   * @brief The storage for the elements
+   */
+  std::vector<T> slots_;
+
+  /**
+   * @brief Maps the monotonically increasing positions to slots
+   */
+  std::size_t mask_;
+
+  /**
+   * @brief The position of the oldest element, written only by the consumer
+   */
+  alignas(64) std::atomic<std::size_t> head_{0};
+
+  /**
+   * @brief The position one past the newest element, written only by the producer
+   */
+  alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+}  // namespace detail
+
+class AsyncLogStream;
+
+/**
+ * @brief The state shared by a set of AsyncLogStreams: the message queue, the background thread,
+ * and the buffers that forward messages to rank 0
+ *
+ * Messages are queued without formatting by the thread that logs them (SLIC is not thread-safe,
+ * so that is always the same thread). The background thread formats them and either writes them
+ * (on rank 0) or appends them to a per-destination buffer (on the other ranks). The buffers are
+ * sent to rank 0 with nonblocking point-to-point messages at most once per AsyncOptions::interval,
+ * piggybacked on logging calls, so no rank ever waits on another except in flush().
+ *
+ * Only the logging thread makes MPI calls.
+ */
+class AsyncLogSink {
+public:
+  /**
+   * @brief A message that has not yet been formatted
+   */
+  struct Record {
+    /**
+     * @brief The stream the message was logged to, which determines the format and destination
+     */
+    AsyncLogStream* source = nullptr;
+
+    /**
+     * @brief The severity of the message
+     */
+    axom::slic::message::Level level = axom::slic::message::Info;
+
+    /**
+     * @brief The user-supplied message
+     */
+    std::string message;
+
+    /**
+     * @brief The tag of the message
+     */
+    std::string tag;
+
+    /**
+     * @brief The file that logged the message
+     */
+    std::string file;
+
+    /**
+     * @brief The line that logged the message
+     */
+    int line = 0;
+  };
+
+  /**
+   * @brief Starts the background thread
+   * @param[in] comm The communicator whose messages are aggregated on its rank 0
+   * @param[in] options The queue capacity and the forwarding interval
+   */
+  AsyncLogSink(MPI_Comm comm, const AsyncOptions& options = {});
+
+  /**
+   * @brief Deleted copy constructor
+   */
+  AsyncLogSink(const AsyncLogSink&) = delete;
+
+  /**
+   * @brief Deleted copy assignment
+   */
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+  /**
+   * @brief Formats the queued messages and joins the background thread
+   *
+   * Messages that were never forwarded to rank 0 are written by the rank that logged them.
+   */
+  ~AsyncLogSink();
+
+  /**
+   * @brief Registers a stream and returns the index of its destination
+   *
+   * Streams must be registered in the same order on every rank. Streams that share an output
+   * stream share a destination, so their messages stay in order.
+   *
+   * @param[in] stream The stream to register
+   * @param[in] destination The output stream, which only needs to be writable on rank 0
+   */
+  std::size_t attach(AsyncLogStream* stream, std::ostream* destination);
+
+  /**
+   * @brief Formats the queued messages and unregisters a stream that is being destroyed
+   * @param[in] stream The stream to unregister
+   */
+  void detach(AsyncLogStream* stream);
+
+  /**
+   * @brief Queues a message, blocking only while the queue is full
+   * @param[in] record The message, which is moved from
+   */
+  void enqueue(Record& record);
+
+  /**
+   * @brief Forwards the messages formatted so far to rank 0 without waiting for them to be received
+   */
+  void exchange();
+
+  /**
+   * @brief Writes every message logged so far on every rank
+   *
+   * This is a collective operation. Once an error has been logged it only writes the messages of
+   * this rank, as the other ranks may never reach the matching call.
+   */
+  void flush();
+
+  /**
+   * @brief Returns the stream that performs the flush on behalf of all of the streams
+   */
+  const AsyncLogStream* leader() const { return streams_.empty() ? nullptr : streams_.front(); }
+
+  /**
+   * @brief The tag of the message that ends the contributions of a rank to a flush
+   */
+  static constexpr int FLUSH_TAG = 32767;
+
+private:
+  /**
+   * @brief The loop executed by the background thread
+   */
+  void run();
+
+  /**
+   * @brief Blocks until the background thread has formatted every queued message
+   */
+  void drain();
+
+  /**
+   * @brief Calls exchange() if the forwarding interval has elapsed
+   */
+  void exchangeIfDue();
+
+  /**
+   * @brief Sends the buffered messages of this rank to rank 0
+   * @param[in] buffers The formatted messages of each destination
+   */
+  void send(std::vector<std::string>&& buffers);
+
+  /**
+   * @brief Releases the send buffers whose messages have been received
+   * @param[in] wait Whether to block until every send has completed
+   */
+  void completeSends(bool wait);
+
+  /**
+   * @brief Writes a message that was received from another rank
+   * @param[in] status The status returned by the probe that found the message
+   */
+  void receive(const MPI_Status& status);
+
+  /**
+   * @brief Writes the messages of this rank to this rank's destinations instead of forwarding them
+   */
+  void writeLocally();
+
+  /**
+   * @brief Flushes every destination
+   */
+  void flushDestinations();
+
+  /**
+   * @brief A duplicate of the communicator, so the forwarded messages cannot match any other receive
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The rank of this process in comm_
+   */
+  int rank_ = 0;
+
+  /**
+   * @brief The number of ranks in comm_
+   */
+  int num_ranks_ = 1;
+
+  /**
+   * @brief The rank written in place of the <RANK> keyword
+   */
+  std::string rank_string_;
+
+  /**
+   * @brief The minimum time between calls to exchange() made by enqueue()
+   */
+  const std::chrono::milliseconds interval_;
+
+  /**
+   * @brief The earliest time at which enqueue() calls exchange()
+   */
+  std::chrono::steady_clock::time_point next_exchange_;
+
+  /**
+   * @brief Whether an error has been logged, after which flushes are no longer collective
+   */
+  bool error_logged_ = false;
+
+  /**
+   * @brief The registered streams
+   */
+  std::vector<AsyncLogStream*> streams_;
+
+  /**
+   * @brief The distinct output streams of the registered streams
+   */
+  std::vector<std::ostream*> destinations_;
+
+  /**
+   * @brief Guards the destinations and the outgoing buffers
+   */
+  std::mutex output_mutex_;
+
+  /**
+   * @brief The formatted messages of each destination that have not yet been sent to rank 0
+   */
+  std::vector<std::string> outgoing_;
+
+  /**
+   * @brief A nonblocking send to rank 0 and the buffer it reads from
+   */
+  struct PendingSend {
+    /**
+     * @brief The formatted messages, allocated separately so they do not move while the send is in flight
+     */
+    std::unique_ptr<std::string> buffer;
+
+    /**
+     * @brief The request of the send
+     */
+    MPI_Request request;
+  };
+
+  /**
+   * @brief The sends that have not yet completed
+   */
+  std::vector<PendingSend> in_flight_;
+
+  /**
+   * @brief On rank 0, the number of flush markers received from each rank that have not yet been consumed
+   */
+  std::vector<int> flush_markers_;
+
+  /**
+   * @brief The messages that have not yet been formatted
+   */
+  detail::RingBuffer<Record> queue_;
+
+  /**
+   * @brief The number of messages the background thread has finished with
+   */
+  std::atomic<std::size_t> formatted_{0};
+
+  /**
+   * @brief Whether the background thread is (about to be) waiting for messages
+   */
+  std::atomic<bool> idle_{false};
+
+  /**
+   * @brief Whether the background thread should exit once the queue is empty
+   */
+  std::atomic<bool> stop_{false};
+
+  /**
+   * @brief Guards the waits on the condition variables
+   */
+  std::mutex mutex_;
+
+  /**
+   * @brief Signalled when a message is queued to an idle thread or the sink is shutting down
+   */
+  std::condition_variable work_available_;
+
+  /**
+   * @brief Signalled when the background thread runs out of messages
+   */
+  std::condition_variable work_done_;
+
+  /**
+   * @brief The background thread, declared last so that it starts after the rest of the state is initialized
+   */
+  std::thread worker_;
+};
+
+/**
+ * @brief A SLIC log stream that hands its messages to an AsyncLogSink
+ *
+ * Logging a message costs a few string copies on the calling thread; formatting, writing,
+ * and the aggregation on rank 0 happen elsewhere. Messages from rank 0 reach their destination
+ * as soon as the background thread gets to them, messages from the other ranks within about
+ * AsyncOptions::interval of the next logging call, and every message is written by
+ * axom::slic::flushStreams.
+ */
+class AsyncLogStream : public axom::slic::LogStream {
+public:
+  /**
+   * @brief Constructs a stream and attaches it to a sink
+   * @param[in] sink The sink shared by all of the asynchronous streams
+   * @param[in] destination The output stream, used on rank 0 and for errors
+   * @param[in] format The SLIC format string of the messages
+   */
+  AsyncLogStream(std::shared_ptr<AsyncLogSink> sink, std::ostream* destination, const std::string& format);
+
+  /**
+   * @brief Deleted copy constructor
+   */
+  AsyncLogStream(const AsyncLogStream&) = delete;
+
+  /**
+   * @brief Deleted copy assignment
+   */
+  AsyncLogStream& operator=(const AsyncLogStream&) = delete;
+
+  /**
+   * @brief Detaches the stream from its sink, which is destroyed with the last of its streams
+   */
+  ~AsyncLogStream();
+
+  /**
+   * @brief Queues a message for the background thread
+   * @param[in] level The severity of the message
+   * @param[in] message The user-supplied message
+   * @param[in] tag_name The tag of the message
+   * @param[in] file_name The file that logged the message
+   * @param[in] line The line that logged the message
+   */
+  void append(axom::slic::message::Level level, const std::string& message, const std::string& tag_name,
+              const std::string& file_name, int line, bool /* filter_duplicates */) override;
+
+  /**
+   * @brief Forwards the messages formatted so far to rank 0 without waiting
+   */
+  void push() override;
+
+  /**
+   * @brief Writes every message logged so far on every rank, see AsyncLogSink::flush
+   */
+  void flush() override;
+
+  /**
+   * @brief Applies the format string of this stream to a message
+   * @param[in] record The message
+   * @param[in] rank The rank written in place of the <RANK> keyword
+   */
+  std::string format(const AsyncLogSink::Record& record, const std::string& rank);
+
+  /**
+   * @brief Returns the index of the destination of this stream in its sink
+   */
+  std::size_t destination() const { return destination_; }
+
+private:
+  /**
+   * @brief The sink shared by all of the asynchronous streams
+   */
+  std::shared_ptr<AsyncLogSink> sink_;
+
+  /**
+   * @brief The index of the destination of this stream in the sink
+   */
+  std::size_t destination_ = 0;
+};
+
+}  // namespace serac::logger
@@ -0,0 +1,136 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/async_writer.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <set>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::output {
+
+namespace {
+/**
+ * @brief The writers that are currently alive, so they can be flushed on exit
+ */
+std::set<AsyncWriter*> live_writers;
+
+/**
+ * @brief Guards live_writers
+ */
+std::mutex live_writers_mutex;
+}  // namespace
+
+AsyncWriter::AsyncWriter(const std::size_t max_pending) : max_pending_(std::max<std::size_t>(max_pending, 1))
+{
+  worker_ = std::thread([this]() { run(); });
+  std::lock_guard<std::mutex> lock(live_writers_mutex);
+  live_writers.insert(this);
+}
+
+AsyncWriter::~AsyncWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(live_writers_mutex);
+    live_writers.erase(this);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_one();
+  worker_.join();
+  reportFailures();
+}
+
+void AsyncWriter::enqueue(std::function<void()>&& task)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this]() { return outstanding_ < max_pending_; });
+    tasks_.push_back(std::move(task));
+    outstanding_++;
+  }
+  work_available_.notify_one();
+  reportFailures();
+}
+
+void AsyncWriter::flush()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this]() { return outstanding_ == 0; });
+  }
+  reportFailures();
+}
+
+std::size_t AsyncWriter::pending() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return outstanding_;
+}
+
+void AsyncWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_available_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+    if (tasks_.empty()) {
+      // Only reachable once stop_ is set and all of the work has been drained
+      return;
+    }
+
+    {
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      lock.unlock();
+
+      // SLIC is not thread-safe, so errors are recorded here and logged by the owning thread
+      std::string failure;
+      try {
+        task();
+      } catch (const std::exception& e) {
+        failure = e.what();
+      } catch (...) {
+        failure = "Unknown exception in asynchronous output task";
+      }
+
+      // Release anything captured by the task before it is reported as complete
+      task = nullptr;
+      lock.lock();
+      if (!failure.empty()) {
+        failures_.push_back(std::move(failure));
+      }
+    }
+
+    outstanding_--;
+    work_done_.notify_all();
+  }
+}
+
+void AsyncWriter::reportFailures()
+{
+  std::vector<std::string> failures;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    failures.swap(failures_);
+  }
+  for (const auto& failure : failures) {
+    SLIC_WARNING("Asynchronous output failed: " << failure);
+  }
+}
+
+void flushAsyncWriters()
+{
+  std::lock_guard<std::mutex> lock(live_writers_mutex);
+  for (auto writer : live_writers) {
+    writer->flush();
+  }
+}
+
+}  // namespace serac::output
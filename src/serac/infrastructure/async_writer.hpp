@@ -0,0 +1,141 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file async_writer.hpp
+ *
+ * @brief A background thread for writing output files while the simulation continues
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace serac::output {
+
+/**
+ * @brief Executes write tasks in order on a single background thread
+ *
+ * The number of outstanding (queued or running) tasks is bounded, so callers
+ * that stage their data in a fixed number of buffers can safely reuse a buffer
+ * once enqueue() returns for the task that follows it. Tasks must not make MPI
+ * calls or touch data that the calling thread may modify.
+ *
+ * Every live writer is flushed by serac::exitGracefully on a normal exit. Output still in flight when
+ * the program exits with an error, e.g. from a signal handler, is abandoned.
+ */
+class AsyncWriter {
+public:
+  /**
+   * @brief Starts the background thread
+   * @param[in] max_pending The maximum number of tasks that may be queued or running at once
+   */
+  explicit AsyncWriter(const std::size_t max_pending = 1);
+
+  /**
+   * @brief Deleted copy constructor
+   */
+  AsyncWriter(const AsyncWriter&) = delete;
+
+  /**
+   * @brief Deleted copy assignment
+   */
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  /**
+   * @brief Writes all pending tasks and joins the background thread
+   */
+  ~AsyncWriter();
+
+  /**
+   * @brief Queues a task for the background thread
+   *
+   * Blocks while the maximum number of tasks is outstanding
+   *
+   * @param[in] task The work to perform, typically serializing a snapshot to disk
+   */
+  void enqueue(std::function<void()>&& task);
+
+  /**
+   * @brief Blocks until all queued tasks have completed
+   */
+  void flush();
+
+  /**
+   * @brief Returns the number of tasks that are queued or running
+   */
+  std::size_t pending() const;
+
+private:
+  /**
+   * @brief The loop executed by the background thread
+   */
+  void run();
+
+  /**
+   * @brief Logs (and clears) the errors raised by completed tasks
+   */
+  void reportFailures();
+
+  /**
+   * @brief The maximum number of queued or running tasks
+   */
+  const std::size_t max_pending_;
+
+  /**
+   * @brief Guards all of the state shared with the background thread
+   */
+  mutable std::mutex mutex_;
+
+  /**
+   * @brief Signalled when a task is queued or the writer is shutting down
+   */
+  std::condition_variable work_available_;
+
+  /**
+   * @brief Signalled when a task completes
+   */
+  std::condition_variable work_done_;
+
+  /**
+   * @brief The tasks that have not yet been started
+   */
+  std::deque<std::function<void()>> tasks_;
+
+  /**
+   * @brief The number of tasks that are queued or running
+   */
+  std::size_t outstanding_ = 0;
+
+  /**
+   * @brief Whether the background thread should exit once the queue is empty
+   */
+  bool stop_ = false;
+
+  /**
+   * @brief Error messages from tasks that threw
+   */
+  std::vector<std::string> failures_;
+
+  /**
+   * @brief The background thread, declared last so that it starts after the rest of the state is initialized
+   */
+  std::thread worker_;
+};
+
+/**
+ * @brief Blocks until every live AsyncWriter has finished its pending tasks
+ */
+void flushAsyncWriters();
+
+}  // namespace serac::output
@@ -29,6 +29,16 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
                "Writes Sphinx documentation for input file, then exits");
   bool output_fields{true};
   app.add_flag("--output-fields,!--no-output-fields", output_fields, "Writes field data to file system.");
+  std::string performance_log;
+  auto        performance_log_opt = app.add_option(
+      "--performance-log", performance_log,
+      "Writes the wall time of each phase, the solver iterations, and the residual norms of every timestep to the "
+      "given file, as CSV if it ends in .csv and as JSON Lines otherwise.");
+  int  async_log_interval;
+  auto async_log_opt = app.add_option("--async-log", async_log_interval,
+                                      "Formats and writes log messages on a background thread, gathering the messages "
+                                      "of all ranks on rank 0 every given number of milliseconds.")
+                           ->check(CLI::NonNegativeNumber);
 
   // Parse the arguments and check if they are good
   try {
@@ -58,6 +68,12 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
   if (output_fields) {
     cli_opts.insert({"output_fields", {}});
   }
+  if (performance_log_opt->count() > 0) {
+    cli_opts.insert({"performance_log", performance_log});
+  }
+  if (async_log_opt->count() > 0) {
+    cli_opts.insert({"async_log", std::to_string(async_log_interval)});
+  }
   return cli_opts;
 }
 
@@ -0,0 +1,198 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/glvis_output.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include "fmt/fmt.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::output {
+
+namespace {
+
+/**
+ * @brief The serialized pieces of a writer group's mesh and fields
+ */
+struct GatheredPieces {
+  /**
+   * @brief The concatenated GLVis text of every rank in the group
+   */
+  std::string data;
+
+  /**
+   * @brief The length of each piece, ordered by rank and then by file
+   */
+  std::vector<std::int64_t> sizes;
+
+  /**
+   * @brief The mesh file name followed by the file name of each field
+   */
+  std::vector<std::string> file_names;
+
+  /**
+   * @brief The number of significant figures in the output
+   */
+  int precision;
+
+  /**
+   * @brief Whether the files are gzip-compressed
+   */
+  bool compress;
+
+  /**
+   * @brief Opens an output file
+   * @param[in] file_name The name of the file
+   */
+  std::unique_ptr<std::ostream> open(const std::string& file_name) const
+  {
+    std::unique_ptr<std::ostream> file;
+    if (compress) {
+      file = std::make_unique<mfem::ofgzstream>(file_name.c_str(), "zwb6");
+    } else {
+      file = std::make_unique<std::ofstream>(file_name);
+    }
+    if (!*file) {
+      throw std::runtime_error(fmt::format("Could not open '{0}' for writing", file_name));
+    }
+    file->precision(precision);
+    return file;
+  }
+
+  /**
+   * @brief Merges the pieces and writes the mesh and field files
+   */
+  void write() const
+  {
+    const std::size_t num_files  = file_names.size();
+    const std::size_t num_pieces = sizes.size() / num_files;
+
+    std::vector<std::unique_ptr<mfem::Mesh>>                      meshes;
+    std::vector<std::vector<std::unique_ptr<mfem::GridFunction>>> fields(num_files - 1);
+
+    std::size_t offset = 0;
+    for (std::size_t piece = 0; piece < num_pieces; piece++) {
+      for (std::size_t file = 0; file < num_files; file++) {
+        const auto         size = static_cast<std::size_t>(sizes[piece * num_files + file]);
+        std::istringstream input(data.substr(offset, size));
+        offset += size;
+        if (file == 0) {
+          meshes.push_back(std::make_unique<mfem::Mesh>(input, 1, 0));
+        } else {
+          fields[file - 1].push_back(std::make_unique<mfem::GridFunction>(meshes.back().get(), input));
+        }
+      }
+    }
+
+    std::vector<mfem::Mesh*> mesh_pieces(num_pieces);
+    std::transform(meshes.begin(), meshes.end(), mesh_pieces.begin(), [](auto& mesh) { return mesh.get(); });
+    mfem::Mesh merged_mesh(mesh_pieces.data(), static_cast<int>(num_pieces));
+    merged_mesh.Print(*open(file_names[0]));
+
+    for (std::size_t file = 1; file < num_files; file++) {
+      std::vector<mfem::GridFunction*> field_pieces(num_pieces);
+      std::transform(fields[file - 1].begin(), fields[file - 1].end(), field_pieces.begin(),
+                     [](auto& field) { return field.get(); });
+      mfem::GridFunction merged_field(&merged_mesh, field_pieces.data(), static_cast<int>(num_pieces));
+      merged_field.Save(*open(file_names[file]));
+    }
+  }
+};
+
+}  // namespace
+
+GLVisAggregator::GLVisAggregator(MPI_Comm comm, const int num_writers, const bool compress) : compress_(compress)
+{
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  num_writers_ = std::clamp(num_writers, 1, size);
+
+  // Contiguous blocks of ranks, with group sizes that differ by at most one
+  group_ = static_cast<int>((static_cast<std::int64_t>(rank) * num_writers_) / size);
+  MPI_Comm_split(comm, group_, rank, &group_comm_);
+  MPI_Comm_rank(group_comm_, &group_rank_);
+  MPI_Comm_size(group_comm_, &group_size_);
+}
+
+GLVisAggregator::~GLVisAggregator() { MPI_Comm_free(&group_comm_); }
+
+std::function<void()> GLVisAggregator::gather(const std::string& root_name, const int cycle, const mfem::ParMesh& mesh,
+                                              const std::vector<Field>& fields, const int precision) const
+{
+  // Serialize this rank's piece exactly as the per-rank GLVis output would
+  std::ostringstream        local;
+  std::vector<std::int64_t> local_sizes;
+  local.precision(precision);
+
+  auto record = [&local, &local_sizes]() {
+    const auto end = static_cast<std::int64_t>(local.tellp());
+    local_sizes.push_back(end - std::accumulate(local_sizes.begin(), local_sizes.end(), std::int64_t{0}));
+  };
+
+  mesh.Print(local);
+  record();
+  for (const auto& [_, field] : fields) {
+    field->Save(local);
+    record();
+  }
+
+  const std::string local_data  = local.str();
+  const auto        local_count = static_cast<std::int64_t>(local_data.size());
+  SLIC_ERROR_IF(local_count > std::numeric_limits<int>::max(), "GLVis output piece is too large to aggregate");
+
+  const int                 num_files = static_cast<int>(local_sizes.size());
+  std::vector<std::int64_t> sizes(isWriter() ? static_cast<std::size_t>(num_files * group_size_) : 0);
+  MPI_Gather(local_sizes.data(), num_files, MPI_INT64_T, sizes.data(), num_files, MPI_INT64_T, 0, group_comm_);
+
+  std::vector<int> counts;
+  std::vector<int> displacements;
+  std::string      data;
+  if (isWriter()) {
+    std::int64_t total = 0;
+    for (int piece = 0; piece < group_size_; piece++) {
+      auto begin = sizes.begin() + piece * num_files;
+      auto count = std::accumulate(begin, begin + num_files, std::int64_t{0});
+      SLIC_ERROR_IF(total + count > std::numeric_limits<int>::max(),
+                    "Aggregated GLVis output is too large, increase the number of writers");
+      displacements.push_back(static_cast<int>(total));
+      counts.push_back(static_cast<int>(count));
+      total += count;
+    }
+    data.resize(static_cast<std::size_t>(total));
+  }
+
+  MPI_Gatherv(local_data.data(), static_cast<int>(local_count), MPI_CHAR, data.data(), counts.data(),
+              displacements.data(), MPI_CHAR, 0, group_comm_);
+
+  if (!isWriter()) {
+    return {};
+  }
+
+  auto pieces        = std::make_shared<GatheredPieces>();
+  pieces->data       = std::move(data);
+  pieces->sizes      = std::move(sizes);
+  pieces->precision  = precision;
+  pieces->compress   = compress_;
+  pieces->file_names = {fmt::format("{0}-mesh.{1:0>6}.{2:0>6}", root_name, cycle, group_)};
+  for (const auto& [name, _] : fields) {
+    pieces->file_names.push_back(fmt::format("{0}-{1}.{2:0>6}.{3:0>6}", root_name, name, cycle, group_));
+  }
+
+  return [pieces]() { pieces->write(); };
+}
+
+}  // namespace serac::output
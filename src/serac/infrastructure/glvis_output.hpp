@@ -0,0 +1,125 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file glvis_output.hpp
+ *
+ * @brief Aggregated (N-to-M) GLVis output
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mfem.hpp"
+#include "mpi.h"
+
+namespace serac::output {
+
+/**
+ * @brief Writes GLVis files through a fixed number of writer ranks
+ *
+ * The ranks are split into contiguous groups, one per writer. Each rank serializes its part of the
+ * mesh and fields and sends it to the first rank of its group, which merges the pieces into a single
+ * serial mesh and grid function per field. The result is one mesh file and one solution file per
+ * field for each group, named like the per-rank files, so that the output can be viewed with
+ * @code
+ * glvis -np <num_writers> -m <root>-mesh.<cycle> -g <root>-<field>.<cycle>
+ * @endcode
+ */
+class GLVisAggregator {
+public:
+  /**
+   * @brief The name and values of a field to write
+   */
+  using Field = std::pair<std::string, const mfem::ParGridFunction*>;
+
+  /**
+   * @brief Splits the communicator into writer groups
+   *
+   * @param[in] comm The communicator of the mesh
+   * @param[in] num_writers The number of writer ranks (and file sets), clamped to the number of ranks
+   * @param[in] compress Whether the files are gzip-compressed (GLVis reads these directly)
+   */
+  GLVisAggregator(MPI_Comm comm, const int num_writers, const bool compress = false);
+
+  /**
+   * @brief Deleted copy constructor
+   */
+  GLVisAggregator(const GLVisAggregator&) = delete;
+
+  /**
+   * @brief Deleted copy assignment
+   */
+  GLVisAggregator& operator=(const GLVisAggregator&) = delete;
+
+  /**
+   * @brief Frees the group communicator
+   */
+  ~GLVisAggregator();
+
+  /**
+   * @brief Gathers the pieces of the mesh and fields onto the writer ranks
+   *
+   * This is collective over the communicator passed to the constructor.
+   *
+   * @param[in] root_name The prefix of the output file names
+   * @param[in] cycle The cycle used in the file names
+   * @param[in] mesh The mesh to write
+   * @param[in] fields The fields to write
+   * @param[in] precision The number of significant figures for the mesh nodes and field values
+   * @return On writer ranks, a task that merges the gathered pieces and writes the files. The task makes
+   * no MPI calls, so it may be run on a background thread. On the other ranks, an empty function.
+   */
+  std::function<void()> gather(const std::string& root_name, const int cycle, const mfem::ParMesh& mesh,
+                               const std::vector<Field>& fields, const int precision) const;
+
+  /**
+   * @brief Returns the number of writer groups
+   */
+  int numWriters() const { return num_writers_; }
+
+  /**
+   * @brief Returns whether the calling rank writes files
+   */
+  bool isWriter() const { return group_rank_ == 0; }
+
+private:
+  /**
+   * @brief The communicator of the ranks in this rank's group
+   */
+  MPI_Comm group_comm_;
+
+  /**
+   * @brief The number of writer groups
+   */
+  int num_writers_;
+
+  /**
+   * @brief The index of this rank's group
+   */
+  int group_;
+
+  /**
+   * @brief The rank within the group
+   */
+  int group_rank_;
+
+  /**
+   * @brief The number of ranks in the group
+   */
+  int group_size_;
+
+  /**
+   * @brief Whether the files are gzip-compressed
+   */
+  bool compress_;
+};
+
+}  // namespace serac::output
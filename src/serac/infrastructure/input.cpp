@@ -8,22 +8,240 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
 
 #include "axom/core.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/lua_function.hpp"
 #include "serac/infrastructure/terminator.hpp"
 #include "serac/physics/utilities/solver_config.hpp"
 
 namespace serac::input {
 
+namespace {
+
+/**
+ * @brief The Lua state of the most recently initialized input file, used to find the source of coefficient functions,
+ * or null once the Inlet that owns it is destroyed
+ */
+sol::state* lua_state = nullptr;
+
+/**
+ * @brief A Lua reader that publishes its state for finding the source of coefficient functions while it is alive
+ *
+ * The reader is owned by the Inlet returned from initialize, so the state is only published for the lifetime of
+ * that Inlet, and Inlets created later without initialize don't see a destroyed state.
+ */
+class SourceLuaReader : public axom::inlet::LuaReader {
+public:
+  SourceLuaReader() { lua_state = &solState(); }
+
+  ~SourceLuaReader() override
+  {
+    if (lua_state == &solState()) {
+      lua_state = nullptr;
+    }
+  }
+};
+
+/**
+ * @brief A function of a position and a time with one or more components
+ */
+using PointFunction = std::function<void(const mfem::Vector&, double, mfem::Vector&)>;
+
+/**
+ * @brief Returns the source code of the Lua function at a path in the input file, if it can be found
+ *
+ * @param[in] path The slash-separated path of the function, as given by the Inlet container names
+ */
+std::optional<std::string> luaFunctionSource(const std::string& path)
+{
+  if (!lua_state) {
+    return std::nullopt;
+  }
+
+  // Walk the Lua tables along the path, skipping the groups Inlet adds for collections
+  sol::object        object = lua_state->globals();
+  std::istringstream path_stream(path);
+  std::string        key;
+  while (std::getline(path_stream, key, '/')) {
+    if (key.empty() || key == "_inlet_collection") {
+      continue;
+    }
+    if (object.get_type() != sol::type::table) {
+      return std::nullopt;
+    }
+    auto table = object.as<sol::table>();
+    // Arrays are indexed by integers in Lua but stored under string keys by Inlet
+    sol::object child = table[key];
+    if (child.get_type() == sol::type::lua_nil &&
+        std::all_of(key.begin(), key.end(), [](const unsigned char c) { return std::isdigit(c); })) {
+      child = table[std::stoi(key)];
+    }
+    object = child;
+  }
+  if (object.get_type() != sol::type::function) {
+    return std::nullopt;
+  }
+
+  // Use the C API rather than debug.getinfo, as the debug library is not loaded by Inlet
+  lua_Debug  info;
+  lua_State* state = lua_state->lua_state();
+  object.push(state);
+  if (lua_getinfo(state, ">S", &info) == 0 || !info.source) {
+    return std::nullopt;
+  }
+  const std::string source     = info.source;
+  const int         first_line = info.linedefined;
+  const int         last_line  = info.lastlinedefined;
+  if (source.empty() || first_line <= 0 || last_line < first_line) {
+    return std::nullopt;
+  }
+
+  // Chunks loaded from a file have their source given as @<filename>, otherwise the source is the chunk itself
+  std::unique_ptr<std::istream> lines;
+  if (source[0] == '@') {
+    lines = std::make_unique<std::ifstream>(source.substr(1));
+  } else {
+    lines = std::make_unique<std::istringstream>(source);
+  }
+
+  std::string result;
+  std::string line;
+  for (int line_number = 1; line_number <= last_line && std::getline(*lines, line); line_number++) {
+    if (line_number >= first_line) {
+      result += line + '\n';
+    }
+  }
+  if (result.empty()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+/**
+ * @brief Checks that the values of two functions match at a handful of probe points and times
+ *
+ * @param[in] f The first function
+ * @param[in] g The second function
+ * @param[in] num_components The number of components to compare
+ * @param[in] shift_position Whether to evaluate g at a different position than f, which checks that a
+ * function only depends on time
+ */
+bool sameValues(const PointFunction& f, const PointFunction& g, const int num_components, const bool shift_position)
+{
+  constexpr double points[][3] = {{0.3, -0.7, 1.1}, {2.5, 0.4, -1.3}, {-1.9, 3.1, 0.6}};
+  constexpr double times[]     = {0.0, 0.35, 2.0};
+
+  mfem::Vector x(3), shifted_x(3), f_value(3), g_value(3);
+  for (const auto& point : points) {
+    for (const double t : times) {
+      for (int i = 0; i < 3; i++) {
+        x(i)         = point[i];
+        shifted_x(i) = shift_position ? 1.0 - 2.0 * point[i] : point[i];
+      }
+      f_value = 0.0;
+      g_value = 0.0;
+      f(x, t, f_value);
+      g(shifted_x, t, g_value);
+      for (int i = 0; i < num_components; i++) {
+        if (std::isnan(f_value(i)) && std::isnan(g_value(i))) {
+          continue;
+        }
+        if (std::abs(f_value(i) - g_value(i)) > 1.0e-12 * std::max(1.0, std::abs(g_value(i)))) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Replaces an interpreted Lua function with a faster equivalent when its source allows it
+ *
+ * Functions in the supported subset of CompiledLuaFunction are evaluated natively, and functions that
+ * only depend on time are evaluated once per time value. Either replacement is only made if it gives
+ * the same values as the interpreter at a few probe points, so anything the analysis gets wrong falls
+ * back to the interpreter.
+ *
+ * @param[in] path The path of the function in the input file
+ * @param[in] interpreted The interpreted function
+ * @param[in] num_components The number of components of the function's value
+ * @return The replacement, or the interpreted function if there is none
+ */
+PointFunction accelerateLuaFunction(const std::string& path, PointFunction interpreted, const int num_components)
+{
+  auto source = luaFunctionSource(path);
+  if (!source) {
+    return interpreted;
+  }
+  auto analysis = LuaFunctionAnalysis::analyze(*source);
+
+  if (analysis.compiled && analysis.compiled->numComponents() <= std::max(num_components, 3)) {
+    auto compiled = [function = *analysis.compiled, interpreted](const mfem::Vector& x, double t,
+                                                                 mfem::Vector& output) {
+      // The interpreter handles positions with fewer components than the function uses
+      if (x.Size() < function.requiredDimension()) {
+        interpreted(x, t, output);
+        return;
+      }
+      for (int i = 0; i < output.Size(); i++) {
+        output(i) = (i < function.numComponents()) ? function.evaluate(i, x.GetData(), t) : 0.0;
+      }
+    };
+    if (sameValues(compiled, interpreted, num_components, false)) {
+      SLIC_DEBUG_ROOT(fmt::format("Evaluating '{}' natively", path));
+      return compiled;
+    }
+    SLIC_DEBUG_ROOT(fmt::format("Compiled form of '{}' does not match the interpreter, using the interpreter", path));
+  }
+
+  if (!analysis.depends_on_position && sameValues(interpreted, interpreted, num_components, true)) {
+    SLIC_DEBUG_ROOT(fmt::format("Evaluating '{}' once per time value", path));
+    return [interpreted, last_time = std::numeric_limits<double>::quiet_NaN(), last_value = mfem::Vector()](
+               const mfem::Vector& x, double t, mfem::Vector& output) mutable {
+      if (t != last_time || last_value.Size() != output.Size()) {
+        last_value.SetSize(output.Size());
+        interpreted(x, t, last_value);
+        last_time = t;
+      }
+      output = last_value;
+    };
+  }
+
+  return interpreted;
+}
+
+/**
+ * @brief Replaces an interpreted scalar Lua function with a faster equivalent when its source allows it
+ */
+std::function<double(const mfem::Vector&, double)> accelerateScalarFunction(
+    const std::string& path, std::function<double(const mfem::Vector&, double)> interpreted)
+{
+  auto accelerated = accelerateLuaFunction(
+      path, [interpreted](const mfem::Vector& x, double t, mfem::Vector& output) { output(0) = interpreted(x, t); },
+      1);
+  return [accelerated, value = mfem::Vector(1)](const mfem::Vector& x, double t) mutable {
+    accelerated(x, t, value);
+    return value(0);
+  };
+}
+
+}  // namespace
+
 axom::inlet::Inlet initialize(axom::sidre::DataStore& datastore, const std::string& input_file_path,
                               const Language language, const std::string& sidre_path)
 {
   // Initialize Inlet
   std::unique_ptr<axom::inlet::Reader> reader;
   if (language == Language::Lua) {
-    reader = std::make_unique<axom::inlet::LuaReader>();
+    reader = std::make_unique<SourceLuaReader>();
   } else if (language == Language::JSON) {
     reader = std::make_unique<axom::inlet::JSONReader>();
   } else if (language == Language::YAML) {
@@ -94,6 +312,11 @@ void defineOutputTypeInputFileSchema(axom::inlet::Container& container)
   container.addString("output_type", "Desired output format")
       .validValues({"GLVis", "ParaView", "VisIt", "SidreVisIt"})
       .defaultValue("VisIt");
+  container.addBool("async_output", "Write output files from a background thread (GLVis output only)")
+      .defaultValue(false);
+  container.addInt("output_writers", "Number of ranks that write aggregated GLVis files, 0 for one file set per rank")
+      .defaultValue(0);
+  container.addBool("compress_output", "Compress aggregated GLVis files with gzip").defaultValue(false);
 }
 
 void BoundaryConditionInputOptions::defineInputFileSchema(axom::inlet::Container& container)
@@ -271,6 +494,8 @@ serac::input::CoefficientInputOptions FromInlet<serac::input::CoefficientInputOp
       // Copy from the primal vector into the MFEM vector
       std::copy(ret.vec.data(), ret.vec.data() + input.Size(), output.GetData());
     };
+    result.vector_function =
+        serac::input::accelerateLuaFunction(base.name() + "/vector_function", std::move(result.vector_function), 3);
     coefficient_definitions++;
   }
 
@@ -279,6 +504,8 @@ serac::input::CoefficientInputOptions FromInlet<serac::input::CoefficientInputOp
     result.scalar_function = [func(std::move(func))](const mfem::Vector& input, double t) {
       return func({input.GetData(), input.Size()}, t);
     };
+    result.scalar_function =
+        serac::input::accelerateScalarFunction(base.name() + "/scalar_function", std::move(result.scalar_function));
     coefficient_definitions++;
   }
 
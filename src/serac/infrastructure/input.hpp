@@ -72,7 +72,7 @@ std::string fullDirectoryFromPath(const std::string& file_path);
 void defineVectorInputFileSchema(axom::inlet::Container& container);
 
 /**
- * @brief Defines the schema for serac::OutputType
+ * @brief Defines the schema for serac::OutputType and how the output files are written
  * @param[inout] container The base container on which to define the schema
  */
 void defineOutputTypeInputFileSchema(axom::inlet::Container& container);
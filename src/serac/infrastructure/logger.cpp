@@ -10,6 +10,8 @@
 #include "serac/infrastructure/terminator.hpp"
 
 #include <fstream>
+#include <functional>
+#include <memory>
 
 namespace serac::logger {
 
@@ -20,88 +22,55 @@ int rank() { return logger_rank; }
 // output stream for the SLIC LogStreams that write to a file
 static std::ofstream logger_ofstream;
 
-bool initialize(MPI_Comm comm)
-{
-  namespace slic = axom::slic;
+// communicator the logger was initialized with
+static MPI_Comm logger_comm = MPI_COMM_WORLD;
 
-  if (!slic::isInitialized()) {
-    slic::initialize();
-  }
+// whether the asynchronous streams have replaced the initial ones
+static bool async_enabled = false;
 
-  auto [num_ranks, rank] = getMPIInfo(comm);
-  logger_rank            = rank;
+// creates a log stream from an output stream and a format string
+using StreamFactory = std::function<axom::slic::LogStream*(std::ostream*, const std::string&)>;
 
-  std::string loggerName = num_ranks > 1 ? "serac_parallel_logger" : "serac_serial_logger";
-  slic::createLogger(loggerName);
-  slic::activateLogger(loggerName);
-  if (!slic::activateLogger(loggerName)) {
+/**
+ * @brief Creates and activates a SLIC logger
+ *
+ * @param[in] name The name of the logger
+ * @param[in] make_stream Creates a log stream from an output stream and a format string
+ * @param[in] num_ranks The number of ranks in the logger's communicator
+ */
+static bool setUpLogger(const std::string& name, StreamFactory make_stream, const int num_ranks)
+{
+  namespace slic = axom::slic;
+
+  slic::createLogger(name);
+  if (!slic::activateLogger(name)) {
     // Can't log through SLIC since it just failed to activate
-    std::cerr << "Error: Failed to activate logger: " << loggerName << std::endl;
+    std::cerr << "Error: Failed to activate logger: " << name << std::endl;
     return false;
   }
 
-  // Console streams, std::cout for info/debug, std::cerr for warnings/errors
-  slic::LogStream* i_console_logstream  = nullptr;  // info
-  slic::LogStream* d_console_logstream  = nullptr;  // debug
-  slic::LogStream* we_console_logstream = nullptr;  // warnings and errors
-
-  // File streams, all message levels go to one file
-  if (rank == 0) {
-    // Only root node writes/opens the file, other nodes will have a noop stream
-    logger_ofstream.open("serac.out", std::ofstream::out);
-  }
-
-  slic::LogStream* i_file_logstream  = nullptr;  // info
-  slic::LogStream* d_file_logstream  = nullptr;  // debug
-  slic::LogStream* we_file_logstream = nullptr;  // warnings and errors
-
   // Stream formatting strings
   std::string i_format_string  = "<MESSAGE>\n";
   std::string d_format_string  = "[<LEVEL>]: <MESSAGE>\n";
   std::string we_format_string = "[<LEVEL> (<FILE>:<LINE>)]\n<MESSAGE>\n\n";
 
-  // Only create a parallel logger when there is more than one rank
   if (num_ranks > 1) {
     // Add rank to format strings if parallel
     // Note: i_format_string's extra space is on purpose due to no space on above string
     i_format_string  = "[<RANK>] " + i_format_string;
     d_format_string  = "[<RANK>]" + d_format_string;
     we_format_string = "[<RANK>]" + we_format_string;
+  }
 
-#ifdef SERAC_USE_LUMBERJACK
-    const int RLIMIT = 8;
-
-    // Console streams
-    i_console_logstream  = new slic::LumberjackStream(&std::cout, comm, RLIMIT, i_format_string);
-    d_console_logstream  = new slic::LumberjackStream(&std::cout, comm, RLIMIT, d_format_string);
-    we_console_logstream = new slic::LumberjackStream(&std::cerr, comm, RLIMIT, we_format_string);
+  // Console streams, std::cout for info/debug, std::cerr for warnings/errors
+  slic::LogStream* i_console_logstream  = make_stream(&std::cout, i_format_string);   // info
+  slic::LogStream* d_console_logstream  = make_stream(&std::cout, d_format_string);   // debug
+  slic::LogStream* we_console_logstream = make_stream(&std::cerr, we_format_string);  // warnings and errors
 
-    // File streams
-    i_file_logstream  = new slic::LumberjackStream(&logger_ofstream, comm, RLIMIT, i_format_string);
-    d_file_logstream  = new slic::LumberjackStream(&logger_ofstream, comm, RLIMIT, d_format_string);
-    we_file_logstream = new slic::LumberjackStream(&logger_ofstream, comm, RLIMIT, we_format_string);
-#else
-    // Console streams
-    i_console_logstream  = new slic::SynchronizedStream(&std::cout, comm, i_format_string);
-    d_console_logstream  = new slic::SynchronizedStream(&std::cout, comm, d_format_string);
-    we_console_logstream = new slic::SynchronizedStream(&std::cerr, comm, we_format_string);
-
-    // File streams
-    i_file_logstream  = new slic::SynchronizedStream(&logger_ofstream, comm, i_format_string);
-    d_file_logstream  = new slic::SynchronizedStream(&logger_ofstream, comm, d_format_string);
-    we_file_logstream = new slic::SynchronizedStream(&logger_ofstream, comm, we_format_string);
-#endif
-  } else {
-    // Console streams
-    i_console_logstream  = new slic::GenericOutputStream(&std::cout, i_format_string);
-    d_console_logstream  = new slic::GenericOutputStream(&std::cout, d_format_string);
-    we_console_logstream = new slic::GenericOutputStream(&std::cerr, we_format_string);
-
-    // File streams
-    i_file_logstream  = new slic::GenericOutputStream(&logger_ofstream, i_format_string);
-    d_file_logstream  = new slic::GenericOutputStream(&logger_ofstream, d_format_string);
-    we_file_logstream = new slic::GenericOutputStream(&logger_ofstream, we_format_string);
-  }
+  // File streams, all message levels go to one file
+  slic::LogStream* i_file_logstream  = make_stream(&logger_ofstream, i_format_string);   // info
+  slic::LogStream* d_file_logstream  = make_stream(&logger_ofstream, d_format_string);   // debug
+  slic::LogStream* we_file_logstream = make_stream(&logger_ofstream, we_format_string);  // warnings and errors
 
   slic::setLoggingMsgLevel(slic::message::Debug);
 
@@ -122,16 +91,79 @@ bool initialize(MPI_Comm comm)
   slic::setAbortOnError(true);
   slic::setAbortOnWarning(false);
 
-  std::string msg = fmt::format("Logger activated: {0}", loggerName);
+  std::string msg = fmt::format("Logger activated: {0}", name);
   SLIC_INFO_ROOT(msg);
   serac::logger::flush();
 
   return true;
 }
 
+bool initialize(MPI_Comm comm)
+{
+  namespace slic = axom::slic;
+
+  if (!slic::isInitialized()) {
+    slic::initialize();
+  }
+
+  auto [num_ranks, rank] = getMPIInfo(comm);
+  logger_rank            = rank;
+  logger_comm            = comm;
+
+  if (rank == 0) {
+    // Only root node writes/opens the file, other nodes will have a noop stream
+    logger_ofstream.open("serac.out", std::ofstream::out);
+  }
+
+  // Only create a parallel logger when there is more than one rank
+  if (num_ranks > 1) {
+#ifdef SERAC_USE_LUMBERJACK
+    return setUpLogger(
+        "serac_parallel_logger",
+        [comm](std::ostream* stream, const std::string& format) {
+          const int RLIMIT = 8;
+          return new slic::LumberjackStream(stream, comm, RLIMIT, format);
+        },
+        num_ranks);
+#else
+    return setUpLogger(
+        "serac_parallel_logger",
+        [comm](std::ostream* stream, const std::string& format) {
+          return new slic::SynchronizedStream(stream, comm, format);
+        },
+        num_ranks);
+#endif
+  }
+
+  return setUpLogger(
+      "serac_serial_logger",
+      [](std::ostream* stream, const std::string& format) { return new slic::GenericOutputStream(stream, format); },
+      num_ranks);
+}
+
+bool enableAsync(const AsyncOptions& options)
+{
+  if (async_enabled) {
+    return true;
+  }
+
+  // Write whatever the current streams hold, as they will no longer be flushed
+  serac::logger::flush();
+
+  auto sink = std::make_shared<AsyncLogSink>(logger_comm, options);
+
+  const int num_ranks = getMPIInfo(logger_comm).first;
+  async_enabled       = setUpLogger(
+      "serac_async_logger",
+      [sink](std::ostream* stream, const std::string& format) { return new AsyncLogStream(sink, stream, format); },
+      num_ranks);
+  return async_enabled;
+}
+
 void finalize()
 {
   axom::slic::finalize();
+  async_enabled = false;
   if (logger_ofstream.is_open()) {
     logger_ofstream.close();
   }
@@ -17,6 +17,8 @@
 #include "fmt/fmt.hpp"
 #include "mpi.h"
 
+#include "serac/infrastructure/async_log_stream.hpp"
+
 // Logger functionality
 namespace serac::logger {
 /**
@@ -31,6 +33,17 @@ namespace serac::logger {
  */
 bool initialize(MPI_Comm comm);
 
+/**
+ * @brief Replaces the logging streams with ones that format and write on a background thread.
+ *
+ * Logging a message then only queues it, and the messages of all ranks are aggregated
+ * on rank 0 with nonblocking communication at the given interval instead of at every flush.
+ * This is a collective operation on the communicator the logger was initialized with.
+ *
+ * @param[in] options The queue capacity and the aggregation interval
+ */
+bool enableAsync(const AsyncOptions& options = {});
+
 /**
  * @brief Finalizes the logger.
  *
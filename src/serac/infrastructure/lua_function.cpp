@@ -0,0 +1,580 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/lua_function.hpp"
+
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <unordered_map>
+
+namespace serac::input {
+
+namespace detail {
+
+/**
+ * @brief A token of Lua source code
+ */
+struct LuaToken {
+  /**
+   * @brief The kinds of tokens
+   */
+  enum class Kind
+  {
+    Name,
+    Number,
+    String,
+    Symbol
+  };
+
+  /**
+   * @brief The kind of token
+   */
+  Kind kind;
+
+  /**
+   * @brief The text of a Name or Symbol
+   */
+  std::string text;
+
+  /**
+   * @brief The value of a Number
+   */
+  double value = 0.0;
+};
+
+/**
+ * @brief Splits Lua source code into tokens
+ *
+ * @param[in] source The source code
+ * @return The tokens, or an empty optional if the source contains something that is not understood
+ */
+std::optional<std::vector<LuaToken>> tokenize(const std::string& source)
+{
+  std::vector<LuaToken> tokens;
+  std::size_t           i = 0;
+  while (i < source.size()) {
+    const char c = source[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      i++;
+    } else if (source.compare(i, 2, "--") == 0) {
+      // Block comments run to the matching ]], line comments to the end of the line
+      const bool        block = source.compare(i + 2, 2, "[[") == 0;
+      const std::size_t end   = source.find(block ? "]]" : "\n", i + 2);
+      i                       = (end == std::string::npos) ? source.size() : end + (block ? 2 : 1);
+    } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      std::size_t end = i;
+      while (end < source.size() && (std::isalnum(static_cast<unsigned char>(source[end])) || source[end] == '_')) {
+        end++;
+      }
+      tokens.push_back({LuaToken::Kind::Name, source.substr(i, end - i)});
+      i = end;
+    } else if (std::isdigit(static_cast<unsigned char>(c)) ||
+               (c == '.' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1])))) {
+      if (source.compare(i, 2, "0x") == 0 || source.compare(i, 2, "0X") == 0) {
+        return std::nullopt;
+      }
+      const char* begin  = source.c_str() + i;
+      char*       end    = nullptr;
+      const auto  value  = std::strtod(begin, &end);
+      const auto  length = static_cast<std::size_t>(end - begin);
+      tokens.push_back({LuaToken::Kind::Number, source.substr(i, length), value});
+      i += length;
+    } else if (c == '"' || c == '\'') {
+      std::size_t end = i + 1;
+      while (end < source.size() && source[end] != c) {
+        end += (source[end] == '\\') ? 2 : 1;
+      }
+      if (end >= source.size()) {
+        return std::nullopt;
+      }
+      tokens.push_back({LuaToken::Kind::String, source.substr(i, end + 1 - i)});
+      i = end + 1;
+    } else {
+      static const std::array<const char*, 9> multi_char_symbols = {"...", "..", "//", "==", "~=",
+                                                                    "<=",  ">=", "<<", ">>"};
+      std::string                             symbol(1, c);
+      for (const auto candidate : multi_char_symbols) {
+        if (source.compare(i, std::char_traits<char>::length(candidate), candidate) == 0) {
+          symbol = candidate;
+          break;
+        }
+      }
+      tokens.push_back({LuaToken::Kind::Symbol, symbol});
+      i += symbol.size();
+    }
+  }
+  return tokens;
+}
+
+/**
+ * @brief Finds the function in a token stream and compiles it if possible
+ */
+class LuaFunctionParser {
+public:
+  /**
+   * @brief Creates a parser for a token stream
+   * @param[in] tokens The tokens of the source code
+   */
+  explicit LuaFunctionParser(std::vector<LuaToken>&& tokens) : tokens_(std::move(tokens)) {}
+
+  /**
+   * @brief Analyzes the first function in the token stream
+   */
+  LuaFunctionAnalysis analyze()
+  {
+    LuaFunctionAnalysis analysis;
+
+    // Find the function keyword, skipping over the name of a named function
+    while (pos_ < tokens_.size() && !isName("function")) {
+      pos_++;
+    }
+    if (!accept("function")) {
+      return analysis;
+    }
+    if (peekKind(LuaToken::Kind::Name)) {
+      pos_++;
+      while ((accept(".") || accept(":")) && peekKind(LuaToken::Kind::Name)) {
+        pos_++;
+      }
+    }
+
+    // Read the parameter list
+    std::vector<std::string> parameters;
+    if (!accept("(")) {
+      return analysis;
+    }
+    while (!accept(")")) {
+      if (!peekKind(LuaToken::Kind::Name)) {
+        return analysis;
+      }
+      parameters.push_back(tokens_[pos_++].text);
+      accept(",");
+    }
+
+    // Find the end of the function body
+    const std::size_t body_begin = pos_;
+    std::size_t       body_end   = body_begin;
+    for (int depth = 1; depth > 0; body_end++) {
+      if (body_end == tokens_.size()) {
+        return analysis;
+      }
+      const auto& token = tokens_[body_end];
+      if (token.kind == LuaToken::Kind::Name) {
+        depth += (token.text == "function" || token.text == "if" || token.text == "do") ? 1 : 0;
+        depth -= (token.text == "end") ? 1 : 0;
+      }
+    }
+    body_end--;
+
+    // A function whose body never mentions the position can only depend on the time
+    analysis.depends_on_position = false;
+    if (!parameters.empty()) {
+      position_name_ = parameters[0];
+      for (std::size_t i = body_begin; i < body_end; i++) {
+        const bool is_field = (i > 0) && (tokens_[i - 1].text == "." || tokens_[i - 1].text == ":");
+        if (tokens_[i].kind == LuaToken::Kind::Name && tokens_[i].text == position_name_ && !is_field) {
+          analysis.depends_on_position = true;
+        }
+      }
+    }
+    if (parameters.size() > 1) {
+      time_name_ = parameters[1];
+    }
+
+    // Try to compile the body as a single return statement
+    pos_ = body_begin;
+    if (accept("return") && parseReturnValue()) {
+      accept(";");
+      if (pos_ == body_end) {
+        analysis.compiled = std::move(compiled_);
+      }
+    }
+    return analysis;
+  }
+
+private:
+  /**
+   * @brief Returns whether the current token is a name with the given text
+   */
+  bool isName(const char* text) const
+  {
+    return pos_ < tokens_.size() && tokens_[pos_].kind == LuaToken::Kind::Name && tokens_[pos_].text == text;
+  }
+
+  /**
+   * @brief Returns whether the current token is of the given kind
+   */
+  bool peekKind(const LuaToken::Kind kind) const { return pos_ < tokens_.size() && tokens_[pos_].kind == kind; }
+
+  /**
+   * @brief Consumes the current token if it is a name or symbol with the given text
+   */
+  bool accept(const char* text)
+  {
+    if (pos_ < tokens_.size() && tokens_[pos_].kind != LuaToken::Kind::String && tokens_[pos_].text == text) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Appends an instruction to the current program and tracks the stack depth
+   * @param[in] instruction The instruction
+   * @param[in] stack_change The change in the stack size caused by the instruction
+   */
+  void emit(const CompiledLuaFunction::Instruction& instruction, const int stack_change)
+  {
+    compiled_.programs_.back().push_back(instruction);
+    depth_ += stack_change;
+    max_depth_ = std::max(max_depth_, depth_);
+  }
+
+  /**
+   * @brief Parses either Vector.new(...) or a single scalar expression
+   */
+  bool parseReturnValue()
+  {
+    if (isName("Vector")) {
+      pos_++;
+      if (!accept(".") || !accept("new") || !accept("(")) {
+        return false;
+      }
+      do {
+        if (!parseComponent()) {
+          return false;
+        }
+      } while (accept(","));
+      return accept(")") && compiled_.programs_.size() <= 3;
+    }
+    return parseComponent();
+  }
+
+  /**
+   * @brief Parses the expression for one component of the return value into a new program
+   */
+  bool parseComponent()
+  {
+    compiled_.programs_.emplace_back();
+    depth_     = 0;
+    max_depth_ = 0;
+    return parseAdditive() && max_depth_ <= CompiledLuaFunction::MAX_STACK_DEPTH;
+  }
+
+  /**
+   * @brief Parses a sum or difference
+   */
+  bool parseAdditive()
+  {
+    if (!parseMultiplicative()) {
+      return false;
+    }
+    while (true) {
+      if (accept("+")) {
+        if (!parseMultiplicative()) return false;
+        emit({CompiledLuaFunction::Op::Add}, -1);
+      } else if (accept("-")) {
+        if (!parseMultiplicative()) return false;
+        emit({CompiledLuaFunction::Op::Subtract}, -1);
+      } else {
+        return true;
+      }
+    }
+  }
+
+  /**
+   * @brief Parses a product, quotient, or remainder
+   */
+  bool parseMultiplicative()
+  {
+    if (!parseUnary()) {
+      return false;
+    }
+    while (true) {
+      CompiledLuaFunction::Op op;
+      if (accept("*")) {
+        op = CompiledLuaFunction::Op::Multiply;
+      } else if (accept("/")) {
+        op = CompiledLuaFunction::Op::Divide;
+      } else if (accept("//")) {
+        op = CompiledLuaFunction::Op::FloorDivide;
+      } else if (accept("%")) {
+        op = CompiledLuaFunction::Op::Modulo;
+      } else {
+        return true;
+      }
+      if (!parseUnary()) {
+        return false;
+      }
+      emit({op}, -1);
+    }
+  }
+
+  /**
+   * @brief Parses a negation, which binds less tightly than exponentiation
+   */
+  bool parseUnary()
+  {
+    if (accept("-")) {
+      if (!parseUnary()) {
+        return false;
+      }
+      emit({CompiledLuaFunction::Op::Negate}, 0);
+      return true;
+    }
+    return parsePower();
+  }
+
+  /**
+   * @brief Parses a right-associative exponentiation
+   */
+  bool parsePower()
+  {
+    if (!parsePrimary()) {
+      return false;
+    }
+    if (accept("^")) {
+      if (!parseUnary()) {
+        return false;
+      }
+      emit({CompiledLuaFunction::Op::Power}, -1);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Parses a number, parameter, math library entry, or parenthesized expression
+   */
+  bool parsePrimary()
+  {
+    if (peekKind(LuaToken::Kind::Number)) {
+      emit({CompiledLuaFunction::Op::Constant, tokens_[pos_++].value}, 1);
+      return true;
+    }
+
+    if (accept("(")) {
+      return parseAdditive() && accept(")");
+    }
+
+    if (!position_name_.empty() && isName(position_name_.c_str())) {
+      pos_++;
+      if (!accept(".")) {
+        return false;
+      }
+      for (int component = 0; component < 3; component++) {
+        if (accept(COMPONENT_NAMES[component])) {
+          CompiledLuaFunction::Instruction instruction{CompiledLuaFunction::Op::Position};
+          instruction.component              = component;
+          compiled_.max_position_component_ = std::max(compiled_.max_position_component_, component);
+          emit(instruction, 1);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    if (!time_name_.empty() && isName(time_name_.c_str())) {
+      pos_++;
+      emit({CompiledLuaFunction::Op::Time}, 1);
+      return true;
+    }
+
+    if (isName("math")) {
+      pos_++;
+      return accept(".") && parseMath();
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Parses the part of a math library expression after "math."
+   */
+  bool parseMath()
+  {
+    using Function1 = double (*)(double);
+    using Function2 = double (*)(double, double);
+
+    // clang-format off
+    static const std::unordered_map<std::string, Function1> functions1 = {
+        {"abs",   [](double a) { return std::abs(a); }},   {"acos",  [](double a) { return std::acos(a); }},
+        {"asin",  [](double a) { return std::asin(a); }},  {"atan",  [](double a) { return std::atan(a); }},
+        {"ceil",  [](double a) { return std::ceil(a); }},  {"cos",   [](double a) { return std::cos(a); }},
+        {"exp",   [](double a) { return std::exp(a); }},   {"floor", [](double a) { return std::floor(a); }},
+        {"log",   [](double a) { return std::log(a); }},   {"sin",   [](double a) { return std::sin(a); }},
+        {"sqrt",  [](double a) { return std::sqrt(a); }},  {"tan",   [](double a) { return std::tan(a); }}};
+    static const std::unordered_map<std::string, Function2> functions2 = {
+        {"atan", [](double a, double b) { return std::atan2(a, b); }},
+        {"fmod", [](double a, double b) { return std::fmod(a, b); }},
+        {"max",  [](double a, double b) { return std::max(a, b); }},
+        {"min",  [](double a, double b) { return std::min(a, b); }},
+        {"pow",  [](double a, double b) { return std::pow(a, b); }}};
+    // clang-format on
+
+    if (!peekKind(LuaToken::Kind::Name)) {
+      return false;
+    }
+    const std::string name = tokens_[pos_++].text;
+    if (name == "pi") {
+      emit({CompiledLuaFunction::Op::Constant, M_PI}, 1);
+      return true;
+    }
+    if (name == "huge") {
+      emit({CompiledLuaFunction::Op::Constant, std::numeric_limits<double>::infinity()}, 1);
+      return true;
+    }
+
+    // Parse the arguments first, then choose the overload by the argument count
+    if (!accept("(")) {
+      return false;
+    }
+    int num_args = 0;
+    do {
+      if (!parseAdditive()) {
+        return false;
+      }
+      num_args++;
+      // min and max accept any number of arguments
+      if (num_args > 2 && (name == "min" || name == "max")) {
+        CompiledLuaFunction::Instruction instruction{CompiledLuaFunction::Op::Call2};
+        instruction.function2 = functions2.at(name);
+        emit(instruction, -1);
+      }
+    } while (accept(","));
+    if (!accept(")")) {
+      return false;
+    }
+
+    if (num_args == 1 && functions1.count(name) > 0) {
+      CompiledLuaFunction::Instruction instruction{CompiledLuaFunction::Op::Call1};
+      instruction.function1 = functions1.at(name);
+      emit(instruction, 0);
+      return true;
+    }
+    if (num_args >= 2 && functions2.count(name) > 0 && (num_args == 2 || name == "min" || name == "max")) {
+      CompiledLuaFunction::Instruction instruction{CompiledLuaFunction::Op::Call2};
+      instruction.function2 = functions2.at(name);
+      emit(instruction, -1);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief The names of the position components
+   */
+  static constexpr std::array<const char*, 3> COMPONENT_NAMES = {"x", "y", "z"};
+
+  /**
+   * @brief The tokens of the source code
+   */
+  std::vector<LuaToken> tokens_;
+
+  /**
+   * @brief The index of the current token
+   */
+  std::size_t pos_ = 0;
+
+  /**
+   * @brief The name of the position parameter
+   */
+  std::string position_name_;
+
+  /**
+   * @brief The name of the time parameter
+   */
+  std::string time_name_;
+
+  /**
+   * @brief The function being compiled
+   */
+  CompiledLuaFunction compiled_;
+
+  /**
+   * @brief The stack depth of the current program
+   */
+  int depth_ = 0;
+
+  /**
+   * @brief The maximum stack depth of the current program
+   */
+  int max_depth_ = 0;
+};
+
+}  // namespace detail
+
+double CompiledLuaFunction::evaluate(const int component, const double* x, const double t) const
+{
+  std::array<double, MAX_STACK_DEPTH> stack;
+  std::size_t                         top = 0;
+  for (const auto& instruction : programs_[static_cast<std::size_t>(component)]) {
+    switch (instruction.op) {
+      case Op::Constant:
+        stack[top++] = instruction.value;
+        break;
+      case Op::Position:
+        stack[top++] = x[instruction.component];
+        break;
+      case Op::Time:
+        stack[top++] = t;
+        break;
+      case Op::Add:
+        top--;
+        stack[top - 1] += stack[top];
+        break;
+      case Op::Subtract:
+        top--;
+        stack[top - 1] -= stack[top];
+        break;
+      case Op::Multiply:
+        top--;
+        stack[top - 1] *= stack[top];
+        break;
+      case Op::Divide:
+        top--;
+        stack[top - 1] /= stack[top];
+        break;
+      case Op::Modulo:
+        // Lua's modulo takes the sign of the divisor
+        top--;
+        stack[top - 1] -= std::floor(stack[top - 1] / stack[top]) * stack[top];
+        break;
+      case Op::FloorDivide:
+        top--;
+        stack[top - 1] = std::floor(stack[top - 1] / stack[top]);
+        break;
+      case Op::Power:
+        top--;
+        stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+        break;
+      case Op::Negate:
+        stack[top - 1] = -stack[top - 1];
+        break;
+      case Op::Call1:
+        stack[top - 1] = instruction.function1(stack[top - 1]);
+        break;
+      case Op::Call2:
+        top--;
+        stack[top - 1] = instruction.function2(stack[top - 1], stack[top]);
+        break;
+    }
+  }
+  return stack[0];
+}
+
+LuaFunctionAnalysis LuaFunctionAnalysis::analyze(const std::string& source)
+{
+  auto tokens = detail::tokenize(source);
+  if (!tokens) {
+    return {};
+  }
+  return detail::LuaFunctionParser(std::move(*tokens)).analyze();
+}
+
+}  // namespace serac::input
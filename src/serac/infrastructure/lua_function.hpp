@@ -0,0 +1,158 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file lua_function.hpp
+ *
+ * @brief Native evaluation of simple Lua functions from input files
+ *
+ * Coefficient functions in input files are evaluated at every quadrature point, so calling into the
+ * Lua interpreter each time can cost more than the assembly itself. Functions whose body is a single
+ * arithmetic return statement are compiled into a small stack program that is evaluated in C++.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace serac::input {
+
+namespace detail {
+class LuaFunctionParser;
+}  // namespace detail
+
+/**
+ * @brief A Lua function of a position and a time compiled into native stack programs
+ *
+ * The supported subset is a function whose body is a single return statement of an arithmetic
+ * expression (+, -, *, /, %, //, ^, unary -, parentheses), number literals, the position
+ * components (v.x, v.y, v.z), the time, and the math library (math.sin, math.exp, math.pi, ...).
+ * Vector-valued functions return Vector.new(...) with one expression per component.
+ *
+ * The operators are evaluated in floating point like Lua numbers, e.g. a % b is computed as a - floor(a / b) * b,
+ * and the math library calls the C++ standard library. The results can differ from the interpreter by round-off,
+ * so callers compare the two at a few points before using the compiled form.
+ */
+class CompiledLuaFunction {
+public:
+  /**
+   * @brief Returns the number of components of the return value, 1 for scalar-valued functions
+   */
+  int numComponents() const { return static_cast<int>(programs_.size()); }
+
+  /**
+   * @brief Returns whether the function depends on the position argument
+   */
+  bool dependsOnPosition() const { return max_position_component_ >= 0; }
+
+  /**
+   * @brief Returns the number of position components that must be provided to evaluate the function
+   */
+  int requiredDimension() const { return max_position_component_ + 1; }
+
+  /**
+   * @brief Evaluates one component of the return value
+   *
+   * @param[in] component The component of the return value
+   * @param[in] x The position, with at least requiredDimension() components
+   * @param[in] t The time
+   */
+  double evaluate(const int component, const double* x, const double t) const;
+
+private:
+  friend class detail::LuaFunctionParser;
+
+  /**
+   * @brief The operations of the stack programs
+   */
+  enum class Op
+  {
+    Constant,
+    Position,
+    Time,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    FloorDivide,
+    Power,
+    Negate,
+    Call1,
+    Call2
+  };
+
+  /**
+   * @brief A single operation of a stack program
+   */
+  struct Instruction {
+    /**
+     * @brief The operation
+     */
+    Op op;
+    /**
+     * @brief The value of a Constant
+     */
+    double value = 0.0;
+    /**
+     * @brief The component of a Position
+     */
+    int component = 0;
+    /**
+     * @brief The function of a Call1
+     */
+    double (*function1)(double) = nullptr;
+    /**
+     * @brief The function of a Call2
+     */
+    double (*function2)(double, double) = nullptr;
+  };
+
+  /**
+   * @brief The maximum stack depth of a program
+   */
+  static constexpr int MAX_STACK_DEPTH = 32;
+
+  /**
+   * @brief The program for each component of the return value
+   */
+  std::vector<std::vector<Instruction>> programs_;
+
+  /**
+   * @brief The largest position component used by the programs, or -1 if the position is not used
+   */
+  int max_position_component_ = -1;
+};
+
+/**
+ * @brief The result of analyzing the source of a Lua function
+ */
+struct LuaFunctionAnalysis {
+  /**
+   * @brief Whether the function body could use the position argument
+   *
+   * This is false when the position parameter does not appear in the body, in which case the
+   * function only depends on the time and its values can be tabulated.
+   */
+  bool depends_on_position = true;
+
+  /**
+   * @brief The compiled function, if the function is in the supported subset
+   */
+  std::optional<CompiledLuaFunction> compiled;
+
+  /**
+   * @brief Analyzes the source of a Lua function
+   *
+   * @param[in] source Source code starting at or before the function keyword of the function. Anything
+   * after the end of the function is ignored.
+   */
+  static LuaFunctionAnalysis analyze(const std::string& source);
+};
+
+}  // namespace serac::input
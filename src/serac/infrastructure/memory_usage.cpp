@@ -0,0 +1,142 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/memory_usage.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "_hypre_parcsr_ls.h"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::memory {
+
+namespace {
+
+/**
+ * @brief Returns the bytes of a local hypre CSR matrix
+ * @param[in] matrix The matrix, which may be null
+ */
+std::size_t bytes(hypre_CSRMatrix* matrix)
+{
+  if (matrix == nullptr) {
+    return 0;
+  }
+  const auto rows     = static_cast<std::size_t>(hypre_CSRMatrixNumRows(matrix));
+  const auto nonzeros = static_cast<std::size_t>(hypre_CSRMatrixNumNonzeros(matrix));
+  return (rows + 1) * sizeof(HYPRE_Int) + nonzeros * (sizeof(HYPRE_Int) + sizeof(HYPRE_Complex));
+}
+
+/**
+ * @brief Returns the bytes of the local blocks of a hypre parallel matrix
+ * @param[in] matrix The matrix, which may be null
+ */
+std::size_t bytes(hypre_ParCSRMatrix* matrix)
+{
+  if (matrix == nullptr) {
+    return 0;
+  }
+  const auto offd_columns = static_cast<std::size_t>(hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(matrix)));
+  return bytes(hypre_ParCSRMatrixDiag(matrix)) + bytes(hypre_ParCSRMatrixOffd(matrix)) +
+         offd_columns * sizeof(HYPRE_BigInt);
+}
+
+}  // namespace
+
+std::size_t bytes(const mfem::SparseMatrix& matrix)
+{
+  const auto rows     = static_cast<std::size_t>(matrix.Height());
+  const auto nonzeros = static_cast<std::size_t>(matrix.NumNonZeroElems());
+  return (rows + 1) * sizeof(int) + nonzeros * (sizeof(int) + sizeof(double));
+}
+
+std::size_t bytes(const mfem::HypreParMatrix& matrix) { return bytes(static_cast<hypre_ParCSRMatrix*>(matrix)); }
+
+std::size_t bytes(const mfem::HypreBoomerAMG& amg)
+{
+  auto data = static_cast<hypre_ParAMGData*>(static_cast<void*>(static_cast<HYPRE_Solver>(amg)));
+  if (data == nullptr || hypre_ParAMGDataAArray(data) == nullptr) {
+    return 0;
+  }
+
+  // The finest operator belongs to the caller
+  const int   levels = hypre_ParAMGDataNumLevels(data);
+  std::size_t total  = 0;
+  for (int level = 0; level < levels; level++) {
+    if (level > 0) {
+      total += bytes(hypre_ParAMGDataAArray(data)[level]);
+    }
+    if (level < levels - 1 && hypre_ParAMGDataPArray(data) != nullptr) {
+      total += bytes(hypre_ParAMGDataPArray(data)[level]);
+    }
+  }
+  return total;
+}
+
+std::size_t residentBytes()
+{
+  std::ifstream statm("/proc/self/statm");
+  std::size_t   size     = 0;
+  std::size_t   resident = 0;
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::size_t peakResidentBytes()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+  // Linux reports kilobytes
+  return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+void report(const std::string& title, const MemoryUsage& usage, MPI_Comm comm)
+{
+  constexpr double mebibyte = 1024.0 * 1024.0;
+
+  std::map<std::string, double> local;
+  for (const auto& [name, bytes] : usage.parts()) {
+    local[name] = static_cast<double>(bytes) / mebibyte;
+  }
+
+  // Every rank takes part in the reductions, even if it does not have some of the parts
+  const auto names = profiling::detail::allNames(local, comm);
+  auto       rows  = names;
+  rows.insert(rows.end(), {"Total", "Resident (process)", "Peak resident (process)"});
+  local["Total"]                   = static_cast<double>(usage.total()) / mebibyte;
+  local["Resident (process)"]      = static_cast<double>(residentBytes()) / mebibyte;
+  local["Peak resident (process)"] = static_cast<double>(peakResidentBytes()) / mebibyte;
+  const auto statistics            = profiling::detail::reduce(rows, local, comm);
+
+  int num_ranks = 0;
+  MPI_Comm_size(comm, &num_ranks);
+
+  std::size_t name_width = title.size();
+  for (const auto& name : rows) {
+    name_width = std::max(name_width, name.size());
+  }
+  SLIC_INFO_ROOT(fmt::format("{0:<{1}} {2:>12} {3:>12} {4:>12} {5:>12}", title, name_width, "Min (MiB)", "Avg (MiB)",
+                             "Max (MiB)", "Sum (MiB)"));
+  for (std::size_t i = 0; i < rows.size(); i++) {
+    SLIC_INFO_ROOT(fmt::format("{0:<{1}} {2:>12.1f} {3:>12.1f} {4:>12.1f} {5:>12.1f}", rows[i], name_width,
+                               statistics[i].min, statistics[i].avg, statistics[i].max,
+                               statistics[i].avg * num_ranks));
+  }
+}
+
+}  // namespace serac::memory
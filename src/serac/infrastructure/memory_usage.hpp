@@ -0,0 +1,141 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file memory_usage.hpp
+ *
+ * @brief Accounting of the memory held by physics modules, operators, and solvers
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include "mfem.hpp"
+#include "mpi.h"
+
+namespace serac {
+
+/**
+ * @brief The bytes held by a component on this rank, by the name of each of its parts
+ *
+ * Components report the large buffers they own, e.g. vectors, matrices, and solver hierarchies. The parts of a
+ * subcomponent are added under its name, so "solid/nonlinear solver/AMG hierarchy" is a part of the "nonlinear solver"
+ * of the "solid" module.
+ */
+class MemoryUsage {
+public:
+  /**
+   * @brief Adds bytes to a part
+   *
+   * @param[in] name The name of the part
+   * @param[in] bytes The number of bytes
+   */
+  void add(const std::string& name, const std::size_t bytes) { bytes_[name] += bytes; }
+
+  /**
+   * @brief Adds the parts of a subcomponent, prefixed by its name
+   *
+   * @param[in] name The name of the subcomponent
+   * @param[in] usage The memory usage of the subcomponent
+   */
+  void add(const std::string& name, const MemoryUsage& usage)
+  {
+    for (const auto& [part, bytes] : usage.bytes_) {
+      bytes_[name + "/" + part] += bytes;
+    }
+  }
+
+  /**
+   * @brief Returns the bytes of each part by name
+   */
+  const std::map<std::string, std::size_t>& parts() const { return bytes_; }
+
+  /**
+   * @brief Returns the bytes of all parts
+   */
+  std::size_t total() const
+  {
+    std::size_t sum = 0;
+    for (const auto& [_, bytes] : bytes_) {
+      sum += bytes;
+    }
+    return sum;
+  }
+
+private:
+  /**
+   * @brief The bytes of each part by name
+   */
+  std::map<std::string, std::size_t> bytes_;
+};
+
+namespace memory {
+
+/**
+ * @brief Returns the bytes allocated by a vector
+ * @param[in] vector The vector
+ */
+inline std::size_t bytes(const mfem::Vector& vector)
+{
+  return static_cast<std::size_t>(vector.Capacity()) * sizeof(double);
+}
+
+/**
+ * @brief Returns the bytes allocated by an array
+ * @param[in] array The array
+ */
+template <typename T>
+std::size_t bytes(const mfem::Array<T>& array)
+{
+  return static_cast<std::size_t>(array.Capacity()) * sizeof(T);
+}
+
+/**
+ * @brief Returns the bytes of the CSR arrays of a sparse matrix
+ * @param[in] matrix The matrix
+ */
+std::size_t bytes(const mfem::SparseMatrix& matrix);
+
+/**
+ * @brief Returns the bytes of the local diagonal and off-diagonal blocks of a parallel matrix
+ * @param[in] matrix The matrix
+ */
+std::size_t bytes(const mfem::HypreParMatrix& matrix);
+
+/**
+ * @brief Returns the bytes of the coarse operators and the prolongations of an AMG hierarchy
+ *
+ * @param[in] amg The preconditioner
+ * @note The hierarchy is built on the first application of the preconditioner, before that this returns zero
+ */
+std::size_t bytes(const mfem::HypreBoomerAMG& amg);
+
+/**
+ * @brief Returns the resident set size of this process in bytes, or zero where /proc is not available
+ */
+std::size_t residentBytes();
+
+/**
+ * @brief Returns the largest resident set size of this process so far in bytes
+ */
+std::size_t peakResidentBytes();
+
+/**
+ * @brief Logs a table of the memory usage with its minimum, average, maximum, and sum over the ranks, followed by the
+ * resident and peak resident memory of the processes
+ *
+ * @param[in] title The heading of the table
+ * @param[in] usage The memory usage on this rank
+ * @param[in] comm The communicator to aggregate over, this is a collective operation
+ */
+void report(const std::string& title, const MemoryUsage& usage, MPI_Comm comm = MPI_COMM_WORLD);
+
+}  // namespace memory
+
+}  // namespace serac
@@ -19,7 +19,7 @@
 namespace serac::output {
 
 void outputFields(const axom::sidre::DataStore& datastore, const std::string& data_collection_name, double time,
-                  const Language language)
+                  const Language language, const std::optional<int> cycle)
 {
   SLIC_INFO_ROOT(fmt::format("Outputting field data at time: {}", time));
 
@@ -41,11 +41,15 @@ void outputFields(const axom::sidre::DataStore& datastore, const std::string& da
     output_language = "yaml";
   }
 
+  // Include the cycle in the file name when the fields are written more than once
+  auto [_, rank]   = serac::getMPIInfo();
+  std::string path = cycle ? fmt::format("{}_fields.{:0>6}.{}.{}", data_collection_name, *cycle, rank, output_language)
+                           : fmt::format("{}_fields.{}.{}", data_collection_name, rank, output_language);
+
   conduit::Node extracts;
   // "relay" is the Ascents Extract type for saving data
   extracts["e1/type"]            = "relay";
-  auto [_, rank]                 = serac::getMPIInfo();
-  extracts["e1/params/path"]     = fmt::format("{}_fields.{}.{}", data_collection_name, rank, output_language);
+  extracts["e1/params/path"]     = path;
   extracts["e1/params/protocol"] = output_language;
 
   // Get domain Sidre group
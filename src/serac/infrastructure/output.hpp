@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "mfem.hpp"
@@ -40,8 +41,9 @@ enum class Language
  * @param[in] data_collection_name Name of the Data Collection stored in Sidre
  * @param[in] time Current simulation time
  * @param[in] language The output language format
+ * @param[in] cycle If given, the cycle is included in the file name so that successive outputs are not overwritten
  */
 void outputFields(const axom::sidre::DataStore& datastore, const std::string& data_collection_name, double time,
-                  const Language language = Language::JSON);
+                  const Language language = Language::JSON, const std::optional<int> cycle = std::nullopt);
 
 }  // namespace serac::output
@@ -0,0 +1,163 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/output_scheduler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::output {
+
+namespace {
+/**
+ * @brief The relative tolerance used when comparing simulation times against a time interval
+ */
+constexpr double TIME_TOLERANCE = 1.0e-8;
+
+/**
+ * @brief The input file fields of a cadence
+ */
+constexpr std::array<const char*, 5> CADENCE_FIELDS{"cycle_interval", "time_interval", "wall_time_interval",
+                                                    "on_last_step", "on_solve_failure"};
+}  // namespace
+
+OutputScheduler::OutputScheduler(const Cadence& cadence, const double start_time)
+    : cadence_(cadence), start_time_(start_time), next_time_(start_time), last_wall_time_(Clock::now())
+{
+  if (cadence_.time_interval) {
+    next_time_ = start_time_ + *cadence_.time_interval;
+  }
+}
+
+bool OutputScheduler::isDue(const int cycle, const double time, const std::vector<OutputEvent>& events) const
+{
+  auto occurred = [&events](OutputEvent event) {
+    return std::find(events.begin(), events.end(), event) != events.end();
+  };
+
+  if (cadence_.on_last_step && occurred(OutputEvent::LastStep)) {
+    return true;
+  }
+
+  if (cadence_.on_solve_failure && occurred(OutputEvent::SolveFailure)) {
+    return true;
+  }
+
+  if (cadence_.cycle_interval && (cycle % *cadence_.cycle_interval == 0)) {
+    return true;
+  }
+
+  if (cadence_.time_interval && (time >= next_time_ - TIME_TOLERANCE * *cadence_.time_interval)) {
+    return true;
+  }
+
+  if (cadence_.wall_time_interval) {
+    const std::chrono::duration<double> elapsed = Clock::now() - last_wall_time_;
+    if (elapsed.count() >= *cadence_.wall_time_interval) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void OutputScheduler::recordOutput(const double time)
+{
+  if (cadence_.time_interval) {
+    // Advance to the first multiple of the interval past the current time so the schedule does not drift
+    const double interval  = *cadence_.time_interval;
+    const double intervals = std::floor((time - start_time_) / interval + TIME_TOLERANCE);
+    next_time_             = start_time_ + (intervals + 1.0) * interval;
+  }
+  last_wall_time_ = Clock::now();
+}
+
+bool OutputScheduler::check(const int cycle, const double time, const std::vector<OutputEvent>& events)
+{
+  if (isDue(cycle, time, events)) {
+    recordOutput(time);
+    return true;
+  }
+  return false;
+}
+
+void Cadence::defineInputFileSchema(axom::inlet::Container& container)
+{
+  container.addInt("cycle_interval", "Write output every time the cycle is a multiple of this value");
+  container.addDouble("time_interval", "Write output every time the simulation time crosses a multiple of this value");
+  container.addDouble("wall_time_interval",
+                      "Write output when this many seconds of wall-clock time have passed since the last output");
+  // None of the fields have defaults, so that a cadence is only present if one of its fields was given
+  container.addBool("on_last_step", "Write output on the last timestep (default: true)");
+  container.addBool("on_solve_failure", "Write output after a nonlinear solve fails to converge (default: true)");
+}
+
+void ScheduleInputOptions::defineInputFileSchema(axom::inlet::Container& container)
+{
+  auto& visualization =
+      container.addStruct("visualization", "When visualization output is written (default: every cycle)");
+  Cadence::defineInputFileSchema(visualization);
+
+  auto& restart = container.addStruct("restart", "When Sidre restart files are written (default: never)");
+  Cadence::defineInputFileSchema(restart);
+
+  auto& fields = container.addStruct("fields", "When field data is extracted through Ascent (default: last step)");
+  Cadence::defineInputFileSchema(fields);
+}
+
+}  // namespace serac::output
+
+serac::output::Cadence FromInlet<serac::output::Cadence>::operator()(const axom::inlet::Container& base)
+{
+  serac::output::Cadence result;
+
+  if (base.contains("cycle_interval")) {
+    result.cycle_interval = base["cycle_interval"];
+    SLIC_ERROR_ROOT_IF(*result.cycle_interval < 1, "Output cycle_interval must be positive");
+  }
+
+  if (base.contains("time_interval")) {
+    result.time_interval = base["time_interval"];
+    SLIC_ERROR_ROOT_IF(*result.time_interval <= 0.0, "Output time_interval must be positive");
+  }
+
+  if (base.contains("wall_time_interval")) {
+    result.wall_time_interval = base["wall_time_interval"];
+    SLIC_ERROR_ROOT_IF(*result.wall_time_interval <= 0.0, "Output wall_time_interval must be positive");
+  }
+
+  if (base.contains("on_last_step")) {
+    result.on_last_step = base["on_last_step"];
+  }
+
+  if (base.contains("on_solve_failure")) {
+    result.on_solve_failure = base["on_solve_failure"];
+  }
+  return result;
+}
+
+serac::output::ScheduleInputOptions FromInlet<serac::output::ScheduleInputOptions>::operator()(
+    const axom::inlet::Container& base)
+{
+  serac::output::ScheduleInputOptions result;
+  for (auto [name, cadence] : {std::pair{"visualization", &result.visualization},
+                               std::pair{"restart", &result.restart}, std::pair{"fields", &result.fields}}) {
+    // Inlet structs always exist, so a cadence is given if any of its fields is
+    const std::string prefix(name);
+    const auto&       fields = serac::output::CADENCE_FIELDS;
+    const bool        given  = std::any_of(fields.begin(), fields.end(), [&base, &prefix](const char* field) {
+      return base.contains(prefix + "/" + field);
+    });
+    if (given) {
+      *cadence = base[prefix].get<serac::output::Cadence>();
+    }
+  }
+  return result;
+}
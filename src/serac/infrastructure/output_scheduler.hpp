@@ -0,0 +1,221 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file output_scheduler.hpp
+ *
+ * @brief Decides when each kind of output should be written during a simulation
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include "axom/inlet.hpp"
+
+namespace serac::output {
+
+/**
+ * @brief Events that force an output regardless of the configured intervals
+ */
+enum class OutputEvent
+{
+  LastStep,    /**< The final timestep of the simulation */
+  SolveFailure /**< A nonlinear solve failed to converge during the timestep */
+};
+
+/**
+ * @brief How often a particular kind of output should be written
+ *
+ * An output is due when any of the configured triggers fires
+ */
+struct Cadence {
+  /**
+   * @brief Write whenever the cycle is a multiple of this value
+   */
+  std::optional<int> cycle_interval;
+
+  /**
+   * @brief Write each time the simulation time crosses a multiple of this value
+   */
+  std::optional<double> time_interval;
+
+  /**
+   * @brief Write when this many seconds of wall-clock time have passed since the last write
+   */
+  std::optional<double> wall_time_interval;
+
+  /**
+   * @brief Write on the last timestep
+   */
+  bool on_last_step = true;
+
+  /**
+   * @brief Write after a timestep in which a nonlinear solve failed to converge
+   */
+  bool on_solve_failure = true;
+
+  /**
+   * @brief A cadence that writes on every cycle
+   */
+  static Cadence everyCycle()
+  {
+    Cadence cadence;
+    cadence.cycle_interval = 1;
+    return cadence;
+  }
+
+  /**
+   * @brief A cadence that only writes on the last timestep
+   */
+  static Cadence lastStepOnly()
+  {
+    Cadence cadence;
+    cadence.on_solve_failure = false;
+    return cadence;
+  }
+
+  /**
+   * @brief A cadence that never writes
+   */
+  static Cadence never()
+  {
+    Cadence cadence;
+    cadence.on_last_step     = false;
+    cadence.on_solve_failure = false;
+    return cadence;
+  }
+
+  /**
+   * @brief Input file parameters specific to this class
+   *
+   * @param[in] container Inlet container on which the input schema will be defined
+   **/
+  static void defineInputFileSchema(axom::inlet::Container& container);
+};
+
+/**
+ * @brief Tracks when an output was last written and decides when the next one is due
+ */
+class OutputScheduler {
+public:
+  /**
+   * @brief Constructs a scheduler
+   *
+   * @param[in] cadence The triggers for this kind of output
+   * @param[in] start_time The simulation time at which the schedule starts
+   */
+  explicit OutputScheduler(const Cadence& cadence, const double start_time = 0.0);
+
+  /**
+   * @brief Returns whether an output is due, without recording it
+   *
+   * @param[in] cycle The current cycle
+   * @param[in] time The current simulation time
+   * @param[in] events The events that occurred during the current timestep
+   */
+  bool isDue(const int cycle, const double time, const std::vector<OutputEvent>& events = {}) const;
+
+  /**
+   * @brief Records that an output was written so the intervals restart from this point
+   *
+   * @param[in] time The simulation time of the output
+   */
+  void recordOutput(const double time);
+
+  /**
+   * @brief Returns whether an output is due and, if so, records it
+   *
+   * @param[in] cycle The current cycle
+   * @param[in] time The current simulation time
+   * @param[in] events The events that occurred during the current timestep
+   */
+  bool check(const int cycle, const double time, const std::vector<OutputEvent>& events = {});
+
+  /**
+   * @brief Returns the cadence used by the scheduler
+   */
+  const Cadence& cadence() const { return cadence_; }
+
+private:
+  /**
+   * @brief The clock used for wall-clock triggers
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief The configured triggers
+   */
+  Cadence cadence_;
+
+  /**
+   * @brief The simulation time at which the schedule starts
+   */
+  double start_time_;
+
+  /**
+   * @brief The simulation time at which the next time-interval output is due
+   */
+  double next_time_;
+
+  /**
+   * @brief The wall-clock time of the last output (or the construction of the scheduler)
+   */
+  Clock::time_point last_wall_time_;
+};
+
+/**
+ * @brief The cadences of each kind of output written by a driver
+ */
+struct ScheduleInputOptions {
+  /**
+   * @brief Visualization output (GLVis, ParaView, VisIt or Sidre, see serac::OutputType)
+   */
+  std::optional<Cadence> visualization;
+
+  /**
+   * @brief Sidre restart files
+   */
+  std::optional<Cadence> restart;
+
+  /**
+   * @brief Field data extracted through Ascent
+   */
+  std::optional<Cadence> fields;
+
+  /**
+   * @brief Input file parameters specific to this class
+   *
+   * @param[in] container Inlet container on which the input schema will be defined
+   **/
+  static void defineInputFileSchema(axom::inlet::Container& container);
+};
+
+}  // namespace serac::output
+
+/**
+ * @brief Prototype the specialization for Inlet parsing
+ *
+ * @tparam The object to be created by Inlet
+ */
+template <>
+struct FromInlet<serac::output::Cadence> {
+  /// @brief Returns created object from Inlet container
+  serac::output::Cadence operator()(const axom::inlet::Container& base);
+};
+
+/**
+ * @brief Prototype the specialization for Inlet parsing
+ *
+ * @tparam The object to be created by Inlet
+ */
+template <>
+struct FromInlet<serac::output::ScheduleInputOptions> {
+  /// @brief Returns created object from Inlet container
+  serac::output::ScheduleInputOptions operator()(const axom::inlet::Container& base);
+};
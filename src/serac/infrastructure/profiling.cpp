@@ -6,6 +6,14 @@
 
 #include "serac/infrastructure/profiling.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <vector>
+
 #include "serac/infrastructure/logger.hpp"
 
 #ifdef SERAC_USE_CALIPER
@@ -14,12 +22,109 @@
 
 namespace serac::profiling {
 
-#ifdef SERAC_USE_CALIPER
 namespace {
+
+#ifdef SERAC_USE_CALIPER
 std::optional<cali::ConfigManager> mgr;
-}  // namespace
 #endif
 
+/**
+ * @brief The built-in timers and counters
+ */
+struct Registry {
+  /**
+   * @brief Guards the insertion of new timers and counters
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief The timers by name, std::map does not move its elements so references to them stay valid
+   */
+  std::map<std::string, TimerRecord, std::less<>> timers;
+
+  /**
+   * @brief The counters by name
+   */
+  std::map<std::string, Counter, std::less<>> counters;
+};
+
+/**
+ * @brief Returns the registry, which is constructed on first use so that it can be used during static initialization
+ */
+Registry& registry()
+{
+  static Registry instance;
+  return instance;
+}
+
+/**
+ * @brief Returns the record of a name from a thread's cache, looking it up in the registry under its lock on a miss
+ *
+ * @param[in] name The name of the timer or counter
+ * @param[inout] cache The records this thread has already looked up
+ * @param[inout] records The records of the registry
+ */
+template <typename T>
+T& lookUp(std::string_view name, std::map<std::string, T*, std::less<>>& cache,
+          std::map<std::string, T, std::less<>>& records)
+{
+  if (auto cached = cache.find(name); cached != cache.end()) {
+    return *cached->second;
+  }
+
+  T* record = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    record = &records[std::string(name)];
+  }
+  cache.emplace(name, record);
+  return *record;
+}
+
+/**
+ * @brief The timers that this thread has looked up
+ */
+thread_local std::map<std::string, TimerRecord*, std::less<>> timer_cache;
+
+/**
+ * @brief The counters that this thread has looked up
+ */
+thread_local std::map<std::string, Counter*, std::less<>> counter_cache;
+
+/**
+ * @brief The regions of a name on a thread, see detail::startRegion
+ */
+struct Regions {
+  /**
+   * @brief The timer of the regions
+   */
+  TimerRecord* record;
+
+  /**
+   * @brief The start times of the regions that are open, innermost last
+   */
+  std::vector<std::chrono::steady_clock::time_point> starts;
+};
+
+/**
+ * @brief The regions of each name that has been used on this thread
+ */
+thread_local std::map<std::string, Regions, std::less<>> regions;
+
+/**
+ * @brief Returns the regions of a name on this thread, which only allocates the first time the name is used
+ */
+Regions& regionsNamed(const char* name)
+{
+  auto found = regions.find(std::string_view(name));
+  if (found == regions.end()) {
+    found = regions.emplace(name, Regions{&timer(name), {}}).first;
+  }
+  return found->second;
+}
+
+}  // namespace
+
 void initializeCaliper(const std::string& options)
 {
 #ifdef SERAC_USE_CALIPER
@@ -50,6 +155,144 @@ void terminateCaliper()
 #endif
 }
 
+TimerRecord& timer(std::string_view name) { return lookUp(name, timer_cache, registry().timers); }
+
+Counter& counter(std::string_view name) { return lookUp(name, counter_cache, registry().counters); }
+
+void resetTimersAndCounters()
+{
+  auto&                       r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (auto& [_, record] : r.timers) {
+    record.nanoseconds = 0;
+    record.calls       = 0;
+  }
+  for (auto& [_, value] : r.counters) {
+    value = 0;
+  }
+}
+
+void reportTimersAndCounters(MPI_Comm comm)
+{
+  std::map<std::string, double> seconds, calls, counts;
+  {
+    auto&                       r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& [name, record] : r.timers) {
+      seconds[name] = static_cast<double>(record.nanoseconds) * 1.0e-9;
+      calls[name]   = static_cast<double>(record.calls);
+    }
+    for (const auto& [name, value] : r.counters) {
+      counts[name] = static_cast<double>(value);
+    }
+  }
+
+  // Every rank takes part in the reductions, even if it has not used some of the timers
+  const auto timer_names    = detail::allNames(seconds, comm);
+  const auto timer_seconds  = detail::reduce(timer_names, seconds, comm);
+  const auto timer_calls    = detail::reduce(timer_names, calls, comm);
+  const auto counter_names  = detail::allNames(counts, comm);
+  const auto counter_values = detail::reduce(counter_names, counts, comm);
+
+  std::size_t name_width = std::string("Counter").size();
+  for (const auto& name : timer_names) {
+    name_width = std::max(name_width, name.size());
+  }
+  for (const auto& name : counter_names) {
+    name_width = std::max(name_width, name.size());
+  }
+
+  if (!timer_names.empty()) {
+    SLIC_INFO_ROOT(fmt::format("{0:<{1}} {2:>12} {3:>12} {4:>12} {5:>12}", "Timer", name_width, "Avg calls",
+                               "Min (s)", "Avg (s)", "Max (s)"));
+    for (std::size_t i = 0; i < timer_names.size(); i++) {
+      SLIC_INFO_ROOT(fmt::format("{0:<{1}} {2:>12.0f} {3:>12.6f} {4:>12.6f} {5:>12.6f}", timer_names[i], name_width,
+                                 timer_calls[i].avg, timer_seconds[i].min, timer_seconds[i].avg,
+                                 timer_seconds[i].max));
+    }
+  }
+  if (!counter_names.empty()) {
+    SLIC_INFO_ROOT(fmt::format("{0:<{1}} {2:>12} {3:>12} {4:>12}", "Counter", name_width, "Min", "Avg", "Max"));
+    for (std::size_t i = 0; i < counter_names.size(); i++) {
+      SLIC_INFO_ROOT(fmt::format("{0:<{1}} {2:>12.0f} {3:>12.1f} {4:>12.0f}", counter_names[i], name_width,
+                                 counter_values[i].min, counter_values[i].avg, counter_values[i].max));
+    }
+  }
+}
+
+double streamBandwidth(MPI_Comm comm, std::size_t size)
+{
+  std::vector<double> a(size, 0.0), b(size, 1.0), c(size, 2.0);
+  constexpr double    scalar = 3.0;
+
+  // The best of several repetitions, the first of which also faults in the pages
+  constexpr int repetitions = 5;
+  double        best        = std::numeric_limits<double>::max();
+  for (int r = 0; r < repetitions; r++) {
+    MPI_Barrier(comm);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < size; i++) {
+      a[i] = b[i] + scalar * c[i];
+    }
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  SLIC_ERROR_IF(a[size / 2] != b[size / 2] + scalar * c[size / 2], "STREAM triad gave the wrong result");
+
+  // Two arrays are read and one is written, as counted by STREAM
+  double local = 3.0 * sizeof(double) * static_cast<double>(size) / best;
+  double total = 0.0;
+  MPI_Allreduce(&local, &total, 1, MPI_DOUBLE, MPI_SUM, comm);
+  return total;
+}
+
+void reportKernelPerformance(const std::string& title, const std::vector<KernelPerformance>& kernels,
+                             double stream_bandwidth, MPI_Comm comm)
+{
+  const auto          count = static_cast<int>(kernels.size());
+  std::vector<double> work(2 * kernels.size()), seconds(kernels.size());
+  for (std::size_t i = 0; i < kernels.size(); i++) {
+    work[2 * i]     = kernels[i].cost.bytes * static_cast<double>(kernels[i].calls);
+    work[2 * i + 1] = kernels[i].cost.flops * static_cast<double>(kernels[i].calls);
+    seconds[i]      = kernels[i].seconds;
+  }
+  std::vector<double> total_work(work.size()), max_seconds(seconds.size());
+  MPI_Allreduce(work.data(), total_work.data(), 2 * count, MPI_DOUBLE, MPI_SUM, comm);
+  MPI_Allreduce(seconds.data(), max_seconds.data(), count, MPI_DOUBLE, MPI_MAX, comm);
+
+  std::size_t name_width = title.size();
+  for (const auto& kernel : kernels) {
+    name_width = std::max(name_width, kernel.name.size());
+  }
+
+  const bool has_stream = stream_bandwidth > 0.0;
+
+  auto header = fmt::format("{0:<{1}} {2:>10} {3:>12} {4:>12} {5:>12} {6:>12}", title, name_width, "Calls", "Max (s)",
+                            "Flops/byte", "GB/s", "GFLOP/s");
+  if (has_stream) {
+    header += fmt::format(" {0:>12}", "% of STREAM");
+  }
+  SLIC_INFO_ROOT(header);
+
+  for (std::size_t i = 0; i < kernels.size(); i++) {
+    const double bytes     = total_work[2 * i];
+    const double flops     = total_work[2 * i + 1];
+    const double time      = max_seconds[i];
+    const double bandwidth = (time > 0.0) ? bytes / time : 0.0;
+    const double flop_rate = (time > 0.0) ? flops / time : 0.0;
+
+    auto row = fmt::format("{0:<{1}} {2:>10} {3:>12.6f} {4:>12.3f} {5:>12.3f} {6:>12.3f}", kernels[i].name, name_width,
+                           kernels[i].calls, time, (bytes > 0.0) ? flops / bytes : 0.0, bandwidth * 1.0e-9,
+                           flop_rate * 1.0e-9);
+    if (has_stream) {
+      row += fmt::format(" {0:>12.1f}", 100.0 * bandwidth / stream_bandwidth);
+    }
+    SLIC_INFO_ROOT(row);
+  }
+  if (has_stream) {
+    SLIC_INFO_ROOT(fmt::format("STREAM triad bandwidth: {0:.3f} GB/s", stream_bandwidth * 1.0e-9));
+  }
+}
+
 /// @cond
 namespace detail {
 void setCaliperMetadata([[maybe_unused]] const std::string& name, [[maybe_unused]] double data)
@@ -94,6 +337,77 @@ void endCaliperRegion([[maybe_unused]] const char* name)
 #endif
 }
 
+void startRegion(const char* name)
+{
+  startCaliperRegion(name);
+  regionsNamed(name).starts.push_back(std::chrono::steady_clock::now());
+}
+
+void endRegion(const char* name)
+{
+  const auto end    = std::chrono::steady_clock::now();
+  auto&      named  = regionsNamed(name);
+  auto&      starts = named.starts;
+  SLIC_ERROR_IF(starts.empty(), fmt::format("Region '{0}' was ended but not started", name));
+  named.record->nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(end - starts.back()).count();
+  named.record->calls++;
+  starts.pop_back();
+  endCaliperRegion(name);
+}
+
+std::vector<std::string> allNames(const std::map<std::string, double>& local, MPI_Comm comm)
+{
+  std::string packed;
+  for (const auto& [name, _] : local) {
+    packed += name;
+    packed += '\0';
+  }
+
+  int num_ranks = 0;
+  MPI_Comm_size(comm, &num_ranks);
+  int              length = static_cast<int>(packed.size());
+  std::vector<int> lengths(static_cast<std::size_t>(num_ranks));
+  std::vector<int> offsets(static_cast<std::size_t>(num_ranks), 0);
+  MPI_Allgather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, comm);
+  std::partial_sum(lengths.begin(), lengths.end() - 1, offsets.begin() + 1);
+
+  std::vector<char> gathered(static_cast<std::size_t>(offsets.back() + lengths.back()));
+  MPI_Allgatherv(packed.data(), length, MPI_CHAR, gathered.data(), lengths.data(), offsets.data(), MPI_CHAR, comm);
+
+  std::set<std::string> names;
+  for (auto begin = gathered.begin(); begin != gathered.end();) {
+    auto end = std::find(begin, gathered.end(), '\0');
+    names.emplace(begin, end);
+    begin = end + 1;
+  }
+  return {names.begin(), names.end()};
+}
+
+std::vector<Statistics> reduce(const std::vector<std::string>& names, const std::map<std::string, double>& local,
+                               MPI_Comm comm)
+{
+  std::vector<double> values(names.size(), 0.0);
+  for (std::size_t i = 0; i < names.size(); i++) {
+    if (auto value = local.find(names[i]); value != local.end()) {
+      values[i] = value->second;
+    }
+  }
+
+  const int           count = static_cast<int>(values.size());
+  std::vector<double> min(values.size()), sum(values.size()), max(values.size());
+  MPI_Allreduce(values.data(), min.data(), count, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(values.data(), sum.data(), count, MPI_DOUBLE, MPI_SUM, comm);
+  MPI_Allreduce(values.data(), max.data(), count, MPI_DOUBLE, MPI_MAX, comm);
+
+  int num_ranks = 0;
+  MPI_Comm_size(comm, &num_ranks);
+  std::vector<Statistics> statistics(values.size());
+  for (std::size_t i = 0; i < values.size(); i++) {
+    statistics[i] = {min[i], sum[i] / num_ranks, max[i]};
+  }
+  return statistics;
+}
+
 }  // namespace detail
    /// @endcond
 }  // namespace serac::profiling
@@ -7,13 +7,20 @@
 /**
  * @file profiling.hpp
  *
- * @brief Various helper functions and macros for profiling using Caliper
+ * @brief Various helper functions and macros for profiling using Caliper and built-in timers and counters
  */
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <vector>
+
+#include "mpi.h"
 
 #include "serac/serac_config.hpp"
 
@@ -24,7 +31,7 @@
 
 /**
  * @def SERAC_MARK_FUNCTION
- * Marks a function for Caliper profiling
+ * Marks a function for Caliper profiling and times it with the built-in timers
  */
 
 /**
@@ -44,12 +51,12 @@
 
 /**
  * @def SERAC_MARK_START(id)
- * Marks the start of a region Caliper profiling
+ * Marks the start of a region for Caliper profiling and the built-in timers
  */
 
 /**
  * @def SERAC_MARK_END(id)
- * Marks the end of a region Caliper profiling
+ * Marks the end of a region for Caliper profiling and the built-in timers
  */
 
 /**
@@ -59,12 +66,12 @@
 
 /**
  * @def SERAC_PROFILE_SCOPE(name)
- * Uses cali::ScopeAnnotation to profile a particular scope
+ * Uses cali::ScopeAnnotation and a built-in timer to profile a particular scope
  */
 
 /**
  * @def SERAC_PROFILE_EXPR(name, expr)
- * Profiles a single expression using a cali::ScopeAnnotation internally. Returns evaluation.
+ * Profiles a single expression using a cali::ScopeAnnotation and a built-in timer internally. Returns evaluation.
  */
 
 /**
@@ -72,45 +79,66 @@
  * Profiles an expression several times. Returns the last evaluation
  */
 
+#define SERAC_CONCAT_(a, b) a##b
+#define SERAC_CONCAT(a, b) SERAC_CONCAT_(a, b)
+
 #ifdef SERAC_USE_CALIPER
 
-#define SERAC_MARK_FUNCTION CALI_CXX_MARK_FUNCTION
 #define SERAC_MARK_LOOP_START(id, name) CALI_CXX_MARK_LOOP_BEGIN(id, name)
 #define SERAC_MARK_LOOP_ITER(id, i) CALI_CXX_MARK_LOOP_ITERATION(id, i)
 #define SERAC_MARK_LOOP_END(id) CALI_CXX_MARK_LOOP_END(id)
-#define SERAC_MARK_START(name) serac::profiling::detail::startCaliperRegion(name)
-#define SERAC_MARK_END(name) serac::profiling::detail::endCaliperRegion(name)
 #define SERAC_SET_METADATA(name, data) serac::profiling::detail::setCaliperMetadata(name, data)
 
-#define SERAC_CONCAT_(a, b) a##b
-#define SERAC_CONCAT(a, b) SERAC_CONCAT_(a, b)
+#define SERAC_CALIPER_MARK_FUNCTION CALI_CXX_MARK_FUNCTION
+#define SERAC_CALIPER_SCOPE(name) \
+  const cali::ScopeAnnotation SERAC_CONCAT(region, __LINE__)(serac::profiling::detail::make_cstr(name))
 
-namespace serac::profiling::detail {
+#else  // SERAC_USE_CALIPER not defined
 
-/**
- * @brief Guarantees str is a c string
- */
-inline const char* make_cstr(const char* str) { return str; }
+// Define all these as nothing so annotated code will still compile
+#define SERAC_MARK_LOOP_START(id, name)
+#define SERAC_MARK_LOOP_ITER(id, i)
+#define SERAC_MARK_LOOP_END(id)
+#define SERAC_SET_METADATA(name, data)
 
-/**
- * @brief Converts a std::string into a c string
- */
-inline const char* make_cstr(const std::string& str) { return str.c_str(); }
+#define SERAC_CALIPER_MARK_FUNCTION static_cast<void>(0)
+#define SERAC_CALIPER_SCOPE(name) static_cast<void>(0)
 
-}  // namespace serac::profiling::detail
+#endif
+
+// The built-in timer of a function is named by its full signature, so that overloads and instantiations of a
+// template are timed separately
+#if defined(__GNUC__)
+#define SERAC_FUNCTION_SIGNATURE __PRETTY_FUNCTION__
+#elif defined(_MSC_VER)
+#define SERAC_FUNCTION_SIGNATURE __FUNCSIG__
+#else
+#define SERAC_FUNCTION_SIGNATURE __func__
+#endif
+
+// The built-in timers are always enabled. The timer of a function is looked up once, so marking a function only
+// costs two reads of the clock and two atomic additions per call
+#define SERAC_MARK_FUNCTION                                                    \
+  SERAC_CALIPER_MARK_FUNCTION;                                                 \
+  static serac::profiling::TimerRecord& SERAC_CONCAT(timer_record, __LINE__) = \
+      serac::profiling::timer(SERAC_FUNCTION_SIGNATURE);                       \
+  const serac::profiling::ScopedTimer   SERAC_CONCAT(timer, __LINE__)(SERAC_CONCAT(timer_record, __LINE__))
+#define SERAC_MARK_START(name) serac::profiling::detail::startRegion(name)
+#define SERAC_MARK_END(name) serac::profiling::detail::endRegion(name)
 
 #define SERAC_PROFILE_SCOPE(name) \
-  cali::ScopeAnnotation SERAC_CONCAT(region, __LINE__)(serac::profiling::detail::make_cstr(name))
+  SERAC_CALIPER_SCOPE(name);      \
+  const serac::profiling::ScopedTimer SERAC_CONCAT(timer, __LINE__)(serac::profiling::detail::make_cstr(name))
 
 // We use decltype(auto) here instead of the default auto for a different set of type deduction rules -
 // the latter uses template type deduction rules but the former uses those for decltype, which we need
 // in order for the return type to take into account the value category (rvalue, lvalue) of the expression
 // We have to return (expr) instead of expr to ensure that reference-ness is propagated through correctly
 // in Clang - GCC handles this correctly without the parentheses as expected
-#define SERAC_PROFILE_EXPR(name, expr)                                                                     \
-  [&]() -> decltype(auto) {                                                                                \
-    const cali::ScopeAnnotation SERAC_CONCAT(region, __LINE__)(serac::profiling::detail::make_cstr(name)); \
-    return (expr);                                                                                         \
+#define SERAC_PROFILE_EXPR(name, expr) \
+  [&]() -> decltype(auto) {            \
+    SERAC_PROFILE_SCOPE(name);         \
+    return (expr);                     \
   }()
 
 /**
@@ -124,22 +152,6 @@ inline const char* make_cstr(const std::string& str) { return str.c_str(); }
       }(),                                                                                                          \
       SERAC_PROFILE_EXPR(serac::profiling::detail::make_cstr(name), expr))
 
-#else  // SERAC_USE_CALIPER not defined
-
-// Define all these as nothing so annotated code will still compile
-#define SERAC_MARK_FUNCTION
-#define SERAC_MARK_LOOP_START(id, name)
-#define SERAC_MARK_LOOP_ITER(id, i)
-#define SERAC_MARK_LOOP_END(id)
-#define SERAC_MARK_START(name)
-#define SERAC_MARK_END(name)
-#define SERAC_SET_METADATA(name, data)
-#define SERAC_PROFILE_SCOPE(name)
-#define SERAC_PROFILE_EXPR(name, expr) expr
-#define SERAC_PROFILE_EXPR_LOOP(name, expr, ntest) expr
-
-#endif
-
 /// profiling namespace
 namespace serac::profiling {
 
@@ -155,8 +167,190 @@ void initializeCaliper(const std::string& options = "");
  */
 void terminateCaliper();
 
+/**
+ * @brief The accumulated wall time and number of calls of a built-in timer
+ */
+struct TimerRecord {
+  /**
+   * @brief The accumulated wall time in nanoseconds
+   */
+  std::atomic<long long> nanoseconds{0};
+
+  /**
+   * @brief The number of times the timer was stopped
+   */
+  std::atomic<long long> calls{0};
+};
+
+/**
+ * @brief A built-in counter, e.g. of solver iterations
+ */
+using Counter = std::atomic<long long>;
+
+/**
+ * @brief Returns the built-in timer with the given name, creating it on first use
+ *
+ * @param[in] name The name of the timer
+ * @note The returned reference remains valid for the lifetime of the program, so call sites may cache it. Each thread
+ * also caches the timers it has looked up, so only its first lookup of a name takes the lock of the registry.
+ */
+TimerRecord& timer(std::string_view name);
+
+/**
+ * @brief Returns the built-in counter with the given name, creating it on first use
+ *
+ * @param[in] name The name of the counter
+ * @note The returned reference remains valid for the lifetime of the program, so call sites may cache it. Each thread
+ * also caches the counters it has looked up, so only its first lookup of a name takes the lock of the registry.
+ */
+Counter& counter(std::string_view name);
+
+/**
+ * @brief Zeros all built-in timers and counters
+ */
+void resetTimersAndCounters();
+
+/**
+ * @brief Logs the built-in timers and counters with their minimum, average, and maximum over the ranks of a
+ * communicator
+ *
+ * @param[in] comm The communicator to aggregate over, this is a collective operation
+ */
+void reportTimersAndCounters(MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Adds the wall time of its lifetime to a built-in timer
+ */
+class ScopedTimer {
+public:
+  /**
+   * @brief Starts timing
+   *
+   * @param[in] record The timer to add to
+   */
+  explicit ScopedTimer(TimerRecord& record) : record_(record), start_(std::chrono::steady_clock::now()) {}
+
+  /**
+   * @brief Starts timing
+   *
+   * @param[in] name The name of the timer to add to
+   */
+  explicit ScopedTimer(std::string_view name) : ScopedTimer(timer(name)) {}
+
+  /**
+   * @brief Stops timing and adds the elapsed time to the timer
+   */
+  ~ScopedTimer()
+  {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    record_.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    record_.calls++;
+  }
+
+  /**
+   * @brief A timer measures a single scope, so it cannot be copied
+   */
+  ScopedTimer(const ScopedTimer&) = delete;
+
+  /**
+   * @brief A timer measures a single scope, so it cannot be copied
+   */
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  /**
+   * @brief The timer to add to
+   */
+  TimerRecord& record_;
+
+  /**
+   * @brief The time at construction
+   */
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief The memory traffic and floating point work of one call of a kernel, from an analytic model of the kernel
+ */
+struct KernelCost {
+  /**
+   * @brief The bytes read from and written to main memory
+   */
+  double bytes = 0.0;
+
+  /**
+   * @brief The floating point operations
+   */
+  double flops = 0.0;
+
+  /**
+   * @brief Returns the floating point operations per byte
+   */
+  double arithmeticIntensity() const { return (bytes > 0.0) ? flops / bytes : 0.0; }
+};
+
+/**
+ * @brief The cost of a kernel and the time spent in it
+ */
+struct KernelPerformance {
+  /**
+   * @brief The name of the kernel
+   */
+  std::string name;
+
+  /**
+   * @brief The cost of a single call
+   */
+  KernelCost cost;
+
+  /**
+   * @brief The number of calls
+   */
+  long long calls = 0;
+
+  /**
+   * @brief The wall time of all of the calls
+   */
+  double seconds = 0.0;
+};
+
+/**
+ * @brief Measures the memory bandwidth of a STREAM triad, a[i] = b[i] + s * c[i], run by all of the ranks of a
+ * communicator at once
+ *
+ * @param[in] comm The communicator, this is a collective operation
+ * @param[in] size The number of doubles in each array, which should be well beyond the size of the caches
+ * @return The bandwidth summed over the ranks, in bytes per second
+ */
+double streamBandwidth(MPI_Comm comm = MPI_COMM_WORLD, std::size_t size = std::size_t{1} << 23);
+
+/**
+ * @brief Logs the arithmetic intensity, achieved bandwidth, and achieved flop rate of each kernel
+ *
+ * The bytes and flops are summed over the ranks and divided by the longest time of any rank.
+ *
+ * @param[in] title The title of the table
+ * @param[in] kernels The kernels, in the same order on every rank
+ * @param[in] stream_bandwidth The bandwidth measured by streamBandwidth, if positive the achieved bandwidth is also
+ * reported as a fraction of it
+ * @param[in] comm The communicator to aggregate over, this is a collective operation
+ */
+void reportKernelPerformance(const std::string& title, const std::vector<KernelPerformance>& kernels,
+                             double stream_bandwidth = 0.0, MPI_Comm comm = MPI_COMM_WORLD);
+
 /// detail namespace
 namespace detail {
+
+/**
+ * @brief Guarantees str is a c string
+ */
+inline const char* make_cstr(const char* str) { return str; }
+
+/**
+ * @brief Converts a std::string into a c string
+ */
+inline const char* make_cstr(const std::string& str) { return str.c_str(); }
+
 /**
  * @brief Caliper metadata methods cali_set_global_<double|int|string|uint>_byname()
  *
@@ -194,6 +388,59 @@ void startCaliperRegion(const char* name);
  */
 void endCaliperRegion(const char* name);
 
+/**
+ * @brief Marks the start of a region for Caliper and the built-in timer of the same name
+ *
+ * @param[in] name The tag to associate with the region.
+ * @note Regions with the same name may be nested, but must be ended on the thread that started them
+ */
+void startRegion(const char* name);
+
+/**
+ * @brief Marks the end of a region started with startRegion
+ *
+ * @param[in] name The tag to associate with the region.
+ */
+void endRegion(const char* name);
+
+/**
+ * @brief The statistics of a quantity over the ranks of a communicator
+ */
+struct Statistics {
+  /**
+   * @brief The minimum over the ranks
+   */
+  double min;
+
+  /**
+   * @brief The average over the ranks
+   */
+  double avg;
+
+  /**
+   * @brief The maximum over the ranks
+   */
+  double max;
+};
+
+/**
+ * @brief Returns the union of the names on all ranks, sorted so that it is the same on every rank
+ *
+ * @param[in] local The values on this rank by name
+ * @param[in] comm The communicator to gather over, this is a collective operation
+ */
+std::vector<std::string> allNames(const std::map<std::string, double>& local, MPI_Comm comm);
+
+/**
+ * @brief Returns the statistics of each named value over the ranks, a value that is missing on a rank counts as zero
+ *
+ * @param[in] names The names of the values, the same on every rank
+ * @param[in] local The values on this rank by name
+ * @param[in] comm The communicator to reduce over, this is a collective operation
+ */
+std::vector<Statistics> reduce(const std::vector<std::string>& names, const std::map<std::string, double>& local,
+                               MPI_Comm comm);
+
 }  // namespace detail
 
 /// Produces a string by applying << to all arguments
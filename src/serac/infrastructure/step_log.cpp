@@ -0,0 +1,130 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/step_log.hpp"
+
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::profiling {
+
+namespace {
+
+/**
+ * @brief The logged timers, by field name and timer name
+ */
+constexpr std::array<std::pair<const char*, const char*>, 4> PHASES = {
+    {{"assembly_time", "Assembly"},
+     {"linear_solver_setup_time", "Linear solver setup"},
+     {"linear_solve_time", "Linear solve"},
+     {"output_time", "Output"}}};
+
+/**
+ * @brief The logged counters, by field name and counter name
+ */
+constexpr std::array<std::pair<const char*, const char*>, 2> COUNTERS = {
+    {{"newton_iterations", "Newton iterations"}, {"krylov_iterations", "Krylov iterations"}}};
+
+/**
+ * @brief Formats a number for a JSON value, which has no representation of infinities and NaNs
+ * @param[in] value The number to format
+ */
+std::string jsonNumber(const double value) { return std::isfinite(value) ? fmt::format("{0}", value) : "null"; }
+
+}  // namespace
+
+StepLog::StepLog(const std::string& file_name, MPI_Comm comm) : comm_(comm), start_values_(measure())
+{
+  const std::string extension = ".csv";
+  const bool        is_csv    = file_name.size() >= extension.size() &&
+                      file_name.compare(file_name.size() - extension.size(), extension.size(), extension) == 0;
+  format_ = is_csv ? Format::CSV : Format::JSONLines;
+
+  int rank = 0;
+  MPI_Comm_rank(comm_, &rank);
+  if (rank != 0) {
+    return;
+  }
+
+  file_.open(file_name);
+  SLIC_ERROR_IF(!file_, fmt::format("Could not open performance log '{0}'", file_name));
+  if (format_ == Format::CSV) {
+    file_ << "step,time,dt,converged,wall_time";
+    for (const auto& [field, _] : PHASES) {
+      file_ << ',' << field;
+    }
+    for (const auto& [field, _] : COUNTERS) {
+      file_ << ',' << field;
+    }
+    file_ << ",nonlinear_residual_norm,linear_residual_norm,peak_memory_bytes" << std::endl;
+  }
+}
+
+std::vector<double> StepLog::measure() const
+{
+  std::vector<double> values;
+  for (const auto& [_, name] : PHASES) {
+    values.push_back(static_cast<double>(timer(name).nanoseconds) / 1.0e9);
+  }
+  for (const auto& [_, name] : COUNTERS) {
+    values.push_back(static_cast<double>(counter(name)));
+  }
+  return values;
+}
+
+void StepLog::beginStep()
+{
+  start_        = std::chrono::steady_clock::now();
+  start_values_ = measure();
+}
+
+void StepLog::endStep(const StepRecord& record)
+{
+  // The changes over the timestep, followed by the wall time and the memory high-water mark
+  auto values = measure();
+  for (std::size_t i = 0; i < values.size(); i++) {
+    values[i] -= start_values_[i];
+  }
+  values.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count());
+  values.push_back(static_cast<double>(memory::peakResidentBytes()));
+
+  std::vector<double> max(values.size());
+  MPI_Reduce(values.data(), max.data(), static_cast<int>(values.size()), MPI_DOUBLE, MPI_MAX, 0, comm_);
+  if (!file_.is_open()) {
+    return;
+  }
+
+  const double wall_time   = max[PHASES.size() + COUNTERS.size()];
+  const double peak_memory = max.back();
+  if (format_ == Format::CSV) {
+    file_ << fmt::format("{0},{1},{2},{3},{4}", record.cycle, record.time, record.dt, int(record.converged), wall_time);
+    for (std::size_t i = 0; i < PHASES.size() + COUNTERS.size(); i++) {
+      file_ << fmt::format(",{0}", max[i]);
+    }
+    file_ << fmt::format(",{0},{1},{2}", record.nonlinear_residual_norm, record.linear_residual_norm, peak_memory)
+          << std::endl;
+  } else {
+    file_ << fmt::format("{{\"step\": {0}, \"time\": {1}, \"dt\": {2}, \"converged\": {3}, \"wall_time\": {4}",
+                         record.cycle, record.time, record.dt, record.converged ? "true" : "false", wall_time);
+    for (std::size_t i = 0; i < PHASES.size(); i++) {
+      file_ << fmt::format(", \"{0}\": {1}", PHASES[i].first, max[i]);
+    }
+    for (std::size_t i = 0; i < COUNTERS.size(); i++) {
+      file_ << fmt::format(", \"{0}\": {1}", COUNTERS[i].first, max[PHASES.size() + i]);
+    }
+    file_ << fmt::format(
+                 ", \"nonlinear_residual_norm\": {0}, \"linear_residual_norm\": {1}, \"peak_memory_bytes\": {2}}}",
+                 jsonNumber(record.nonlinear_residual_norm), jsonNumber(record.linear_residual_norm), peak_memory)
+          << std::endl;
+  }
+}
+
+}  // namespace serac::profiling
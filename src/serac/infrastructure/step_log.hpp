@@ -0,0 +1,136 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file step_log.hpp
+ *
+ * @brief A machine-readable log of the performance of each timestep
+ */
+
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mpi.h"
+
+namespace serac::profiling {
+
+/**
+ * @brief The quantities of a timestep that are known to the caller rather than to the built-in timers and counters
+ */
+struct StepRecord {
+  /**
+   * @brief The cycle of the timestep
+   */
+  int cycle;
+
+  /**
+   * @brief The simulation time at the end of the timestep
+   */
+  double time;
+
+  /**
+   * @brief The size of the timestep
+   */
+  double dt;
+
+  /**
+   * @brief Whether the nonlinear solves of the timestep converged
+   */
+  bool converged;
+
+  /**
+   * @brief The final norm of the nonlinear residual
+   */
+  double nonlinear_residual_norm;
+
+  /**
+   * @brief The final residual norm of the last linear solve
+   */
+  double linear_residual_norm;
+};
+
+/**
+ * @brief Writes one record per timestep with the wall time of each phase, the solver iterations, the residual norms,
+ * and the memory high-water mark
+ *
+ * The phases are the built-in timers "Assembly", "Linear solver setup", "Linear solve", and "Output", and the
+ * iterations are the built-in counters "Newton iterations" and "Krylov iterations", see profiling.hpp. The values of
+ * a record are the changes over the timestep. Wall times and memory are the maximum over the ranks, and the record is
+ * written by rank 0. Each record is flushed as it is written, so the log can be followed while the simulation runs.
+ */
+class StepLog {
+public:
+  /**
+   * @brief The file formats of the log
+   */
+  enum class Format
+  {
+    JSONLines, /**< One JSON object per line */
+    CSV        /**< A header line followed by one line of comma-separated values per timestep */
+  };
+
+  /**
+   * @brief Creates the log file
+   *
+   * @param[in] file_name The name of the file, which is written as CSV if it ends in ".csv" and as JSON Lines otherwise
+   * @param[in] comm The communicator of the simulation
+   */
+  StepLog(const std::string& file_name, MPI_Comm comm = MPI_COMM_WORLD);
+
+  /**
+   * @brief Marks the start of a timestep
+   */
+  void beginStep();
+
+  /**
+   * @brief Marks the end of a timestep and writes its record, this is a collective operation
+   *
+   * @param[in] record The quantities of the timestep that are not measured by the log
+   */
+  void endStep(const StepRecord& record);
+
+  /**
+   * @brief Returns the format of the log
+   */
+  Format format() const { return format_; }
+
+private:
+  /**
+   * @brief Returns the current values of the timers and counters that are logged
+   */
+  std::vector<double> measure() const;
+
+  /**
+   * @brief The format of the log
+   */
+  Format format_;
+
+  /**
+   * @brief The communicator of the simulation
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The log file, only open on rank 0
+   */
+  std::ofstream file_;
+
+  /**
+   * @brief The wall time at the start of the current timestep
+   */
+  std::chrono::steady_clock::time_point start_;
+
+  /**
+   * @brief The values of the timers and counters at the start of the current timestep
+   */
+  std::vector<double> start_values_;
+};
+
+}  // namespace serac::profiling
@@ -11,6 +11,7 @@
 #include <iostream>
 
 #include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/async_writer.hpp"
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/profiling.hpp"
 
@@ -43,15 +44,26 @@ void registerSignals()
 
 void exitGracefully(bool error)
 {
-  if (axom::slic::isInitialized()) {
-    serac::logger::flush();
-    serac::logger::finalize();
+  // Finish writing any output that is still in flight before tearing down the logger and MPI. Waiting on the writer
+  // threads is not async-signal-safe, and an aborted run may have left them blocked, so this is skipped on errors.
+  if (!error) {
+    output::flushAsyncWriters();
   }
 
+  // The summary is collective, which is only safe on a normal exit
   int mpi_initialized = 0;
   MPI_Initialized(&mpi_initialized);
   int mpi_finalized = 0;
   MPI_Finalized(&mpi_finalized);
+  if (!error && mpi_initialized && !mpi_finalized && axom::slic::isInitialized()) {
+    profiling::reportTimersAndCounters();
+  }
+
+  if (axom::slic::isInitialized()) {
+    serac::logger::flush();
+    serac::logger::finalize();
+  }
+
   if (mpi_initialized && !mpi_finalized) {
     MPI_Finalize();
   }
@@ -37,7 +37,9 @@ void registerSignals();
  * @brief Exits the program gracefully after cleaning up necessary tasks.
  *
  * This performs finalization work needed by the program such as finalizing MPI
- * and flushing and closing the SLIC logger.
+ * and flushing and closing the SLIC logger. On a normal exit, the pending asynchronous
+ * output is written and the built-in timers and counters are logged first. Neither is
+ * done on an error exit, which may be called from a signal handler.
  *
  * @param[in] error True if the program should return an error code
  */
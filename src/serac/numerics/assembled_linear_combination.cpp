@@ -0,0 +1,194 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/assembled_linear_combination.hpp"
+
+#include <algorithm>
+
+#include "_hypre_parcsr_mv.h"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/numerics/sparsity_hash.hpp"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief Returns the diagonal block of a parallel matrix
+ * @param[in] matrix The matrix
+ */
+hypre_CSRMatrix* diag(const mfem::HypreParMatrix& matrix)
+{
+  return hypre_ParCSRMatrixDiag(static_cast<hypre_ParCSRMatrix*>(matrix));
+}
+
+/**
+ * @brief Returns the off-diagonal block of a parallel matrix
+ * @param[in] matrix The matrix
+ */
+hypre_CSRMatrix* offd(const mfem::HypreParMatrix& matrix)
+{
+  return hypre_ParCSRMatrixOffd(static_cast<hypre_ParCSRMatrix*>(matrix));
+}
+
+/**
+ * @brief Computes the position in a block of the combination of every nonzero of the same block of a summand
+ *
+ * @param[in] summand The block of the summand
+ * @param[in] combination The block of the combination, whose sparsity contains that of the summand
+ * @param[in] columns The column in the combination of each column of the summand
+ * @param[out] positions The position of each nonzero of the summand
+ */
+void mapBlock(hypre_CSRMatrix* summand, hypre_CSRMatrix* combination, const std::vector<HYPRE_Int>& columns,
+              std::vector<HYPRE_Int>& positions)
+{
+  const HYPRE_Int* summand_rows     = hypre_CSRMatrixI(summand);
+  const HYPRE_Int* summand_cols     = hypre_CSRMatrixJ(summand);
+  const HYPRE_Int* combination_rows = hypre_CSRMatrixI(combination);
+  const HYPRE_Int* combination_cols = hypre_CSRMatrixJ(combination);
+
+  positions.resize(static_cast<std::size_t>(hypre_CSRMatrixNumNonzeros(summand)));
+
+  // The position of each column of the current row of the combination, so a row is mapped in linear time
+  std::vector<HYPRE_Int> position_of(static_cast<std::size_t>(hypre_CSRMatrixNumCols(combination)), -1);
+  for (HYPRE_Int row = 0; row < hypre_CSRMatrixNumRows(summand); row++) {
+    for (HYPRE_Int k = combination_rows[row]; k < combination_rows[row + 1]; k++) {
+      position_of[static_cast<std::size_t>(combination_cols[k])] = k;
+    }
+    for (HYPRE_Int k = summand_rows[row]; k < summand_rows[row + 1]; k++) {
+      const auto position = position_of[static_cast<std::size_t>(columns[static_cast<std::size_t>(summand_cols[k])])];
+      SLIC_ERROR_IF(position < 0, "A summand has a nonzero outside of the sparsity of the linear combination");
+      positions[static_cast<std::size_t>(k)] = position;
+    }
+    for (HYPRE_Int k = combination_rows[row]; k < combination_rows[row + 1]; k++) {
+      position_of[static_cast<std::size_t>(combination_cols[k])] = -1;
+    }
+  }
+}
+
+/**
+ * @brief Adds a multiple of the values of a block of a summand to the combination
+ *
+ * @param[in] coefficient The coefficient of the summand
+ * @param[in] summand The block of the summand
+ * @param[in] positions The position of each nonzero of the summand in the combination
+ * @param[inout] combination The values of the block of the combination
+ */
+void addBlock(const double coefficient, hypre_CSRMatrix* summand, const std::vector<HYPRE_Int>& positions,
+              HYPRE_Complex* combination)
+{
+  const HYPRE_Complex* values   = hypre_CSRMatrixData(summand);
+  const auto           nonzeros = positions.size();
+  for (std::size_t k = 0; k < nonzeros; k++) {
+    combination[positions[k]] += coefficient * values[k];
+  }
+}
+
+}  // namespace
+
+mfem::HypreParMatrix& AssembledLinearCombination::update(
+    std::initializer_list<double> coefficients, std::initializer_list<const mfem::HypreParMatrix*> summands)
+{
+  SLIC_ERROR_IF(coefficients.size() != summands.size() || summands.size() == 0,
+                "A linear combination needs one coefficient for each of at least one summand");
+
+  if (!combination_ || !matchesSparsity(summands)) {
+    computeSparsity(summands);
+  }
+
+  auto* combination_diag = hypre_CSRMatrixData(diag(*combination_));
+  auto* combination_offd = hypre_CSRMatrixData(offd(*combination_));
+  std::fill_n(combination_diag, hypre_CSRMatrixNumNonzeros(diag(*combination_)), 0.0);
+  std::fill_n(combination_offd, hypre_CSRMatrixNumNonzeros(offd(*combination_)), 0.0);
+
+  auto coefficient = coefficients.begin();
+  auto map         = maps_.begin();
+  for (const auto* summand : summands) {
+    addBlock(*coefficient, diag(*summand), map->diag, combination_diag);
+    addBlock(*coefficient, offd(*summand), map->offd, combination_offd);
+    ++coefficient;
+    ++map;
+  }
+  return *combination_;
+}
+
+MemoryUsage AssembledLinearCombination::memoryUsage() const
+{
+  MemoryUsage usage;
+  if (combination_) {
+    usage.add("combination", memory::bytes(*combination_));
+  }
+  for (const auto& map : maps_) {
+    usage.add("summand maps", (map.diag.capacity() + map.offd.capacity()) * sizeof(HYPRE_Int));
+  }
+  return usage;
+}
+
+void AssembledLinearCombination::computeSparsity(std::initializer_list<const mfem::HypreParMatrix*> summands)
+{
+  SLIC_DEBUG("Computing the sparsity of a linear combination of " << summands.size() << " matrices");
+
+  // The sum of the summands has the union of their sparsities, only its structure is kept
+  auto summand = summands.begin();
+  combination_ = std::make_unique<mfem::HypreParMatrix>(**summand);
+  for (++summand; summand != summands.end(); ++summand) {
+    combination_.reset(mfem::Add(1.0, *combination_, 1.0, **summand));
+  }
+
+  const auto*     combination_col_map  = hypre_ParCSRMatrixColMapOffd(static_cast<hypre_ParCSRMatrix*>(*combination_));
+  const HYPRE_Int combination_offd_end = hypre_CSRMatrixNumCols(offd(*combination_));
+
+  maps_.clear();
+  maps_.reserve(summands.size());
+  for (const auto* matrix : summands) {
+    SummandMap map;
+    map.sparsity_hash = sparsityHash(*matrix);
+
+    // The diagonal blocks share their local column numbering
+    std::vector<HYPRE_Int> diag_columns(static_cast<std::size_t>(hypre_CSRMatrixNumCols(diag(*matrix))));
+    for (std::size_t column = 0; column < diag_columns.size(); column++) {
+      diag_columns[column] = static_cast<HYPRE_Int>(column);
+    }
+    mapBlock(diag(*matrix), diag(*combination_), diag_columns, map.diag);
+
+    // The off-diagonal blocks number their columns by their own sorted lists of global columns
+    const auto* col_map = hypre_ParCSRMatrixColMapOffd(static_cast<hypre_ParCSRMatrix*>(*matrix));
+    map.offd_columns    = hypre_CSRMatrixNumCols(offd(*matrix));
+    std::vector<HYPRE_Int> offd_columns(static_cast<std::size_t>(map.offd_columns));
+    for (std::size_t column = 0; column < offd_columns.size(); column++) {
+      const auto* found = std::lower_bound(combination_col_map, combination_col_map + combination_offd_end,
+                                           col_map[column]);
+      offd_columns[column] = static_cast<HYPRE_Int>(found - combination_col_map);
+    }
+    mapBlock(offd(*matrix), offd(*combination_), offd_columns, map.offd);
+
+    maps_.push_back(std::move(map));
+  }
+}
+
+bool AssembledLinearCombination::matchesSparsity(std::initializer_list<const mfem::HypreParMatrix*> summands) const
+{
+  if (summands.size() != maps_.size()) {
+    return false;
+  }
+  auto map = maps_.begin();
+  for (const auto* summand : summands) {
+    if (static_cast<std::size_t>(hypre_CSRMatrixNumNonzeros(diag(*summand))) != map->diag.size() ||
+        static_cast<std::size_t>(hypre_CSRMatrixNumNonzeros(offd(*summand))) != map->offd.size() ||
+        hypre_CSRMatrixNumCols(offd(*summand)) != map->offd_columns) {
+      return false;
+    }
+    // The same counts can hide different columns, e.g. for a matrix of a renumbered space
+    if (sparsityHash(*summand) != map->sparsity_hash) {
+      return false;
+    }
+    ++map;
+  }
+  return true;
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,110 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file assembled_linear_combination.hpp
+ *
+ * @brief A linear combination of assembled parallel matrices whose sparsity is computed once
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/infrastructure/memory_usage.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief The matrix a0 * A0 + a1 * A1 + ... of assembled matrices that keep their sparsity between updates
+ *
+ * Jacobians like M + c1 * C + c0 * K are rebuilt at every Newton iteration with new coefficients and a new K, but
+ * with the same sparsity. The first update computes the union of the sparsities of the summands and, for every
+ * nonzero of every summand, its position in the union. Later updates only overwrite the values of the combination in
+ * one pass over each summand, without building a new hypre matrix.
+ *
+ * The summands must share their row and column partitioning. A summand whose sparsity no longer matches the one it
+ * had when the sparsity was computed, e.g. after a mesh refinement, causes the sparsity to be computed again. The
+ * sparsity of a summand is compared by its counts and then by a hash of its row offsets and column indices.
+ */
+class AssembledLinearCombination {
+public:
+  /**
+   * @brief Computes the combination of the summands
+   *
+   * @param[in] coefficients The coefficient of each summand
+   * @param[in] summands The summands, which are only read during the call
+   * @return The combination, which stays owned by this object and is overwritten by the next update
+   */
+  mfem::HypreParMatrix& update(std::initializer_list<double>                      coefficients,
+                               std::initializer_list<const mfem::HypreParMatrix*> summands);
+
+  /**
+   * @brief Returns whether the sparsity of the combination has been computed
+   */
+  bool hasSparsity() const { return static_cast<bool>(combination_); }
+
+  /**
+   * @brief Returns the memory held by the combination and its maps from the summands
+   */
+  MemoryUsage memoryUsage() const;
+
+private:
+  /**
+   * @brief The positions of the nonzeros of one summand in the combination
+   */
+  struct SummandMap {
+    /**
+     * @brief The position in the diagonal block of the combination of each nonzero in the diagonal block
+     */
+    std::vector<HYPRE_Int> diag;
+
+    /**
+     * @brief The position in the off-diagonal block of the combination of each nonzero in the off-diagonal block
+     */
+    std::vector<HYPRE_Int> offd;
+
+    /**
+     * @brief The number of columns of the off-diagonal block of the summand
+     */
+    HYPRE_Int offd_columns;
+
+    /**
+     * @brief The hash of the sparsity of the summand
+     * @see sparsityHash
+     */
+    std::uint64_t sparsity_hash;
+  };
+
+  /**
+   * @brief Computes the sparsity of the combination and the maps of the summands into it
+   * @param[in] summands The summands
+   */
+  void computeSparsity(std::initializer_list<const mfem::HypreParMatrix*> summands);
+
+  /**
+   * @brief Returns whether the summands still have the sparsity the maps were computed for
+   * @param[in] summands The summands
+   */
+  bool matchesSparsity(std::initializer_list<const mfem::HypreParMatrix*> summands) const;
+
+  /**
+   * @brief The combination, with the union of the sparsities of the summands
+   */
+  std::unique_ptr<mfem::HypreParMatrix> combination_;
+
+  /**
+   * @brief The map of each summand into the combination
+   */
+  std::vector<SummandMap> maps_;
+};
+
+}  // namespace serac::mfem_ext
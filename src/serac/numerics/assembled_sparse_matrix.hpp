@@ -2,6 +2,8 @@
 
 #include <mfem.hpp>
 
+#include "serac/infrastructure/memory_usage.hpp"
+
 namespace serac {
 namespace mfem_ext {
 
@@ -46,6 +48,17 @@ public:
     return RAP(test_fes_.Dof_TrueDof_Matrix(), hypre_A.release(), trial_fes_.Dof_TrueDof_Matrix());
   }
 
+  /**
+   * @brief Returns the memory held by the matrix and its map from element matrix entries
+   */
+  MemoryUsage memoryUsage() const
+  {
+    MemoryUsage usage;
+    usage.add("CSR", memory::bytes(static_cast<const mfem::SparseMatrix&>(*this)));
+    usage.add("element map", memory::bytes(ea_map_));
+    return usage;
+  }
+
 protected:
   /// Test space describing the sparsity pattern
   const mfem::ParFiniteElementSpace& test_fes_;
@@ -0,0 +1,261 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/elimination_plan.hpp"
+
+#include "_hypre_parcsr_mv.h"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/numerics/sparsity_hash.hpp"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief Sends values of local rows to the neighboring ranks that have them as off-diagonal columns
+ *
+ * @tparam T The type of the values
+ * @param[in] comm The communicator of the matrix
+ * @param[in] datatype The MPI datatype of the values
+ * @param[in] values The values of the local rows
+ * @param[in] num_sends The number of ranks to send to
+ * @param[in] send_procs The ranks to send to
+ * @param[in] send_starts The offsets of the groups of send_rows by rank
+ * @param[in] send_rows The local rows whose values are sent, grouped by rank
+ * @param[in] num_recvs The number of ranks to receive from
+ * @param[in] recv_procs The ranks to receive from
+ * @param[in] recv_starts The offsets of the values received from each rank
+ * @param[inout] sent Buffer for the values that are sent
+ * @param[out] received The received values, grouped by rank
+ */
+template <typename T>
+void exchange(MPI_Comm comm, MPI_Datatype datatype, const T* values, std::size_t num_sends,
+              const HYPRE_Int* send_procs, const HYPRE_Int* send_starts, const HYPRE_Int* send_rows,
+              std::size_t num_recvs, const HYPRE_Int* recv_procs, const HYPRE_Int* recv_starts, std::vector<T>& sent,
+              T* received)
+{
+  constexpr int tag = 0;
+
+  sent.resize(num_sends > 0 ? static_cast<std::size_t>(send_starts[num_sends]) : 0);
+  for (std::size_t i = 0; i < sent.size(); i++) {
+    sent[i] = values[send_rows[i]];
+  }
+
+  std::vector<MPI_Request> requests(num_sends + num_recvs);
+  for (std::size_t i = 0; i < num_recvs; i++) {
+    MPI_Irecv(received + recv_starts[i], recv_starts[i + 1] - recv_starts[i], datatype, recv_procs[i], tag, comm,
+              &requests[i]);
+  }
+  for (std::size_t i = 0; i < num_sends; i++) {
+    MPI_Isend(sent.data() + send_starts[i], send_starts[i + 1] - send_starts[i], datatype, send_procs[i], tag, comm,
+              &requests[num_recvs + i]);
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/**
+ * @brief Returns the diagonal block of a parallel matrix
+ * @param[in] matrix The matrix
+ */
+hypre_CSRMatrix* diag(const mfem::HypreParMatrix& matrix)
+{
+  return hypre_ParCSRMatrixDiag(static_cast<hypre_ParCSRMatrix*>(matrix));
+}
+
+/**
+ * @brief Returns the off-diagonal block of a parallel matrix
+ * @param[in] matrix The matrix
+ */
+hypre_CSRMatrix* offd(const mfem::HypreParMatrix& matrix)
+{
+  return hypre_ParCSRMatrixOffd(static_cast<hypre_ParCSRMatrix*>(matrix));
+}
+
+}  // namespace
+
+EliminationPlan::EliminationPlan(const mfem::HypreParMatrix& matrix, const mfem::Array<int>& dofs)
+    : comm_(matrix.GetComm()),
+      rows_(hypre_CSRMatrixNumRows(diag(matrix))),
+      diag_nonzeros_(hypre_CSRMatrixNumNonzeros(diag(matrix))),
+      offd_nonzeros_(hypre_CSRMatrixNumNonzeros(offd(matrix))),
+      offd_columns_(hypre_CSRMatrixNumCols(offd(matrix))),
+      sparsity_hash_(sparsityHash(matrix))
+{
+  SLIC_ERROR_IF(hypre_CSRMatrixNumCols(diag(matrix)) != rows_,
+                "Essential degrees of freedom can only be eliminated from square matrices");
+
+  std::vector<HYPRE_Int> eliminated(static_cast<std::size_t>(rows_), 0);
+  for (int i = 0; i < dofs.Size(); i++) {
+    SLIC_ERROR_IF(dofs[i] < 0 || dofs[i] >= rows_, "Essential degree of freedom " << dofs[i] << " is not local");
+    if (!eliminated[static_cast<std::size_t>(dofs[i])]) {
+      eliminated[static_cast<std::size_t>(dofs[i])] = 1;
+      dofs_.push_back(dofs[i]);
+    }
+  }
+
+  // Which of the off-diagonal columns are eliminated is only known by the ranks that own them
+  auto* parallel = static_cast<hypre_ParCSRMatrix*>(matrix);
+  if (!hypre_ParCSRMatrixCommPkg(parallel)) {
+    hypre_MatvecCommPkgCreate(parallel);
+  }
+  auto*       comm_pkg    = hypre_ParCSRMatrixCommPkg(parallel);
+  const auto  num_sends   = static_cast<std::size_t>(hypre_ParCSRCommPkgNumSends(comm_pkg));
+  const auto  num_recvs   = static_cast<std::size_t>(hypre_ParCSRCommPkgNumRecvs(comm_pkg));
+  const auto* send_procs  = hypre_ParCSRCommPkgSendProcs(comm_pkg);
+  const auto* send_starts = hypre_ParCSRCommPkgSendMapStarts(comm_pkg);
+  const auto* send_rows   = hypre_ParCSRCommPkgSendMapElmts(comm_pkg);
+  const auto* recv_procs  = hypre_ParCSRCommPkgRecvProcs(comm_pkg);
+  const auto* recv_starts = hypre_ParCSRCommPkgRecvVecStarts(comm_pkg);
+
+  std::vector<HYPRE_Int> sent;
+  std::vector<HYPRE_Int> eliminated_offd(static_cast<std::size_t>(offd_columns_), 0);
+  exchange(comm_, HYPRE_MPI_INT, eliminated.data(), num_sends, send_procs, send_starts, send_rows, num_recvs,
+           recv_procs, recv_starts, sent, eliminated_offd.data());
+
+  // Later exchanges are restricted to the eliminated values, both sides skip the others in the same order
+  send_starts_.push_back(0);
+  for (std::size_t i = 0; i < num_sends; i++) {
+    for (auto k = send_starts[i]; k < send_starts[i + 1]; k++) {
+      if (eliminated[static_cast<std::size_t>(send_rows[k])]) {
+        send_rows_.push_back(send_rows[k]);
+      }
+    }
+    if (static_cast<HYPRE_Int>(send_rows_.size()) > send_starts_.back()) {
+      send_procs_.push_back(send_procs[i]);
+      send_starts_.push_back(static_cast<HYPRE_Int>(send_rows_.size()));
+    }
+  }
+
+  // The index of each eliminated off-diagonal column among the received values
+  std::vector<HYPRE_Int> received_index(static_cast<std::size_t>(offd_columns_), -1);
+  HYPRE_Int              num_received = 0;
+  recv_starts_.push_back(0);
+  for (std::size_t i = 0; i < num_recvs; i++) {
+    for (auto column = recv_starts[i]; column < recv_starts[i + 1]; column++) {
+      if (eliminated_offd[static_cast<std::size_t>(column)]) {
+        received_index[static_cast<std::size_t>(column)] = num_received++;
+      }
+    }
+    if (num_received > recv_starts_.back()) {
+      recv_procs_.push_back(recv_procs[i]);
+      recv_starts_.push_back(num_received);
+    }
+  }
+  received_.resize(static_cast<std::size_t>(num_received));
+
+  const HYPRE_Int* diag_rows    = hypre_CSRMatrixI(diag(matrix));
+  const HYPRE_Int* diag_columns = hypre_CSRMatrixJ(diag(matrix));
+  const HYPRE_Int* offd_rows    = hypre_CSRMatrixI(offd(matrix));
+  const HYPRE_Int* offd_cols    = hypre_CSRMatrixJ(offd(matrix));
+  for (HYPRE_Int row = 0; row < rows_; row++) {
+    const bool eliminated_row = eliminated[static_cast<std::size_t>(row)];
+    bool       has_diagonal   = false;
+    for (auto k = diag_rows[row]; k < diag_rows[row + 1]; k++) {
+      const auto column = diag_columns[k];
+      if (eliminated_row) {
+        has_diagonal |= (column == row);
+        (column == row ? diag_ones_ : diag_zeros_).push_back(k);
+      } else if (eliminated[static_cast<std::size_t>(column)]) {
+        diag_zeros_.push_back(k);
+        diag_column_positions_.push_back(k);
+        diag_column_indices_.insert(diag_column_indices_.end(), {row, column});
+      }
+    }
+    SLIC_ERROR_IF(eliminated_row && !has_diagonal,
+                  "Essential degree of freedom " << row << " has no diagonal entry in the matrix");
+
+    for (auto k = offd_rows[row]; k < offd_rows[row + 1]; k++) {
+      const auto index = received_index[static_cast<std::size_t>(offd_cols[k])];
+      if (eliminated_row) {
+        offd_zeros_.push_back(k);
+      } else if (index >= 0) {
+        offd_zeros_.push_back(k);
+        offd_column_positions_.push_back(k);
+        offd_column_indices_.insert(offd_column_indices_.end(), {row, index});
+      }
+    }
+  }
+  diag_column_values_.resize(diag_column_positions_.size());
+  offd_column_values_.resize(offd_column_positions_.size());
+}
+
+bool EliminationPlan::appliesTo(const mfem::HypreParMatrix& matrix) const
+{
+  int local  = matchesLocally(matrix);
+  int global = 0;
+  MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MIN, comm_);
+  return global;
+}
+
+void EliminationPlan::eliminate(mfem::HypreParMatrix& matrix)
+{
+  SLIC_ASSERT_MSG(matchesLocally(matrix), "The elimination plan was computed for a different sparsity");
+
+  auto* diag_values = hypre_CSRMatrixData(diag(matrix));
+  auto* offd_values = hypre_CSRMatrixData(offd(matrix));
+
+  for (std::size_t i = 0; i < diag_column_positions_.size(); i++) {
+    diag_column_values_[i] = diag_values[diag_column_positions_[i]];
+  }
+  for (std::size_t i = 0; i < offd_column_positions_.size(); i++) {
+    offd_column_values_[i] = offd_values[offd_column_positions_[i]];
+  }
+
+  for (auto position : diag_zeros_) {
+    diag_values[position] = 0.0;
+  }
+  for (auto position : diag_ones_) {
+    diag_values[position] = 1.0;
+  }
+  for (auto position : offd_zeros_) {
+    offd_values[position] = 0.0;
+  }
+}
+
+void EliminationPlan::eliminateRHS(const mfem::Vector& solution, mfem::Vector& rhs) const
+{
+  const double* x = solution.HostRead();
+  double*       b = rhs.HostReadWrite();
+
+  exchange(comm_, MPI_DOUBLE, x, send_procs_.size(), send_procs_.data(), send_starts_.data(), send_rows_.data(),
+           recv_procs_.size(), recv_procs_.data(), recv_starts_.data(), sent_, received_.data());
+
+  for (std::size_t i = 0; i < diag_column_values_.size(); i++) {
+    b[diag_column_indices_[2 * i]] -= diag_column_values_[i] * x[diag_column_indices_[2 * i + 1]];
+  }
+  for (std::size_t i = 0; i < offd_column_values_.size(); i++) {
+    b[offd_column_indices_[2 * i]] -= offd_column_values_[i] * received_[offd_column_indices_[2 * i + 1]];
+  }
+  for (auto dof : dofs_) {
+    b[dof] = x[dof];
+  }
+}
+
+MemoryUsage EliminationPlan::memoryUsage() const
+{
+  std::size_t positions = 0;
+  for (const auto* list : {&dofs_, &diag_ones_, &diag_zeros_, &offd_zeros_, &diag_column_positions_,
+                           &diag_column_indices_, &offd_column_positions_, &offd_column_indices_, &send_rows_}) {
+    positions += list->capacity() * sizeof(HYPRE_Int);
+  }
+
+  MemoryUsage usage;
+  usage.add("positions", positions);
+  usage.add("values", (diag_column_values_.capacity() + offd_column_values_.capacity() + sent_.capacity() +
+                       received_.capacity()) *
+                          sizeof(double));
+  return usage;
+}
+
+bool EliminationPlan::matchesLocally(const mfem::HypreParMatrix& matrix) const
+{
+  return hypre_CSRMatrixNumRows(diag(matrix)) == rows_ && hypre_CSRMatrixNumNonzeros(diag(matrix)) == diag_nonzeros_ &&
+         hypre_CSRMatrixNumNonzeros(offd(matrix)) == offd_nonzeros_ &&
+         hypre_CSRMatrixNumCols(offd(matrix)) == offd_columns_ && sparsityHash(matrix) == sparsity_hash_;
+}
+
+}  // namespace serac::mfem_ext
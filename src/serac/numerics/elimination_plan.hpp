@@ -0,0 +1,208 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file elimination_plan.hpp
+ *
+ * @brief Symmetric elimination of essential degrees of freedom from assembled matrices that keep their sparsity
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mfem.hpp"
+#include "mpi.h"
+
+#include "serac/infrastructure/memory_usage.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief The positions of the rows and columns of the essential degrees of freedom in the sparsity of a matrix
+ *
+ * mfem::HypreParMatrix::EliminateRowsCols finds the eliminated entries by searching the matrix and communicating
+ * which of its off-diagonal columns are essential, and returns them as a new matrix, every time it is called. A
+ * Jacobian that is rebuilt with the same sparsity at every Newton iteration repeats all of this. The plan does the
+ * search and the communication once, after which an elimination only overwrites the planned values: the rows and
+ * columns of the essential degrees of freedom are zeroed and their diagonal entries set to one.
+ *
+ * The eliminated column values are kept by the plan instead of being returned as a matrix, so the right-hand side can
+ * be corrected like with mfem::EliminateBC. Only the essential values of the solution that are needed by the
+ * neighboring ranks are exchanged for that.
+ *
+ * A matrix only matches the plan if it has the same counts and the same hash of its column indices as the matrix the
+ * plan was computed for, so a matrix whose entries moved to other columns gets a new plan.
+ */
+class EliminationPlan {
+public:
+  /**
+   * @brief Plans the elimination of degrees of freedom from matrices with the sparsity of a matrix
+   *
+   * @param[in] matrix A square matrix with the sparsity of the matrices to eliminate from
+   * @param[in] dofs The local true degrees of freedom to eliminate
+   * @note This is a collective operation over the communicator of the matrix
+   */
+  EliminationPlan(const mfem::HypreParMatrix& matrix, const mfem::Array<int>& dofs);
+
+  /**
+   * @brief Returns whether the matrix has the sparsity the plan was computed for on every rank
+   *
+   * @param[in] matrix The matrix
+   * @note This is a collective operation, so that all ranks agree on whether to compute a new plan
+   */
+  bool appliesTo(const mfem::HypreParMatrix& matrix) const;
+
+  /**
+   * @brief Eliminates the planned rows and columns from a matrix
+   *
+   * @param[inout] matrix The matrix, whose eliminated values are kept for the correction of right-hand sides
+   * @pre The plan applies to the matrix
+   */
+  void eliminate(mfem::HypreParMatrix& matrix);
+
+  /**
+   * @brief Corrects a right-hand side for the values of the eliminated degrees of freedom
+   *
+   * This subtracts the eliminated columns of the last eliminated matrix times the solution from the right-hand side,
+   * and copies the eliminated values of the solution into it.
+   *
+   * @param[in] solution The solution, whose values at the eliminated degrees of freedom are used
+   * @param[inout] rhs The right-hand side
+   * @note This is a collective operation over the communicator of the matrix
+   */
+  void eliminateRHS(const mfem::Vector& solution, mfem::Vector& rhs) const;
+
+  /**
+   * @brief Returns the memory held by the positions and values of the plan
+   */
+  MemoryUsage memoryUsage() const;
+
+private:
+  /**
+   * @brief Returns whether the matrix has the sparsity the plan was computed for on this rank
+   * @param[in] matrix The matrix
+   */
+  bool matchesLocally(const mfem::HypreParMatrix& matrix) const;
+
+  /**
+   * @brief The communicator of the matrix
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The number of local rows of the matrix
+   */
+  HYPRE_Int rows_;
+
+  /**
+   * @brief The number of nonzeros of the diagonal block
+   */
+  HYPRE_Int diag_nonzeros_;
+
+  /**
+   * @brief The number of nonzeros of the off-diagonal block
+   */
+  HYPRE_Int offd_nonzeros_;
+
+  /**
+   * @brief The number of columns of the off-diagonal block
+   */
+  HYPRE_Int offd_columns_;
+
+  /**
+   * @brief The hash of the sparsity of the matrix
+   */
+  std::uint64_t sparsity_hash_;
+
+  /**
+   * @brief The eliminated local rows
+   */
+  std::vector<HYPRE_Int> dofs_;
+
+  /**
+   * @brief The positions in the diagonal block of the diagonal entries of the eliminated rows
+   */
+  std::vector<HYPRE_Int> diag_ones_;
+
+  /**
+   * @brief The positions in the diagonal block of the other entries of the eliminated rows and columns
+   */
+  std::vector<HYPRE_Int> diag_zeros_;
+
+  /**
+   * @brief The positions in the off-diagonal block of the entries of the eliminated rows and columns
+   */
+  std::vector<HYPRE_Int> offd_zeros_;
+
+  /**
+   * @brief The positions in the diagonal block of the eliminated column entries of the other rows
+   */
+  std::vector<HYPRE_Int> diag_column_positions_;
+
+  /**
+   * @brief The row and the column of each of diag_column_positions_, interleaved
+   */
+  std::vector<HYPRE_Int> diag_column_indices_;
+
+  /**
+   * @brief The value of each of diag_column_positions_ before the last elimination
+   */
+  std::vector<double> diag_column_values_;
+
+  /**
+   * @brief The positions in the off-diagonal block of the eliminated column entries of the other rows
+   */
+  std::vector<HYPRE_Int> offd_column_positions_;
+
+  /**
+   * @brief The row and the index in received_ of each of offd_column_positions_, interleaved
+   */
+  std::vector<HYPRE_Int> offd_column_indices_;
+
+  /**
+   * @brief The value of each of offd_column_positions_ before the last elimination
+   */
+  std::vector<double> offd_column_values_;
+
+  /**
+   * @brief The neighboring ranks that have eliminated degrees of freedom of this rank as columns
+   */
+  std::vector<HYPRE_Int> send_procs_;
+
+  /**
+   * @brief The eliminated local rows each of send_procs_ has as columns, grouped by rank
+   */
+  std::vector<HYPRE_Int> send_rows_;
+
+  /**
+   * @brief The offsets of the groups of send_rows_
+   */
+  std::vector<HYPRE_Int> send_starts_;
+
+  /**
+   * @brief The neighboring ranks that own eliminated off-diagonal columns of this rank
+   */
+  std::vector<HYPRE_Int> recv_procs_;
+
+  /**
+   * @brief The offsets of the values received from each of recv_procs_
+   */
+  std::vector<HYPRE_Int> recv_starts_;
+
+  /**
+   * @brief Buffer for the solution values that are sent
+   */
+  mutable std::vector<double> sent_;
+
+  /**
+   * @brief Buffer for the solution values of the eliminated off-diagonal columns
+   */
+  mutable std::vector<double> received_;
+};
+
+}  // namespace serac::mfem_ext
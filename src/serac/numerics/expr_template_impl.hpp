@@ -13,9 +13,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "serac/infrastructure/logger.hpp"
 #include "serac/numerics/vector_expression.hpp"
@@ -87,6 +91,88 @@ auto index(vec&& v, const int idx)
 
 using serac::VectorExpr;
 
+/**
+ * @brief A view of the entries of an mfem::Vector that can be captured by value in a kernel
+ */
+struct VectorView {
+  /**
+   * @brief The entries, on the host or the device
+   */
+  const double* data;
+
+  /**
+   * @brief Returns the entry at index @p i
+   */
+  SERAC_HOST_DEVICE double operator[](const int i) const { return data[i]; }
+};
+
+/**
+ * @brief A view of a unary expression
+ * @tparam View The view of the operand
+ * @tparam UnOp The type of the unary operator
+ */
+template <typename View, typename UnOp>
+struct UnaryView {
+  /**
+   * @brief The view of the operand
+   */
+  View v;
+
+  /**
+   * @brief The unary operator
+   */
+  UnOp op;
+
+  /**
+   * @brief Returns the entry at index @p i
+   */
+  SERAC_HOST_DEVICE double operator[](const int i) const { return op(v[i]); }
+};
+
+/**
+ * @brief A view of a binary expression
+ * @tparam LView The view of the left operand
+ * @tparam RView The view of the right operand
+ * @tparam BinOp The type of the binary operator
+ */
+template <typename LView, typename RView, typename BinOp>
+struct BinaryView {
+  /**
+   * @brief The view of the left operand
+   */
+  LView u;
+
+  /**
+   * @brief The view of the right operand
+   */
+  RView v;
+
+  /**
+   * @brief The binary operator
+   */
+  BinOp op;
+
+  /**
+   * @brief Returns the entry at index @p i
+   */
+  SERAC_HOST_DEVICE double operator[](const int i) const { return op(u[i], v[i]); }
+};
+
+/**
+ * @brief Returns a view of an operand of an expression, either a vector or another expression
+ * @param[in] v The operand
+ * @param[in] on_device Whether the view is used on the device
+ */
+template <typename vec>
+auto makeView(const vec& v, const bool on_device)
+{
+  if constexpr (std::is_base_of_v<mfem::Vector, vec>) {
+    return VectorView{v.Read(on_device)};
+  } else {
+    return v.view(on_device);
+  }
+}
+
 /**
  * @brief Derived VectorExpr class for representing the application of a unary
  * operator to a vector
@@ -114,10 +200,19 @@ public:
    * @brief Returns the size of the vector expression
    */
   int Size() const { return v_.Size(); }
+  /**
+   * @brief Returns a flattened view of the expression for the evaluation loops
+   * @param on_device Whether the view is used on the device
+   */
+  auto view(const bool on_device) const
+  {
+    auto operand = makeView(v_, on_device);
+    return UnaryView<decltype(operand), UnOp>{operand, op_};
+  }
 
 private:
-  const vec_t<vec> v_;
-  const UnOp       op_;
+  vec_t<vec> v_;
+  const UnOp op_;
 };
 
 /**
@@ -133,7 +228,7 @@ public:
   /**
    * @brief Applies the partial application to the remaining argument
    */
-  double operator()(const double arg) const { return arg * scalar_; }
+  SERAC_HOST_DEVICE double operator()(const double arg) const { return arg * scalar_; }
 
 private:
   double scalar_;
@@ -155,7 +250,7 @@ public:
   /**
    * @brief Applies the partial application to the remaining argument
    */
-  double operator()(const double arg) const
+  SERAC_HOST_DEVICE double operator()(const double arg) const
   {
     if constexpr (is_denominator) {
       return arg / scalar_;
@@ -209,11 +304,21 @@ public:
    * @brief Returns the size of the vector expression
    */
   int Size() const { return v_.Size(); }
+  /**
+   * @brief Returns a flattened view of the expression for the evaluation loops
+   * @param on_device Whether the view is used on the device
+   */
+  auto view(const bool on_device) const
+  {
+    auto left  = makeView(u_, on_device);
+    auto right = makeView(v_, on_device);
+    return BinaryView<decltype(left), decltype(right), BinOp>{left, right, op_};
+  }
 
 private:
-  const vec_t<lhs> u_;
-  const vec_t<rhs> v_;
-  const BinOp      op_ = BinOp{};
+  vec_t<lhs>  u_;
+  vec_t<rhs>  v_;
+  const BinOp op_ = BinOp{};
 };
 
 /**
@@ -228,6 +333,88 @@ using VectorAddition = BinaryVectorExpr<lhs, rhs, std::plus<double>>;
 template <typename lhs, typename rhs>
 using VectorSubtraction = BinaryVectorExpr<lhs, rhs, std::minus<double>>;
 
+/**
+ * @brief A free list of the vectors that hold the intermediate results of expressions
+ *
+ * Intermediate results only live as long as the expression that contains them, so once an
+ * expression has been evaluated, evaluating it again takes all of its vectors from the pool.
+ */
+class ScratchPool {
+public:
+  /**
+   * @brief Returns a vector to the pool it was acquired from
+   */
+  struct Release {
+    /**
+     * @brief The pool the vector was acquired from
+     */
+    ScratchPool* pool;
+
+    /**
+     * @brief Returns @p vector to the pool
+     */
+    void operator()(mfem::Vector* vector) const { pool->free_.emplace_back(vector); }
+  };
+
+  /**
+   * @brief A vector that is returned to the pool when it goes out of scope
+   */
+  using Handle = std::unique_ptr<mfem::Vector, Release>;
+
+  /**
+   * @brief Returns a vector with (uninitialized) entries
+   * @param[in] size The number of entries
+   */
+  Handle acquire(const int size)
+  {
+    // Prefer a vector of the right size, then the most recently released one, which is the most likely to be in cache
+    auto found =
+        std::find_if(free_.rbegin(), free_.rend(), [size](const auto& vector) { return vector->Size() == size; });
+    if (found == free_.rend() && !free_.empty()) {
+      found = free_.rbegin();
+    }
+
+    std::unique_ptr<mfem::Vector> vector;
+    if (found != free_.rend()) {
+      vector = std::move(*found);
+      free_.erase(std::next(found).base());
+      if (vector->Capacity() < size) {
+        allocations_++;
+      }
+      vector->SetSize(size);
+    } else {
+      vector = std::make_unique<mfem::Vector>(size);
+      allocations_++;
+    }
+    return Handle(vector.release(), Release{this});
+  }
+
+  /**
+   * @brief Returns the number of times the pool has allocated memory
+   */
+  int allocations() const { return allocations_; }
+
+private:
+  /**
+   * @brief The vectors that are not in use
+   */
+  std::vector<std::unique_ptr<mfem::Vector>> free_;
+
+  /**
+   * @brief The number of times the pool has allocated memory
+   */
+  int allocations_ = 0;
+};
+
+/**
+ * @brief Returns the scratch pool of the calling thread
+ */
+inline ScratchPool& scratchPool()
+{
+  static thread_local ScratchPool pool;
+  return pool;
+}
+
 /**
  * @brief Derived VectorExpr class for the application of an mfem::Operator to a vector,
  * e.g., matrix-vector multiplication
@@ -236,7 +423,10 @@ using VectorSubtraction = BinaryVectorExpr<lhs, rhs, std::minus<double>>;
  * nonzero value
  * @note This class does not participate in lazy evaluation, that is, it
  * will perform the full operation (`mfem::Operator::Mult`) when the object
- * is constructed
+ * is constructed. The result is stored in a vector from the scratch pool,
+ * and an argument that is itself an expression is evaluated in a single pass
+ * into another one, so evaluating an expression repeatedly does not allocate.
+ * Copies of the expression hold their own copies of the result from the pool.
  */
 template <typename vec>
 class OperatorExpr : public VectorExpr<OperatorExpr<vec>> {
@@ -244,24 +434,60 @@ public:
   /**
    * @brief Constructs a "mfem::Operator::Mult" expression
    */
-  OperatorExpr(const mfem::Operator& A, const vec& v) : result_(A.Height())
+  OperatorExpr(const mfem::Operator& A, const vec& v) : result_(scratchPool().acquire(A.Height()))
+  {
+    if constexpr (std::is_base_of_v<mfem::Vector, vec>) {
+      A.Mult(v, *result_);
+    } else {
+      // The argument is only needed for the Mult, so its vector goes straight back to the pool
+      auto argument = scratchPool().acquire(v.Size());
+      evaluate(v, *argument);
+      A.Mult(*argument, *result_);
+    }
+  }
+  /**
+   * @brief Copies the result of another expression into a vector from the scratch pool
+   */
+  OperatorExpr(const OperatorExpr& other) : result_(scratchPool().acquire(other.Size())) { *result_ = *other.result_; }
+  /**
+   * @brief Takes the result of another expression, which must not be used afterwards
+   */
+  OperatorExpr(OperatorExpr&& other) = default;
+  /**
+   * @brief Copies the result of another expression, keeping the vector from the scratch pool if it has the same size
+   */
+  OperatorExpr& operator=(const OperatorExpr& other)
   {
-    // No-op if `vec` is a already an mfem::Vector, otherwise explicitly convert
-    A.Mult(static_cast<mfem::Vector>(v), result_);
+    if (this != &other) {
+      if (result_->Size() != other.Size()) {
+        result_ = scratchPool().acquire(other.Size());
+      }
+      *result_ = *other.result_;
+    }
+    return *this;
   }
+  /**
+   * @brief Takes the result of another expression, which must not be used afterwards
+   */
+  OperatorExpr& operator=(OperatorExpr&& other) = default;
   /**
    * @brief Returns the fully evaluated value for the vector
    * expression at index @p i
    * @param i The index to evaluate at
    */
-  double operator[](int i) const { return result_[i]; }
+  double operator[](int i) const { return result_->HostRead()[i]; }
   /**
    * @brief Returns the size of the vector expression
    */
-  int Size() const { return result_.Size(); }
+  int Size() const { return result_->Size(); }
+  /**
+   * @brief Returns a view of the result for the evaluation loops
+   * @param on_device Whether the view is used on the device
+   */
+  VectorView view(const bool on_device) const { return VectorView{result_->Read(on_device)}; }
 
 private:
-  mfem::Vector result_;
+  ScratchPool::Handle result_;
 };
 
 }  // namespace serac::detail
@@ -0,0 +1,78 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/sparsity_hash.hpp"
+
+#include "_hypre_parcsr_mv.h"
+
+namespace serac::mfem_ext {
+
+namespace {
+
+/**
+ * @brief A 64-bit FNV-1a hash over a sequence of integers, which are taken whole rather than byte by byte
+ */
+class Hash {
+public:
+  /**
+   * @brief Adds an integer to the hash
+   */
+  void add(const std::uint64_t value)
+  {
+    value_ ^= value;
+    value_ *= 0x100000001b3ULL;
+  }
+
+  /**
+   * @brief Adds a size and that many integers to the hash
+   */
+  template <typename T>
+  void add(const T* values, const HYPRE_Int size)
+  {
+    add(static_cast<std::uint64_t>(size));
+    for (HYPRE_Int i = 0; i < size; i++) {
+      add(static_cast<std::uint64_t>(values[i]));
+    }
+  }
+
+  /**
+   * @brief Returns the hash of the integers added so far
+   */
+  std::uint64_t value() const { return value_; }
+
+private:
+  /**
+   * @brief The hash, initially the FNV offset basis
+   */
+  std::uint64_t value_ = 0xcbf29ce484222325ULL;
+};
+
+/**
+ * @brief Adds the row offsets and column indices of a block of a parallel matrix to a hash
+ */
+void addBlock(hypre_CSRMatrix* block, Hash& hash)
+{
+  const HYPRE_Int rows = hypre_CSRMatrixNumRows(block);
+  hash.add(static_cast<std::uint64_t>(hypre_CSRMatrixNumCols(block)));
+  hash.add(hypre_CSRMatrixI(block), rows + 1);
+  hash.add(hypre_CSRMatrixJ(block), hypre_CSRMatrixI(block)[rows]);
+}
+
+}  // namespace
+
+std::uint64_t sparsityHash(const mfem::HypreParMatrix& matrix)
+{
+  auto* parcsr = static_cast<hypre_ParCSRMatrix*>(matrix);
+  auto* offd   = hypre_ParCSRMatrixOffd(parcsr);
+
+  Hash hash;
+  addBlock(hypre_ParCSRMatrixDiag(parcsr), hash);
+  addBlock(offd, hash);
+  hash.add(hypre_ParCSRMatrixColMapOffd(parcsr), hypre_CSRMatrixNumCols(offd));
+  return hash.value();
+}
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,33 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file sparsity_hash.hpp
+ *
+ * @brief A fingerprint of the sparsity of an assembled parallel matrix
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mfem.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief Returns a hash of the sparsity of the local rows of a parallel matrix
+ *
+ * The hash covers the row offsets and column indices of the diagonal and off-diagonal blocks, and the global column
+ * of each column of the off-diagonal block. Objects that precompute positions in the sparsity of a matrix keep the
+ * hash of that matrix, and compare it with the hash of each matrix they are applied to, which is a single pass over
+ * the indices.
+ *
+ * @param[in] matrix The matrix
+ */
+std::uint64_t sparsityHash(const mfem::HypreParMatrix& matrix);
+
+}  // namespace serac::mfem_ext
@@ -0,0 +1,382 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/superlu_solver.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "_hypre_parcsr_mv.h"
+#include "superlu_ddefs.h"
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::mfem_ext {
+
+struct SuperLUSolver::SuperLUData {
+  /**
+   * @brief Frees the SuperLU_DIST structures
+   */
+  ~SuperLUData()
+  {
+    releaseAnalysis();
+    releaseMatrix();
+    superlu_gridexit(&grid);
+  }
+
+  /**
+   * @brief Copies the values of a matrix into the row-distributed matrix, if it has the same sparsity on this rank
+   * @param[in] source The matrix
+   * @return Whether the sparsity is the same, otherwise the values are left partially copied
+   */
+  bool copyValues(const mfem::HypreParMatrix& source)
+  {
+    auto*       parcsr = static_cast<hypre_ParCSRMatrix*>(source);
+    const auto* diag   = hypre_ParCSRMatrixDiag(parcsr);
+    const auto* offd   = hypre_ParCSRMatrixOffd(parcsr);
+    const auto  rows   = hypre_CSRMatrixNumRows(diag);
+
+    const auto nonzeros = static_cast<std::size_t>(hypre_CSRMatrixNumNonzeros(diag) + hypre_CSRMatrixNumNonzeros(offd));
+    if (!has_matrix || row_offsets.size() != static_cast<std::size_t>(rows) + 1 || columns.size() != nonzeros ||
+        global_rows != static_cast<int_t>(source.GetGlobalNumRows()) ||
+        first_row != static_cast<int_t>(hypre_ParCSRMatrixFirstRowIndex(parcsr))) {
+      return false;
+    }
+
+    const auto  first_col   = hypre_ParCSRMatrixFirstColDiag(parcsr);
+    const auto* col_map     = hypre_ParCSRMatrixColMapOffd(parcsr);
+    const auto* diag_rows   = hypre_CSRMatrixI(diag);
+    const auto* diag_cols   = hypre_CSRMatrixJ(diag);
+    const auto* diag_values = hypre_CSRMatrixData(diag);
+    const auto* offd_rows   = hypre_CSRMatrixI(offd);
+    const auto* offd_cols   = hypre_CSRMatrixJ(offd);
+    const auto* offd_values = hypre_CSRMatrixData(offd);
+
+    std::size_t k = 0;
+    for (HYPRE_Int row = 0; row < rows; row++) {
+      if (row_offsets[static_cast<std::size_t>(row)] != static_cast<int_t>(k)) {
+        return false;
+      }
+      for (HYPRE_Int j = diag_rows[row]; j < diag_rows[row + 1]; j++, k++) {
+        if (columns[k] != static_cast<int_t>(first_col + diag_cols[j])) {
+          return false;
+        }
+        values[k] = diag_values[j];
+      }
+      for (HYPRE_Int j = offd_rows[row]; j < offd_rows[row + 1]; j++, k++) {
+        if (columns[k] != static_cast<int_t>(col_map[offd_cols[j]])) {
+          return false;
+        }
+        values[k] = offd_values[j];
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Replaces the row-distributed matrix with a copy of a matrix
+   * @param[in] source The matrix
+   * @pre The analysis and the previous matrix have been released
+   */
+  void copyMatrix(const mfem::HypreParMatrix& source)
+  {
+    auto*       parcsr = static_cast<hypre_ParCSRMatrix*>(source);
+    const auto* diag   = hypre_ParCSRMatrixDiag(parcsr);
+    const auto* offd   = hypre_ParCSRMatrixOffd(parcsr);
+    const auto  rows   = hypre_CSRMatrixNumRows(diag);
+
+    const auto  first_col   = hypre_ParCSRMatrixFirstColDiag(parcsr);
+    const auto* col_map     = hypre_ParCSRMatrixColMapOffd(parcsr);
+    const auto* diag_rows   = hypre_CSRMatrixI(diag);
+    const auto* diag_cols   = hypre_CSRMatrixJ(diag);
+    const auto* diag_values = hypre_CSRMatrixData(diag);
+    const auto* offd_rows   = hypre_CSRMatrixI(offd);
+    const auto* offd_cols   = hypre_CSRMatrixJ(offd);
+    const auto* offd_values = hypre_CSRMatrixData(offd);
+
+    const auto nonzeros = static_cast<std::size_t>(hypre_CSRMatrixNumNonzeros(diag) + hypre_CSRMatrixNumNonzeros(offd));
+    row_offsets.clear();
+    columns.clear();
+    values.clear();
+    row_offsets.reserve(static_cast<std::size_t>(rows) + 1);
+    columns.reserve(nonzeros);
+    values.reserve(nonzeros);
+
+    // SuperLU_DIST takes the rows with global column indices, so the two blocks of each row are merged
+    for (HYPRE_Int row = 0; row < rows; row++) {
+      row_offsets.push_back(static_cast<int_t>(columns.size()));
+      for (HYPRE_Int j = diag_rows[row]; j < diag_rows[row + 1]; j++) {
+        columns.push_back(static_cast<int_t>(first_col + diag_cols[j]));
+        values.push_back(diag_values[j]);
+      }
+      for (HYPRE_Int j = offd_rows[row]; j < offd_rows[row + 1]; j++) {
+        columns.push_back(static_cast<int_t>(col_map[offd_cols[j]]));
+        values.push_back(offd_values[j]);
+      }
+    }
+    row_offsets.push_back(static_cast<int_t>(columns.size()));
+    factored_values.resize(values.size());
+
+    global_rows = static_cast<int_t>(source.GetGlobalNumRows());
+    first_row   = static_cast<int_t>(hypre_ParCSRMatrixFirstRowIndex(parcsr));
+    dCreate_CompRowLoc_Matrix_dist(&matrix, global_rows, global_rows, static_cast<int_t>(nonzeros), rows, first_row,
+                                   factored_values.data(), columns.data(), row_offsets.data(), SLU_NR_loc, SLU_D,
+                                   SLU_GE);
+    has_matrix = true;
+  }
+
+  /**
+   * @brief Solves with the factors of the matrix, factoring it first unless fact is FACTORED
+   * @param[in] fact How much of the previous analysis to reuse
+   * @param[in] b The right-hand side
+   * @param[out] x The solution
+   * @return Whether SuperLU_DIST succeeded on every rank
+   */
+  bool solve(fact_t fact, const mfem::Vector& b, mfem::Vector& x)
+  {
+    options.Fact = fact;
+    x            = b;
+
+    SuperLUStat_t stat;
+    PStatInit(&stat);
+    double berr = 0.0;
+    int    info = 0;
+    pdgssvx(&options, &matrix, &scale_perm, x.HostReadWrite(), static_cast<int>(row_offsets.size() - 1), 1, &grid, &lu,
+            &solve_struct, &berr, &stat, &info);
+    if (options.PrintStat == YES) {
+      PStatPrint(&options, &stat, &grid);
+    }
+    PStatFree(&stat);
+
+    int failed = (info != 0);
+    MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+    return failed == 0;
+  }
+
+  /**
+   * @brief Frees the factors and the structures of the triangular solves, which depend on the row permutation
+   */
+  void releaseFactors()
+  {
+    if (has_factors) {
+      Destroy_LU(global_rows, &grid, &lu);
+      has_factors = false;
+    }
+    if (options.SolveInitialized == YES) {
+      dSolveFinalize(&options, &solve_struct);
+    }
+  }
+
+  /**
+   * @brief Frees the factors, the permutations and the scaling
+   */
+  void releaseAnalysis()
+  {
+    releaseFactors();
+    if (has_analysis) {
+      ScalePermstructFree(&scale_perm);
+      LUstructFree(&lu);
+      has_analysis = false;
+    }
+  }
+
+  /**
+   * @brief Frees the descriptor of the row-distributed matrix, whose arrays are owned by the vectors below
+   */
+  void releaseMatrix()
+  {
+    if (has_matrix) {
+      Destroy_SuperMatrix_Store_dist(&matrix);
+      has_matrix = false;
+    }
+  }
+
+  /**
+   * @brief The communicator of the solver
+   */
+  MPI_Comm comm;
+
+  /**
+   * @brief The process grid, with one process column
+   */
+  gridinfo_t grid;
+
+  /**
+   * @brief The options, whose Fact is set for every call to pdgssvx
+   */
+  superlu_dist_options_t options;
+
+  /**
+   * @brief The scaling and the permutations, which are kept between matrices with the same sparsity
+   */
+  ScalePermstruct_t scale_perm;
+
+  /**
+   * @brief The elimination tree and the factors
+   */
+  LUstruct_t lu;
+
+  /**
+   * @brief The communication patterns of the triangular solves
+   */
+  SOLVEstruct_t solve_struct;
+
+  /**
+   * @brief The descriptor of the row-distributed matrix
+   */
+  SuperMatrix matrix;
+
+  /**
+   * @brief Whether matrix has been created
+   */
+  bool has_matrix = false;
+
+  /**
+   * @brief Whether scale_perm and lu have been initialized
+   */
+  bool has_analysis = false;
+
+  /**
+   * @brief Whether the factors in lu have been allocated
+   */
+  bool has_factors = false;
+
+  /**
+   * @brief The global number of rows of the matrix
+   */
+  int_t global_rows = 0;
+
+  /**
+   * @brief The global index of the first local row
+   */
+  int_t first_row = 0;
+
+  /**
+   * @brief The offsets of the local rows in columns and values
+   */
+  std::vector<int_t> row_offsets;
+
+  /**
+   * @brief The global column of every local nonzero
+   */
+  std::vector<int_t> columns;
+
+  /**
+   * @brief The values of the matrix
+   */
+  std::vector<double> values;
+
+  /**
+   * @brief The values given to SuperLU_DIST, which overwrites them with the equilibrated matrix
+   */
+  std::vector<double> factored_values;
+};
+
+SuperLUSolver::SuperLUSolver(MPI_Comm comm, bool print_statistics) : superlu_(std::make_unique<SuperLUData>())
+{
+  int num_procs = 0;
+  MPI_Comm_size(comm, &num_procs);
+  superlu_->comm = comm;
+  superlu_gridinit(comm, num_procs, 1, &superlu_->grid);
+
+  set_default_options_dist(&superlu_->options);
+  superlu_->options.ColPerm   = PARMETIS;
+  superlu_->options.PrintStat = print_statistics ? YES : NO;
+}
+
+SuperLUSolver::~SuperLUSolver() = default;
+
+void SuperLUSolver::SetOperator(const mfem::Operator& op)
+{
+  const auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+  SLIC_ERROR_ROOT_IF(matrix == nullptr, "SuperLUSolver requires a HypreParMatrix");
+  height = op.Height();
+  width  = op.Width();
+
+  int same_sparsity = superlu_->copyValues(*matrix);
+  MPI_Allreduce(MPI_IN_PLACE, &same_sparsity, 1, MPI_INT, MPI_MIN, superlu_->comm);
+
+  if (same_sparsity) {
+    analysis_ = std::max(analysis_, Analysis::SamePatternSameRowPerm);
+  } else {
+    superlu_->releaseAnalysis();
+    superlu_->releaseMatrix();
+    superlu_->copyMatrix(*matrix);
+    analysis_ = Analysis::Full;
+  }
+}
+
+void SuperLUSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SLIC_ERROR_ROOT_IF(!superlu_->has_matrix, "SuperLUSolver needs a matrix before solving");
+
+  static profiling::Counter& analyses         = profiling::counter("Direct solver analyses");
+  static profiling::Counter& refactorizations = profiling::counter("Direct solver refactorizations");
+
+  if (analysis_ == Analysis::None) {
+    SLIC_ERROR_ROOT_IF(!superlu_->solve(FACTORED, b, x), "SuperLU_DIST failed to solve with the factors");
+    return;
+  }
+
+  if (analysis_ == Analysis::SamePatternSameRowPerm) {
+    if (factor(analysis_, b, x)) {
+      refactorizations++;
+      analysis_ = Analysis::None;
+      return;
+    }
+    SLIC_WARNING_ROOT("Zero pivot with the row permutation of the previous matrix, computing a new one");
+    analysis_ = Analysis::SamePattern;
+  }
+
+  SLIC_ERROR_ROOT_IF(!factor(analysis_, b, x), "SuperLU_DIST failed to factor the matrix, which may be singular");
+  if (analysis_ == Analysis::Full) {
+    analyses++;
+  } else {
+    refactorizations++;
+  }
+  analysis_ = Analysis::None;
+}
+
+bool SuperLUSolver::factor(Analysis analysis, const mfem::Vector& b, mfem::Vector& x) const
+{
+  auto&  superlu = *superlu_;
+  fact_t fact    = DOFACT;
+  switch (analysis) {
+    case Analysis::Full:
+      superlu.releaseAnalysis();
+      ScalePermstructInit(superlu.global_rows, superlu.global_rows, &superlu.scale_perm);
+      LUstructInit(superlu.global_rows, &superlu.lu);
+      superlu.has_analysis = true;
+      break;
+    case Analysis::SamePattern:
+      superlu.releaseFactors();
+      fact = SamePattern;
+      break;
+    case Analysis::SamePatternSameRowPerm:
+      fact = SamePattern_SameRowPerm;
+      break;
+    case Analysis::None:
+      SLIC_ERROR("A factorization needs an analysis to do");
+      break;
+  }
+
+  // The copy is overwritten with the equilibrated matrix, so a failed factorization can be retried
+  std::copy(superlu.values.begin(), superlu.values.end(), superlu.factored_values.begin());
+  const bool succeeded = superlu.solve(fact, b, x);
+  superlu.has_factors  = true;
+  return succeeded;
+}
+
+MemoryUsage SuperLUSolver::memoryUsage() const
+{
+  MemoryUsage usage;
+  usage.add("matrix", (superlu_->row_offsets.capacity() + superlu_->columns.capacity()) * sizeof(int_t) +
+                          (superlu_->values.capacity() + superlu_->factored_values.capacity()) * sizeof(double));
+  return usage;
+}
+
+}  // namespace serac::mfem_ext
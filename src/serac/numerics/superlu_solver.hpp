@@ -0,0 +1,126 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file superlu_solver.hpp
+ *
+ * @brief A SuperLU_DIST direct solver that reuses the analysis of matrices with an unchanged sparsity
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mfem.hpp"
+#include "mpi.h"
+
+#include "serac/infrastructure/memory_usage.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief A direct solver for assembled parallel matrices, based on SuperLU_DIST
+ *
+ * mfem::SuperLUSolver needs a new mfem::SuperLURowLocMatrix, i.e. a new copy of the matrix, for every Jacobian, and
+ * analyzes each of them from scratch: the equilibration, the row permutation for stability, the fill-reducing column
+ * ordering with ParMETIS and the symbolic factorization. Newton iterations and time steps factor sequences of
+ * matrices with the same sparsity, for which only the first analysis is needed.
+ *
+ * This solver keeps the row-distributed matrix given to SuperLU_DIST, and copies the values of every new matrix into
+ * it while comparing the sparsity. A matrix with the sparsity of the previous one is factored with
+ * SamePattern_SameRowPerm, which reuses the scaling, both permutations and the symbolic factors, so only the numerical
+ * factorization is redone. Should that hit a zero pivot, the values have drifted too far from those the row
+ * permutation was computed for, and the matrix is factored again with SamePattern, which only reuses the column
+ * ordering and its elimination tree. A matrix with a new sparsity is analyzed from scratch.
+ *
+ * The "Direct solver analyses" and "Direct solver refactorizations" counters record which of the two happened.
+ */
+class SuperLUSolver : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a solver
+   * @param[in] comm The communicator of the matrices to solve with
+   * @param[in] print_statistics Whether SuperLU_DIST prints the statistics of every factorization and solve
+   */
+  SuperLUSolver(MPI_Comm comm, bool print_statistics = false);
+
+  /**
+   * @brief The SuperLU_DIST structures can't be copied
+   */
+  SuperLUSolver(const SuperLUSolver&) = delete;
+
+  /**
+   * @brief The SuperLU_DIST structures can't be copied
+   */
+  SuperLUSolver& operator=(const SuperLUSolver&) = delete;
+
+  /**
+   * @brief Frees the SuperLU_DIST structures
+   */
+  ~SuperLUSolver() override;
+
+  /**
+   * @brief Copies a matrix, which is factored by the next solve
+   * @param[in] op The matrix, which must be an mfem::HypreParMatrix and isn't referenced after the call
+   * @note This is a collective operation, so that all ranks agree on whether the sparsity has changed
+   * @note Implements mfem::Solver::SetOperator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Solves with the matrix, factoring it first if it was set since the last solve
+   * @param[in] b The right-hand side
+   * @param[out] x The solution
+   * @note This is a collective operation over the communicator of the solver
+   * @note Implements mfem::Operator::Mult
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /**
+   * @brief Returns the memory held by the copy of the matrix
+   * @note The factors are allocated by SuperLU_DIST and aren't counted
+   */
+  MemoryUsage memoryUsage() const;
+
+private:
+  /**
+   * @brief The work needed before the next solve, ordered by cost
+   */
+  enum class Analysis
+  {
+    None,                   /**< The current factors are still valid */
+    SamePatternSameRowPerm, /**< Only a numerical factorization */
+    SamePattern,            /**< A new row permutation and symbolic factorization, with the same column ordering */
+    Full                    /**< A new analysis from scratch */
+  };
+
+  /**
+   * @brief The SuperLU_DIST structures and the row-distributed matrix, which are defined with the SuperLU_DIST
+   * headers in the implementation file
+   */
+  struct SuperLUData;
+
+  /**
+   * @brief Factors the matrix with a given reuse of the previous analysis, and solves with it
+   * @param[in] analysis The analysis to do, which mustn't be Analysis::None
+   * @param[in] b The right-hand side
+   * @param[out] x The solution
+   * @return Whether the factorization succeeded on every rank
+   */
+  bool factor(Analysis analysis, const mfem::Vector& b, mfem::Vector& x) const;
+
+  /**
+   * @brief The SuperLU_DIST structures and the row-distributed matrix
+   */
+  std::unique_ptr<SuperLUData> superlu_;
+
+  /**
+   * @brief The work needed before the next solve
+   */
+  mutable Analysis analysis_ = Analysis::Full;
+};
+
+}  // namespace serac::mfem_ext
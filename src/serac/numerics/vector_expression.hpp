@@ -13,9 +13,60 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "mfem.hpp"
 
+#include "serac/infrastructure/accelerator.hpp"
+
+#if defined(_OPENMP)
+#define SERAC_PRAGMA_SIMD _Pragma("omp simd")
+#elif defined(__clang__)
+#define SERAC_PRAGMA_SIMD _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define SERAC_PRAGMA_SIMD _Pragma("GCC ivdep")
+#else
+/**
+ * @brief Macro that asks the compiler to vectorize the loop that follows, asserting that its iterations are independent
+ */
+#define SERAC_PRAGMA_SIMD
+#endif
+
 namespace serac {
+
+/**
+ * @brief How the entries of a vector expression are computed
+ */
+enum class ExecutionPolicy
+{
+  Sequential, /**< A plain loop over operator[] of the expression */
+  Simd,       /**< A single vectorized loop over the entries */
+  Threaded,   /**< Vectorized blocks of entries distributed over the OpenMP threads, if enabled */
+  Device      /**< An MFEM forall over the entries, on the device if one is configured */
+};
+
+namespace detail {
+
+/**
+ * @brief The number of consecutive entries each thread computes at a time with ExecutionPolicy::Threaded
+ */
+inline constexpr int EXPR_BLOCK_SIZE = 4096;
+
+/**
+ * @brief The size below which ExecutionPolicy::Threaded does not start the OpenMP threads
+ */
+inline constexpr int EXPR_THREADING_THRESHOLD = 1 << 15;
+
+}  // namespace detail
+
+/**
+ * @brief Returns the policy used when none is given: on the device if MFEM has one configured,
+ * otherwise threaded
+ */
+inline ExecutionPolicy defaultExecutionPolicy()
+{
+  return mfem::Device::Allows(mfem::Backend::DEVICE_MASK) ? ExecutionPolicy::Device : ExecutionPolicy::Threaded;
+}
 /**
  * @brief A base class representing a vector expression
  * @tparam T The base vector type, e.g., mfem::Vector, or another VectorExpr
@@ -44,9 +95,7 @@ public:
   operator mfem::Vector() const
   {
     mfem::Vector result(Size());
-    for (int i = 0; i < Size(); i++) {
-      result[i] = (*this)[i];
-    }
+    evaluate(*this, result);
     return result;
   }
 
@@ -81,16 +130,69 @@ mfem::Vector evaluate(const VectorExpr<T>& expr)
  * @brief Fully evaluates a vector expression into an actual mfem::Vector
  * @param expr The expression to evaluate
  * @param result The vector to populate with the expression result
+ * @param policy How the entries are computed
+ * @note Every operand is read before any entry of @p result is written, so
+ * @p result may also be an operand of @p expr
  */
 template <typename T>
-void evaluate(const VectorExpr<T>& expr, mfem::Vector& result)
+void evaluate(const VectorExpr<T>& expr, mfem::Vector& result, const ExecutionPolicy policy)
 {
   SLIC_ERROR_IF(expr.Size() != result.Size(), "Vector sizes in expression assignment must be equal");
-  // Get the underlying array for indexing compatibility with mfem::HypreParVector
-  double* result_arr = result;
-  for (int i = 0; i < expr.Size(); i++) {
-    result_arr[i] = expr[i];
+  const int size = expr.Size();
+
+  if (policy == ExecutionPolicy::Sequential) {
+    // Get the underlying array for indexing compatibility with mfem::HypreParVector
+    double* result_arr = result.HostWrite();
+    for (int i = 0; i < size; i++) {
+      result_arr[i] = expr[i];
+    }
+    return;
+  }
+
+  // The view flattens the expression tree into raw pointers and functors, which
+  // the compiler can vectorize and which can be captured by a device kernel
+  const bool on_device = (policy == ExecutionPolicy::Device) && mfem::Device::Allows(mfem::Backend::DEVICE_MASK);
+  const auto view      = expr.asDerived().view(on_device);
+
+  if (policy == ExecutionPolicy::Device) {
+    double* result_arr = result.Write(on_device);
+    MFEM_FORALL_SWITCH(on_device, i, size, result_arr[i] = view[i];);
+    return;
+  }
+
+  double* result_arr = result.HostWrite();
+  if (policy == ExecutionPolicy::Simd) {
+    SERAC_PRAGMA_SIMD
+    for (int i = 0; i < size; i++) {
+      result_arr[i] = view[i];
+    }
+    return;
   }
+
+  const int num_blocks = (size + detail::EXPR_BLOCK_SIZE - 1) / detail::EXPR_BLOCK_SIZE;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (size >= detail::EXPR_THREADING_THRESHOLD)
+#endif
+  for (int block = 0; block < num_blocks; block++) {
+    const int end = std::min(size, (block + 1) * detail::EXPR_BLOCK_SIZE);
+    SERAC_PRAGMA_SIMD
+    for (int i = block * detail::EXPR_BLOCK_SIZE; i < end; i++) {
+      result_arr[i] = view[i];
+    }
+  }
+}
+
+/**
+ * @brief Fully evaluates a vector expression into an actual mfem::Vector
+ * with the default policy
+ * @param expr The expression to evaluate
+ * @param result The vector to populate with the expression result
+ * @see defaultExecutionPolicy
+ */
+template <typename T>
+void evaluate(const VectorExpr<T>& expr, mfem::Vector& result)
+{
+  evaluate(expr, result, defaultExecutionPolicy());
 }
 
 }  // namespace serac
@@ -7,6 +7,8 @@
 #include "serac/physics/base_physics.hpp"
 
 #include <fstream>
+#include <sstream>
+#include <stdexcept>
 
 #include "fmt/fmt.hpp"
 
@@ -17,12 +19,82 @@
 
 namespace serac {
 
+namespace detail {
+
+/**
+ * @brief A copy of one cycle's GLVis output, staged so that it can be written by a background thread
+ */
+struct GLVisSnapshot {
+  /**
+   * @brief A single field's GLVis file contents
+   */
+  struct Field {
+    /**
+     * @brief The name of the solution file
+     */
+    std::string file_name;
+    /**
+     * @brief The finite element space header that precedes the values
+     */
+    std::string header;
+    /**
+     * @brief The local degrees of freedom, with orientation signs applied
+     */
+    mfem::Vector values;
+    /**
+     * @brief The number of values per output line
+     */
+    int width;
+  };
+
+  /**
+   * @brief The name of the mesh file
+   */
+  std::string mesh_file_name;
+
+  /**
+   * @brief The serialized mesh (the nodes may change between cycles, so the mesh cannot be read later)
+   */
+  std::ostringstream mesh;
+
+  /**
+   * @brief The snapshot of each field
+   */
+  std::vector<Field> fields;
+
+  /**
+   * @brief Writes the staged files
+   * @param[in] precision The number of significant figures for the field values
+   */
+  void write(const int precision) const
+  {
+    std::ofstream omesh(mesh_file_name);
+    if (!omesh) {
+      throw std::runtime_error(fmt::format("Could not open '{0}' for writing", mesh_file_name));
+    }
+    omesh << mesh.str();
+
+    for (const auto& field : fields) {
+      std::ofstream osol(field.file_name);
+      if (!osol) {
+        throw std::runtime_error(fmt::format("Could not open '{0}' for writing", field.file_name));
+      }
+      osol.precision(precision);
+      // Mirrors the layout of mfem::ParGridFunction::Save
+      osol << field.header << '\n';
+      field.values.Print(osol, field.width);
+    }
+  }
+};
+
+}  // namespace detail
+
 BasePhysics::BasePhysics()
     : mesh_(StateManager::mesh()),
       comm_(mesh_.GetComm()),
       output_type_(serac::OutputType::VisIt),
-      time_(0.0),
-      cycle_(0),
+      time_(StateManager::loadedTime()),
+      cycle_(StateManager::loadedCycle()),
       bcs_(mesh_)
 {
   std::tie(mpi_size_, mpi_rank_) = getMPIInfo(comm_);
@@ -53,6 +125,16 @@ double BasePhysics::time() const { return time_; }
 
 int BasePhysics::cycle() const { return cycle_; }
 
+MemoryUsage BasePhysics::memoryUsage() const
+{
+  MemoryUsage usage;
+  for (auto& state : state_) {
+    usage.add("states/" + state.get().name(), memory::bytes(state.get().gridFunc()));
+    usage.add("states/" + state.get().name(), memory::bytes(state.get().trueVec()));
+  }
+  return usage;
+}
+
 void BasePhysics::initializeOutput(const serac::OutputType output_type, const std::string& root_name)
 {
   root_name_   = root_name;
@@ -115,6 +197,67 @@ void BasePhysics::outputState() const
     }
 
     case serac::OutputType::GLVis: {
+      if (glvis_aggregator_) {
+        std::vector<output::GLVisAggregator::Field> fields;
+        for (FiniteElementState& state : state_) {
+          fields.emplace_back(state.name(), &state.gridFunc());
+        }
+
+        // Only the writer ranks are handed a task
+        auto write =
+            glvis_aggregator_->gather(root_name_, cycle_, state_.front().get().mesh(), fields, FLOAT_PRECISION_);
+        if (write && output_writer_) {
+          output_writer_->enqueue(std::move(write));
+        } else if (write) {
+          try {
+            write();
+          } catch (const std::exception& e) {
+            SLIC_ERROR(e.what());
+          }
+        }
+        break;
+      }
+
+      if (output_writer_) {
+        // Fill the buffer that is not being written, the other one may still be in flight
+        auto& snapshot = glvis_snapshots_[next_snapshot_];
+        next_snapshot_ = 1 - next_snapshot_;
+        if (!snapshot) {
+          snapshot = std::make_shared<detail::GLVisSnapshot>();
+        }
+
+        snapshot->mesh_file_name = fmt::format("{0}-mesh.{1:0>6}.{2:0>6}", root_name_, cycle_, mpi_rank_);
+        snapshot->mesh.str("");
+        snapshot->mesh.clear();
+        snapshot->mesh.precision(FLOAT_PRECISION_);
+        state_.front().get().mesh().Print(snapshot->mesh);
+
+        snapshot->fields.resize(state_.size());
+        for (std::size_t i = 0; i < state_.size(); i++) {
+          FiniteElementState& state = state_[i];
+          auto&               field = snapshot->fields[i];
+          auto&               space = state.space();
+          field.file_name = fmt::format("{0}-{1}.{2:0>6}.{3:0>6}", root_name_, state.name(), cycle_, mpi_rank_);
+
+          std::ostringstream header;
+          space.Save(header);
+          field.header = header.str();
+          field.width  = (space.GetOrdering() == mfem::Ordering::byNODES) ? 1 : space.GetVDim();
+
+          // Copy the values, applying the orientation signs that ParGridFunction::Save would
+          field.values = state.gridFunc();
+          for (int dof = 0; dof < field.values.Size(); dof++) {
+            if (space.GetDofSign(dof) < 0) {
+              field.values[dof] = -field.values[dof];
+            }
+          }
+        }
+
+        // Blocks until the previous snapshot has been written, so the next cycle can reuse its buffer
+        output_writer_->enqueue([snapshot]() { snapshot->write(FLOAT_PRECISION_); });
+        break;
+      }
+
       std::string   mesh_name = fmt::format("{0}-mesh.{1:0>6}.{2:0>6}", root_name_, cycle_, mpi_rank_);
       std::ofstream omesh(mesh_name);
       omesh.precision(FLOAT_PRECISION_);
@@ -134,6 +277,42 @@ void BasePhysics::outputState() const
   }
 }
 
+void BasePhysics::setAsyncOutput(const bool async)
+{
+  if (!async) {
+    // The writer's destructor completes any pending output
+    output_writer_.reset();
+    return;
+  }
+
+  SLIC_WARNING_ROOT_IF(output_type_ != OutputType::GLVis,
+                       "Asynchronous output is only supported for GLVis output, other output types are written "
+                       "synchronously");
+  if (!output_writer_) {
+    output_writer_ = std::make_unique<output::AsyncWriter>();
+  }
+}
+
+void BasePhysics::setAggregatedOutput(const int num_writers, const bool compress)
+{
+  SLIC_ERROR_ROOT_IF(num_writers < 0, "The number of output writers must be non-negative");
+  SLIC_WARNING_ROOT_IF(num_writers > 0 && output_type_ != OutputType::GLVis,
+                       "Aggregated output is only supported for GLVis output, other output types are unaffected");
+
+  // Pending tasks hold their own copies of the gathered data, so the old aggregator can be released
+  glvis_aggregator_.reset();
+  if (num_writers > 0) {
+    glvis_aggregator_ = std::make_unique<output::GLVisAggregator>(comm_, num_writers, compress);
+  }
+}
+
+void BasePhysics::flushOutput() const
+{
+  if (output_writer_) {
+    output_writer_->flush();
+  }
+}
+
 namespace detail {
 std::string addPrefix(const std::string& prefix, const std::string& target)
 {
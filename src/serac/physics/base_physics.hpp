@@ -12,17 +12,25 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 
 #include "mfem.hpp"
 
+#include "serac/infrastructure/async_writer.hpp"
+#include "serac/infrastructure/glvis_output.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
 #include "serac/physics/utilities/boundary_condition_manager.hpp"
 #include "serac/physics/utilities/equation_solver.hpp"
 #include "serac/physics/utilities/finite_element_state.hpp"
 
 namespace serac {
 
+namespace detail {
+struct GLVisSnapshot;
+}  // namespace detail
+
 /**
  * @brief This is the abstract base class for a generic forward solver
  */
@@ -101,6 +109,45 @@ public:
    */
   virtual void advanceTimestep(double& dt) = 0;
 
+  /**
+   * @brief Returns whether the nonlinear solves of the most recent timestep converged
+   *
+   * @return True if the last call to advanceTimestep converged
+   */
+  virtual bool converged() const { return true; }
+
+  /**
+   * @brief Returns the final norm of the nonlinear residual of the most recent timestep
+   *
+   * @return The residual norm, or zero if the module does not use a nonlinear solver
+   */
+  virtual double nonlinearResidualNorm() const { return 0.0; }
+
+  /**
+   * @brief Returns the final residual norm of the most recent iterative linear solve
+   *
+   * @return The residual norm, or zero if the module does not use an iterative linear solver
+   */
+  virtual double linearResidualNorm() const { return 0.0; }
+
+  /**
+   * @brief Returns the memory held by the module on this rank
+   *
+   * @return The bytes of the states, and in derived modules of the matrices, solvers, and work vectors
+   */
+  virtual MemoryUsage memoryUsage() const;
+
+  /**
+   * @brief Logs the memory held by the module over all ranks, see memory::report
+   *
+   * @param[in] title The heading of the table
+   * @note This is a collective operation
+   */
+  void reportMemoryUsage(const std::string& title = "Memory usage") const
+  {
+    memory::report(title, memoryUsage(), comm_);
+  }
+
   /**
    * @brief Initialize the state variable output
    *
@@ -115,6 +162,37 @@ public:
    */
   virtual void outputState() const;
 
+  /**
+   * @brief Enable or disable asynchronous output
+   *
+   * When enabled, outputState() copies the fields into one of two staging buffers and the files
+   * are written by a background thread while the simulation continues. At most one snapshot is
+   * being written while the next one is filled.
+   *
+   * @param[in] async Whether output should be written asynchronously
+   * @note Only GLVis output is written asynchronously. The DataCollection-based output types make
+   * collective MPI calls while saving, so they are always written from the calling thread.
+   */
+  virtual void setAsyncOutput(const bool async);
+
+  /**
+   * @brief Blocks until all pending asynchronous output has been written
+   */
+  void flushOutput() const;
+
+  /**
+   * @brief Aggregate GLVis output through a fixed number of writer ranks
+   *
+   * Instead of one mesh and solution file per rank, each writer rank merges the pieces of a contiguous
+   * block of ranks and writes a single file set for the block. The merge and write are performed by the
+   * background thread when asynchronous output is enabled.
+   *
+   * @param[in] num_writers The number of writer ranks, or zero to write one file set per rank
+   * @param[in] compress Whether the aggregated files are gzip-compressed
+   * @note This must be called on all ranks as it splits the communicator of the mesh
+   */
+  virtual void setAggregatedOutput(const int num_writers, const bool compress = false);
+
   /**
    * @brief Destroy the Base Solver object
    */
@@ -167,12 +245,12 @@ protected:
   static constexpr int FLOAT_PRECISION_ = 8;
 
   /**
-   * @brief Current time
+   * @brief Current time, which continues from the loaded restart files when restarting
    */
   double time_;
 
   /**
-   * @brief Current cycle
+   * @brief Current cycle, which continues from the loaded restart files when restarting
    */
   int cycle_;
 
@@ -205,6 +283,26 @@ protected:
    * @brief Boundary condition manager instance
    */
   BoundaryConditionManager bcs_;
+
+  /**
+   * @brief Staging buffers for asynchronous GLVis output, filled alternately
+   */
+  mutable std::array<std::shared_ptr<detail::GLVisSnapshot>, 2> glvis_snapshots_;
+
+  /**
+   * @brief Index of the staging buffer to fill on the next output
+   */
+  mutable std::size_t next_snapshot_ = 0;
+
+  /**
+   * @brief Gathers GLVis output onto the writer ranks, null if every rank writes its own files
+   */
+  std::unique_ptr<output::GLVisAggregator> glvis_aggregator_;
+
+  /**
+   * @brief The background output writer, null if output is synchronous
+   */
+  std::unique_ptr<output::AsyncWriter> output_writer_;
 };
 
 namespace detail {
@@ -112,9 +112,12 @@ void DisplacementHyperelasticIntegrator::AssembleElementVector(
   // Set the transformation for the underlying material. This is required for coefficient evaluation.
   material_.setTransformation(parent_to_reference_transformation);
 
-  output_residual_matrix_ = 0.0;
+  const int num_points = ir->GetNPoints();
+  du_dX_points_.SetSize(dim, dim, num_points);
+  B_points_.SetSize(dof, dim, num_points);
+  weights_.SetSize(num_points);
 
-  for (int i = 0; i < ir->GetNPoints(); i++) {
+  for (int i = 0; i < num_points; i++) {
     // Set the current integration point
     const mfem::IntegrationPoint& int_point = ir->IntPoint(i);
     parent_to_reference_transformation.SetIntPoint(&int_point);
@@ -122,12 +125,19 @@ void DisplacementHyperelasticIntegrator::AssembleElementVector(
     // Calculate the deformation gradient at the current integration point
     CalcKinematics(element, int_point, parent_to_reference_transformation);
 
-    // Evaluate the Cauchy stress using the calculated deformation gradient
-    material_.evalStress(du_dX_, sigma_);
+    du_dX_points_(i) = du_dX_;
+    B_points_(i)     = B_;
+    weights_(i)      = det_J_ * int_point.weight * parent_to_reference_transformation.Weight();
+  }
 
-    // Accumulate the residual using the Cauchy stress and the B matrix
-    sigma_ *= det_J_ * int_point.weight * parent_to_reference_transformation.Weight();
-    mfem::AddMult(B_, sigma_, output_residual_matrix_);
+  // Evaluate the Cauchy stress at all integration points at once, so that materials can batch their updates
+  material_.evalStresses(*ir, du_dX_points_, sigma_points_);
+
+  // Accumulate the residual using the Cauchy stress and the B matrix
+  output_residual_matrix_ = 0.0;
+  for (int i = 0; i < num_points; i++) {
+    sigma_points_(i) *= weights_(i);
+    mfem::AddMult(B_points_(i), sigma_points_(i), output_residual_matrix_);
   }
 }
 
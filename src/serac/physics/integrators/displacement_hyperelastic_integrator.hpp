@@ -147,6 +147,30 @@ private:
    */
   mfem::DenseMatrix sigma_;
 
+  /**
+   * @brief The displacement gradient at each integration point of an element
+   *
+   */
+  mfem::DenseTensor du_dX_points_;
+
+  /**
+   * @brief The B matrix at each integration point of an element
+   *
+   */
+  mfem::DenseTensor B_points_;
+
+  /**
+   * @brief The Cauchy stress at each integration point of an element
+   *
+   */
+  mfem::DenseTensor sigma_points_;
+
+  /**
+   * @brief The integration weight times the Jacobian determinants at each integration point of an element
+   *
+   */
+  mfem::Vector weights_;
+
   /**
    * @brief Current input state dofs (dof x dim)
    *
@@ -8,45 +8,77 @@
 
 namespace serac::mfem_ext {
 
-void NonlinearReactionIntegrator::AssembleElementVector(const mfem::FiniteElement&   element,
-                                                        mfem::ElementTransformation& parent_to_reference_transformation,
-                                                        const mfem::Vector& state_vector, mfem::Vector& residual_vector)
+ReactionEvaluation batchReaction(std::function<double(double)> reaction, std::function<double(double)> d_reaction)
 {
-  int dof = element.GetDof();
-
-  // Ensure the data containers are properly sized
-  shape_.SetSize(dof);
-  residual_vector.SetSize(dof);
-
-  // Initialize the residual
-  residual_vector = 0.0;
+  return [reaction, d_reaction](const mfem::Vector& temperatures, mfem::Vector& reactions, mfem::Vector* d_reactions) {
+    for (int i = 0; i < temperatures.Size(); i++) {
+      reactions(i) = reaction(temperatures(i));
+    }
+    if (d_reactions) {
+      for (int i = 0; i < temperatures.Size(); i++) {
+        (*d_reactions)(i) = d_reaction(temperatures(i));
+      }
+    }
+  };
+}
 
+void NonlinearReactionIntegrator::evaluateQuadraturePoints(
+    const mfem::FiniteElement& element, mfem::ElementTransformation& parent_to_reference_transformation,
+    const mfem::Vector& state_vector, const bool with_derivative)
+{
   // Determine the integration rule from the element order
   const mfem::IntegrationRule* ir = IntRule;
   if (ir == nullptr) {
     ir = &mfem::IntRules.Get(element.GetGeomType(), 2 * element.GetOrder() + 3);
   }
 
-  for (int i = 0; i < ir->GetNPoints(); i++) {
-    // Set the integration point
-    const mfem::IntegrationPoint& ip = ir->IntPoint(i);
-    parent_to_reference_transformation.SetIntPoint(&ip);
+  const int dof        = element.GetDof();
+  const int num_points = ir->GetNPoints();
+
+  // The shape functions only depend on the reference element, so they are tabulated once per element type
+  if (tabulated_.first != &element || tabulated_.second != ir) {
+    shape_.SetSize(dof);
+    shapes_.SetSize(dof, num_points);
+    for (int i = 0; i < num_points; i++) {
+      element.CalcShape(ir->IntPoint(i), shape_);
+      shapes_.SetCol(i, shape_);
+    }
+    tabulated_ = {&element, ir};
+  }
 
-    // Calculate the shape functions in the reference space
-    element.CalcShape(ip, shape_);
+  // Calculate the temperature at all integration points
+  temperatures_.SetSize(num_points);
+  shapes_.MultTranspose(state_vector, temperatures_);
 
-    // Calculate the temperature at the integration point
-    double temp = shape_ * state_vector;
+  // Evaluate the integration weights and the scaling coefficient
+  weights_.SetSize(num_points);
+  for (int i = 0; i < num_points; i++) {
+    const mfem::IntegrationPoint& ip = ir->IntPoint(i);
+    parent_to_reference_transformation.SetIntPoint(&ip);
+    weights_(i) = ip.weight * parent_to_reference_transformation.Weight() *
+                  scale_.Eval(parent_to_reference_transformation, ip);
+  }
 
-    // Evaluate the scaling coefficent
-    double scale = scale_.Eval(parent_to_reference_transformation, ip);
+  // Calculate the reaction term, and its derivative if requested, from the current temperatures
+  reactions_.SetSize(num_points);
+  if (with_derivative) {
+    d_reactions_.SetSize(num_points);
+  }
+  reaction_(temperatures_, reactions_, with_derivative ? &d_reactions_ : nullptr);
+}
 
-    // Calculate the reaction term from the current temperature
-    double source = reaction_(temp);
+void NonlinearReactionIntegrator::AssembleElementVector(const mfem::FiniteElement&   element,
+                                                        mfem::ElementTransformation& parent_to_reference_transformation,
+                                                        const mfem::Vector& state_vector, mfem::Vector& residual_vector)
+{
+  evaluateQuadraturePoints(element, parent_to_reference_transformation, state_vector, false);
 
-    // Accumulate the residual contribution
-    residual_vector.Add(ip.weight * parent_to_reference_transformation.Weight() * source * scale, shape_);
+  // Accumulate the residual contributions of all integration points at once
+  for (int i = 0; i < reactions_.Size(); i++) {
+    reactions_(i) *= weights_(i);
   }
+  residual_vector.SetSize(element.GetDof());
+  shapes_.Mult(reactions_, residual_vector);
 }
 
 void NonlinearReactionIntegrator::AssembleElementGrad(const mfem::FiniteElement&   element,
@@ -54,42 +86,14 @@ void NonlinearReactionIntegrator::AssembleElementGrad(const mfem::FiniteElement&
                                                       const mfem::Vector&          state_vector,
                                                       mfem::DenseMatrix&           stiffness_matrix)
 {
-  int dof = element.GetDof();
-
-  // Ensure the data containers are properly sized
-  shape_.SetSize(dof);
-  stiffness_matrix.SetSize(dof);
-
-  // Initialize the stiffness matrix
-  stiffness_matrix = 0.0;
-
-  // Determine the integration rule from the order of the element
-  const mfem::IntegrationRule* ir = IntRule;
-  if (ir == nullptr) {
-    ir = &mfem::IntRules.Get(element.GetGeomType(), 2 * element.GetOrder() + 3);
-  }
-
-  for (int i = 0; i < ir->GetNPoints(); i++) {
-    // Set the current integration point
-    const mfem::IntegrationPoint& ip = ir->IntPoint(i);
-    parent_to_reference_transformation.SetIntPoint(&ip);
-
-    // Calculate the shape functions in the reference space
-    element.CalcShape(ip, shape_);
-
-    // Calculate the temperature at the current integration point
-    double temp = shape_ * state_vector;
-
-    // Evaluate the scaling coefficent
-    double scale = scale_.Eval(parent_to_reference_transformation, ip);
-
-    // Calculate the derivative of the nonlinear reaction at the current integration point
-    double d_source = d_reaction_(temp);
+  evaluateQuadraturePoints(element, parent_to_reference_transformation, state_vector, true);
 
-    // Accumulate the stiffness matrix contributions
-    mfem::AddMult_a_VVt(d_source * scale * ip.weight * parent_to_reference_transformation.Weight(), shape_,
-                        stiffness_matrix);
+  // Accumulate the stiffness matrix contributions of all integration points at once
+  for (int i = 0; i < d_reactions_.Size(); i++) {
+    d_reactions_(i) *= weights_(i);
   }
+  stiffness_matrix.SetSize(element.GetDof());
+  mfem::MultADAt(shapes_, d_reactions_, stiffness_matrix);
 }
 
 }  // namespace serac::mfem_ext
@@ -15,12 +15,63 @@
 #include "mfem.hpp"
 
 #include <functional>
+#include <type_traits>
+
+#include "serac/physics/utilities/functional/dual.hpp"
 
 namespace serac::mfem_ext {
 
+/**
+ * @brief Evaluates a reaction q = q(T) at all quadrature points of an element at once
+ *
+ * The first argument holds the temperature at each quadrature point, the reaction at each point is written to the
+ * second argument, and its derivative dq/dT to the third argument unless it is null.
+ */
+using ReactionEvaluation = std::function<void(const mfem::Vector&, mfem::Vector&, mfem::Vector*)>;
+
+/**
+ * @brief Batches a reaction and its hand-coded derivative
+ *
+ * @param[in] reaction a function describing the nonlinear reaction term q = q(T)
+ * @param[in] d_reaction a function describing the derivative of the reaction dq = dq(T) / dT
+ * @return The batched evaluation of the reaction
+ */
+ReactionEvaluation batchReaction(std::function<double(double)> reaction, std::function<double(double)> d_reaction);
+
+/**
+ * @brief Batches a reaction whose derivative is computed with dual numbers
+ *
+ * @tparam Reaction A callable that accepts both a double and a dual<double> temperature, e.g. a generic lambda
+ * @param[in] reaction The nonlinear reaction term q = q(T)
+ * @return The batched evaluation of the reaction
+ *
+ * @note The callable is inlined into the loop over the quadrature points, so a batch costs one indirect call
+ */
+template <typename Reaction>
+ReactionEvaluation batchReaction(Reaction reaction)
+{
+  static_assert(std::is_invocable_v<Reaction, double> && std::is_invocable_v<Reaction, dual<double>>,
+                "The reaction must be callable with both double and dual<double> temperatures");
+  return [reaction](const mfem::Vector& temperatures, mfem::Vector& reactions, mfem::Vector* d_reactions) {
+    if (d_reactions) {
+      for (int i = 0; i < temperatures.Size(); i++) {
+        auto q            = reaction(make_dual(temperatures(i)));
+        reactions(i)      = q.value;
+        (*d_reactions)(i) = q.gradient;
+      }
+    } else {
+      for (int i = 0; i < temperatures.Size(); i++) {
+        reactions(i) = reaction(temperatures(i));
+      }
+    }
+  };
+}
+
 /**
  * @brief Integrator describing a nonlinear scalar reaction in the thermal conduction equation
  *
+ * The reaction is evaluated at all quadrature points of an element in one batch, and the shape functions of each
+ * element type are tabulated once and reused across elements.
  */
 class NonlinearReactionIntegrator : public mfem::NonlinearFormIntegrator {
 public:
@@ -33,9 +84,21 @@ public:
    */
   explicit NonlinearReactionIntegrator(std::function<double(double)> reaction, std::function<double(double)> d_reaction,
                                        mfem::Coefficient& scale)
-      : reaction_(reaction), d_reaction_(d_reaction), scale_(scale)
+      : NonlinearReactionIntegrator(batchReaction(reaction, d_reaction), scale)
+  {
+  }
+
+  /**
+   * @brief The constructor for the Nonlinear Reaction Integrator from a batched reaction
+   *
+   * @param[in] reaction the batched evaluation of the reaction and its derivative, see batchReaction
+   * @param[in] scale a coefficient for the reaction term
+   */
+  NonlinearReactionIntegrator(ReactionEvaluation reaction, mfem::Coefficient& scale)
+      : reaction_(std::move(reaction)), scale_(scale)
   {
   }
+
   NonlinearReactionIntegrator() = delete;
 
   /**
@@ -64,16 +127,22 @@ public:
 
 private:
   /**
-   * @brief the reaction function q = q(T)
+   * @brief Evaluate the temperature, the quadrature weights, and the reaction at all quadrature points of an element
    *
+   * @param[in] element The finite element to integrate
+   * @param[in] parent_to_reference_transformation The element transformation operators
+   * @param[in] state_vector The state vector of the element
+   * @param[in] with_derivative Whether to evaluate the derivative of the reaction
    */
-  std::function<double(double)> reaction_;
+  void evaluateQuadraturePoints(const mfem::FiniteElement&   element,
+                                mfem::ElementTransformation& parent_to_reference_transformation,
+                                const mfem::Vector& state_vector, const bool with_derivative);
 
   /**
-   * @brief the derivative of the reaction function dq = dq(T)/dT
+   * @brief the batched reaction function q = q(T) and its derivative
    *
    */
-  std::function<double(double)> d_reaction_;
+  ReactionEvaluation reaction_;
 
   /**
    * @brief a scaling coefficient for the reaction
@@ -81,11 +150,47 @@ private:
    */
   mfem::Coefficient& scale_;
 
+  /**
+   * @brief The element and integration rule that shapes_ was tabulated for
+   *
+   */
+  std::pair<const mfem::FiniteElement*, const mfem::IntegrationRule*> tabulated_ = {nullptr, nullptr};
+
+  /**
+   * @brief The shape functions at each quadrature point, one column per point
+   *
+   */
+  mfem::DenseMatrix shapes_;
+
   /**
    * @brief a working vector containing shape function evaluations
    *
    */
-  mutable mfem::Vector shape_;
+  mfem::Vector shape_;
+
+  /**
+   * @brief The temperature at each quadrature point
+   *
+   */
+  mfem::Vector temperatures_;
+
+  /**
+   * @brief The quadrature weight times the Jacobian determinant and scale at each quadrature point
+   *
+   */
+  mfem::Vector weights_;
+
+  /**
+   * @brief The reaction at each quadrature point
+   *
+   */
+  mfem::Vector reactions_;
+
+  /**
+   * @brief The derivative of the reaction at each quadrature point
+   *
+   */
+  mfem::Vector d_reactions_;
 };
 
 }  // namespace serac::mfem_ext
@@ -6,6 +6,8 @@
 
 #include "serac/physics/integrators/wrapper_integrator.hpp"
 
+#include <algorithm>
+
 namespace serac::mfem_ext {
 
 LinearToNonlinearFormIntegrator::LinearToNonlinearFormIntegrator(std::shared_ptr<mfem::LinearFormIntegrator> f,
@@ -32,26 +34,107 @@ void LinearToNonlinearFormIntegrator::AssembleElementGrad(const mfem::FiniteElem
   elmat = 0.;
 }
 
-BilinearToNonlinearFormIntegrator::BilinearToNonlinearFormIntegrator(std::shared_ptr<mfem::BilinearFormIntegrator> A)
-    : A_(A)
+BilinearToNonlinearFormIntegrator::BilinearToNonlinearFormIntegrator(std::shared_ptr<mfem::BilinearFormIntegrator> A,
+                                                                     const ElementMatrixStorage storage)
+    : A_(A), storage_(storage)
+{
+}
+
+const double* BilinearToNonlinearFormIntegrator::elementMatrix(const mfem::FiniteElement&   el,
+                                                               mfem::ElementTransformation& Tr)
+{
+  const auto element = static_cast<std::size_t>(Tr.ElementNo);
+  if (element >= element_offsets_.size()) {
+    element_offsets_.resize(element + 1, -1);
+    element_sizes_.resize(element + 1, 0);
+  }
+
+  if (element_offsets_[element] < 0) {
+    A_->AssembleElementMatrix(el, Tr, elmat_);
+    const int n               = elmat_.Height();
+    element_offsets_[element] = static_cast<std::ptrdiff_t>(element_matrices_.size());
+    element_sizes_[element]   = n;
+
+    if (storage_ == ElementMatrixStorage::Full) {
+      element_matrices_.insert(element_matrices_.end(), elmat_.Data(), elmat_.Data() + n * n);
+    } else {
+      // Pack the upper triangle row by row, averaging with the lower triangle to remove roundoff asymmetry
+      for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++) {
+          element_matrices_.push_back(0.5 * (elmat_(i, j) + elmat_(j, i)));
+        }
+      }
+    }
+  }
+  return element_matrices_.data() + element_offsets_[element];
+}
+
+void BilinearToNonlinearFormIntegrator::invalidateElementMatrices()
 {
+  element_matrices_.clear();
+  element_offsets_.clear();
+  element_sizes_.clear();
 }
 
 void BilinearToNonlinearFormIntegrator::AssembleElementVector(const mfem::FiniteElement&   el,
                                                               mfem::ElementTransformation& Tr,
                                                               const mfem::Vector& elfun, mfem::Vector& elvect)
 {
-  mfem::DenseMatrix elmat;
-  A_->AssembleElementMatrix(el, Tr, elmat);
-  elvect.SetSize(elmat.Height());
-  elmat.Mult(elfun, elvect);
+  if (storage_ == ElementMatrixStorage::None || Tr.ElementType != mfem::ElementTransformation::ELEMENT) {
+    A_->AssembleElementMatrix(el, Tr, elmat_);
+    elvect.SetSize(elmat_.Height());
+    elmat_.Mult(elfun, elvect);
+    return;
+  }
+
+  const double* matrix = elementMatrix(el, Tr);
+  const int     n      = element_sizes_[static_cast<std::size_t>(Tr.ElementNo)];
+  elvect.SetSize(n);
+
+  if (storage_ == ElementMatrixStorage::Full) {
+    // Column-major, as stored by mfem::DenseMatrix
+    elvect = 0.0;
+    for (int j = 0; j < n; j++) {
+      const double x_j = elfun(j);
+      for (int i = 0; i < n; i++) {
+        elvect(i) += matrix[i + j * n] * x_j;
+      }
+    }
+  } else {
+    elvect = 0.0;
+    for (int i = 0; i < n; i++) {
+      elvect(i) += *matrix++ * elfun(i);
+      for (int j = i + 1; j < n; j++) {
+        const double a_ij = *matrix++;
+        elvect(i) += a_ij * elfun(j);
+        elvect(j) += a_ij * elfun(i);
+      }
+    }
+  }
 }
 
 void BilinearToNonlinearFormIntegrator::AssembleElementGrad(const mfem::FiniteElement&   el,
                                                             mfem::ElementTransformation& Tr, const mfem::Vector&,
                                                             mfem::DenseMatrix&           elmat)
 {
-  A_->AssembleElementMatrix(el, Tr, elmat);
+  if (storage_ == ElementMatrixStorage::None || Tr.ElementType != mfem::ElementTransformation::ELEMENT) {
+    A_->AssembleElementMatrix(el, Tr, elmat);
+    return;
+  }
+
+  const double* matrix = elementMatrix(el, Tr);
+  const int     n      = element_sizes_[static_cast<std::size_t>(Tr.ElementNo)];
+  elmat.SetSize(n);
+
+  if (storage_ == ElementMatrixStorage::Full) {
+    std::copy(matrix, matrix + n * n, elmat.Data());
+  } else {
+    for (int i = 0; i < n; i++) {
+      for (int j = i; j < n; j++) {
+        elmat(i, j) = elmat(j, i) = *matrix++;
+      }
+    }
+  }
 }
 
 MixedBilinearToNonlinearFormIntegrator::MixedBilinearToNonlinearFormIntegrator(
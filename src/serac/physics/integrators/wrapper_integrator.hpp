@@ -14,6 +14,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "mfem.hpp"
 
@@ -67,6 +68,16 @@ private:
   const mfem::ParFiniteElementSpace& trial_fes_;
 };
 
+/**
+ * @brief How the element matrices of a wrapped bilinear integrator are kept between assemblies
+ */
+enum class ElementMatrixStorage
+{
+  None,      /**< Reassemble the element matrix on every evaluation */
+  Full,      /**< Keep every entry of the element matrices after their first assembly */
+  Symmetric  /**< Keep the upper triangle of the (symmetrized) element matrices after their first assembly */
+};
+
 /**
  * @brief A class to convert bilinearform integrators into a nonlinear residual-based one
  */
@@ -76,8 +87,15 @@ public:
    * @brief Recasts, A(u) = F as R(u) = A(u) - F
    *
    * @param[in] A A BilinearFormIntegrator
+   * @param[in] storage Whether to keep the element matrices after their first assembly. As the residual of a
+   * bilinear integrator is linear, this turns each residual evaluation into a small matrix-vector product per
+   * element. The kept matrices must be discarded with invalidateElementMatrices() whenever the mesh or the
+   * coefficients of the integrator change.
+   *
+   * @pre Symmetric storage requires a symmetric integrator, e.g. mfem::DiffusionIntegrator with a scalar coefficient
    */
-  explicit BilinearToNonlinearFormIntegrator(std::shared_ptr<mfem::BilinearFormIntegrator> A);
+  explicit BilinearToNonlinearFormIntegrator(
+      std::shared_ptr<mfem::BilinearFormIntegrator> A, const ElementMatrixStorage storage = ElementMatrixStorage::None);
 
   /**
    * @brief Compute the residual vector
@@ -100,12 +118,61 @@ public:
   virtual void AssembleElementGrad(const mfem::FiniteElement& el, mfem::ElementTransformation& Tr,
                                    const mfem::Vector& elfun, mfem::DenseMatrix& elmat);
 
+  /**
+   * @brief Discard the kept element matrices so they are reassembled on their next use
+   */
+  void invalidateElementMatrices();
+
+  /**
+   * @brief Returns the size of the kept element matrices and their offsets in bytes
+   */
+  std::size_t elementMatrixBytes() const
+  {
+    return element_matrices_.capacity() * sizeof(double) + element_offsets_.capacity() * sizeof(std::ptrdiff_t) +
+           element_sizes_.capacity() * sizeof(int);
+  }
+
 private:
+  /**
+   * @brief Returns the kept entries of the element matrix of the element of a transformation, assembling them if needed
+   *
+   * @param[in] el The finite element for local integration
+   * @param[in] Tr The local FE transformation
+   * @return A pointer to the entries, column-major for full storage and row-major upper triangular for symmetric
+   * storage
+   */
+  const double* elementMatrix(const mfem::FiniteElement& el, mfem::ElementTransformation& Tr);
+
   /**
    * @brief The bilinear form to wrap
    *
    */
   std::shared_ptr<mfem::BilinearFormIntegrator> A_;
+
+  /**
+   * @brief How the element matrices are kept
+   */
+  ElementMatrixStorage storage_;
+
+  /**
+   * @brief The kept entries of all element matrices, stored one element after another
+   */
+  std::vector<double> element_matrices_;
+
+  /**
+   * @brief The offset into element_matrices_ of each element, or -1 if the element's matrix has not been assembled
+   */
+  std::vector<std::ptrdiff_t> element_offsets_;
+
+  /**
+   * @brief The number of rows of each kept element matrix
+   */
+  std::vector<int> element_sizes_;
+
+  /**
+   * @brief Scratch space for assembling an element matrix
+   */
+  mfem::DenseMatrix elmat_;
 };
 
 /**
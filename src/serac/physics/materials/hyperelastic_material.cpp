@@ -13,6 +13,17 @@
 
 namespace serac {
 
+void HyperelasticMaterial::evalStresses(const mfem::IntegrationRule& ir, const mfem::DenseTensor& du_dX,
+                                        mfem::DenseTensor& sigma) const
+{
+  sigma.SetSize(du_dX.SizeI(), du_dX.SizeJ(), ir.GetNPoints());
+  for (int i = 0; i < ir.GetNPoints(); i++) {
+    // The coefficients are evaluated at the current integration point
+    parent_to_reference_transformation_->SetIntPoint(&ir.IntPoint(i));
+    evalStress(du_dX(i), sigma(i));
+  }
+}
+
 inline void NeoHookeanMaterial::EvalCoeffs() const
 {
   mu_   = c_mu_->Eval(*parent_to_reference_transformation_, parent_to_reference_transformation_->GetIntPoint());
@@ -59,6 +59,17 @@ public:
    */
   virtual void evalStress(const mfem::DenseMatrix& du_dX, mfem::DenseMatrix& sigma) const = 0;
 
+  /**
+   * @brief Evaluate the Cauchy stress at all points of an integration rule at once
+   *
+   * @param[in] ir The integration rule of the element
+   * @param[in] du_dX The displacement gradient at each point
+   * @param[out] sigma The evaluated Cauchy stress at each point
+   * @note The default evaluates the points one at a time with evalStress
+   */
+  virtual void evalStresses(const mfem::IntegrationRule& ir, const mfem::DenseTensor& du_dX,
+                            mfem::DenseTensor& sigma) const;
+
   /**
    * @brief Evaluate the derivative of the 1st Piola-Kirchhoff stress tensor in Voigt notation
    * and assemble its contribution to the local gradient matrix 'A'.
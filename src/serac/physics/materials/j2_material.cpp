@@ -0,0 +1,278 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/materials/j2_material.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/serac_config.hpp"
+
+namespace serac {
+
+namespace {
+
+/**
+ * @brief The identity tensor
+ */
+constexpr auto I = Identity<3>();
+
+/**
+ * @brief The index of the first double of a member of the state, see QuadratureData::component
+ */
+constexpr int BETA          = offsetof(J2Material::State, beta) / sizeof(double);
+constexpr int EL_STRAIN     = offsetof(J2Material::State, el_strain) / sizeof(double);
+constexpr int PL_STRAIN     = offsetof(J2Material::State, pl_strain) / sizeof(double);
+constexpr int PL_STRAIN_INC = offsetof(J2Material::State, pl_strain_inc) / sizeof(double);
+constexpr int Q             = offsetof(J2Material::State, q) / sizeof(double);
+
+/**
+ * @brief Returns the displacement gradient as a 3x3 tensor, with zero out-of-plane components in 2D
+ * @param[in] du_dX The displacement gradient
+ */
+tensor<double, 3, 3> displacementGradient(const mfem::DenseMatrix& du_dX)
+{
+  tensor<double, 3, 3> H{};
+  for (int i = 0; i < du_dX.Height(); i++) {
+    for (int j = 0; j < du_dX.Width(); j++) {
+      H[i][j] = du_dX(i, j);
+    }
+  }
+  return H;
+}
+
+/**
+ * @brief Returns the Green-Lagrange strain of a displacement gradient
+ * @param[in] H The displacement gradient, either of doubles or of dual numbers
+ */
+template <typename T>
+auto greenLagrangeStrain(const T& H)
+{
+  return 0.5 * (H + transpose(H) + dot(transpose(H), H));
+}
+
+/**
+ * @brief Returns the Cauchy stress corresponding to a second Piola-Kirchhoff stress
+ * @param[in] H The displacement gradient
+ * @param[in] S The second Piola-Kirchhoff stress
+ */
+tensor<double, 3, 3> pushForward(const tensor<double, 3, 3>& H, const tensor<double, 3, 3>& S)
+{
+  const auto F = I + H;
+  return dot(dot(F, S), transpose(F)) / det(F);
+}
+
+}  // namespace
+
+void J2Material::evalStress(const mfem::DenseMatrix& du_dX, mfem::DenseMatrix& sigma) const
+{
+  const int element = parent_to_reference_transformation_->ElementNo;
+  const int point   = parent_to_reference_transformation_->GetIntPoint().index;
+  const int dim     = du_dX.Width();
+
+  const auto           H     = displacementGradient(du_dX);
+  State                state = state_.committed(element, point);
+  tensor<double, 3, 3> stress_tensor;
+  if (finite_strain_) {
+    stress_tensor = pushForward(H, stress(parameters_, greenLagrangeStrain(H), state));
+  } else {
+    stress_tensor = stress(parameters_, sym(H), state);
+  }
+  state_.set(element, point, state);
+
+  sigma.SetSize(dim);
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      sigma(i, j) = stress_tensor[i][j];
+    }
+  }
+}
+
+void J2Material::evalStresses(const mfem::IntegrationRule& ir, const mfem::DenseTensor& du_dX,
+                              mfem::DenseTensor& sigma) const
+{
+  const int dim        = du_dX.SizeI();
+  const int num_points = ir.GetNPoints();
+  SLIC_ERROR_IF(num_points != state_.pointsPerElement(),
+                fmt::format("The J2 material state has {0} points per element, the integration rule has {1}",
+                            state_.pointsPerElement(), num_points));
+  sigma.SetSize(dim, dim, num_points);
+
+  const auto& [K, G, Hi, Hk, sigma_y] = parameters_;
+  const double sqrt_3_2               = std::sqrt(3.0 / 2.0);
+  const double sqrt_6_G               = std::sqrt(6.0) * G;
+  const double sqrt_2_3_Hk            = std::sqrt(2.0 / 3.0) * Hk;
+
+  // The points of an element are contiguous in each component of the state, and the return mapping below has no
+  // branches that depend on the point, so the loop can be vectorized
+  const int first = parent_to_reference_transformation_->ElementNo * num_points;
+  for (int i = 0; i < num_points; i++) {
+    const int point = first + i;
+
+    tensor<double, 3, 3> H{};
+    for (int r = 0; r < dim; r++) {
+      for (int c = 0; c < dim; c++) {
+        H[r][c] = du_dX(r, c, i);
+      }
+    }
+    const auto strain = finite_strain_ ? greenLagrangeStrain(H) : sym(H);
+
+    tensor<double, 3, 3> beta;
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        beta[r][c] = state_.committedComponent(BETA + 3 * r + c)[point];
+      }
+    }
+    const double pl_strain = state_.committedComponent(PL_STRAIN)[point];
+
+    // (i) elastic predictor
+    const double p        = K * tr(strain);
+    auto         s        = 2.0 * G * dev(strain);
+    const auto   eta      = s - beta;
+    const double norm_eta = norm(eta);
+    const double q        = sqrt_3_2 * norm_eta;
+
+    // (ii) admissibility, the increment vanishes for an elastic step
+    const double pl_strain_inc = std::max(0.0, (q - (sigma_y + Hi * pl_strain)) / (3.0 * G + Hk + Hi));
+
+    // (iii) return mapping
+    const auto n = eta * ((norm_eta > 0.0) ? 1.0 / norm_eta : 0.0);
+    s            = s - sqrt_6_G * pl_strain_inc * n;
+    beta         = beta + sqrt_2_3_Hk * pl_strain_inc * n;
+
+    const auto el_strain = s / (2.0 * G) + (p / (3.0 * K)) * I;
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        state_.component(BETA + 3 * r + c)[point]      = beta[r][c];
+        state_.component(EL_STRAIN + 3 * r + c)[point] = el_strain[r][c];
+      }
+    }
+    state_.component(PL_STRAIN)[point]     = pl_strain + pl_strain_inc;
+    state_.component(PL_STRAIN_INC)[point] = pl_strain_inc;
+    state_.component(Q)[point]             = q;
+
+    const auto stress_tensor = finite_strain_ ? pushForward(H, s + p * I) : s + p * I;
+    for (int r = 0; r < dim; r++) {
+      for (int c = 0; c < dim; c++) {
+        sigma(r, c, i) = stress_tensor[r][c];
+      }
+    }
+  }
+}
+
+void J2Material::evalTangentStiffness(const mfem::DenseMatrix& du_dX, serac::mfem_ext::Array4D<double>& C) const
+{
+  const int element = parent_to_reference_transformation_->ElementNo;
+  const int point   = parent_to_reference_transformation_->GetIntPoint().index;
+  const int dim     = du_dX.Width();
+  C.SetSize(dim, dim, dim, dim);
+
+  // The tangent is consistent with the return mapping from the committed state
+  const auto                 H     = displacementGradient(du_dX);
+  State                      state = state_.committed(element, point);
+  tensor<double, 3, 3, 3, 3> c;
+
+  if (finite_strain_) {
+#ifdef SERAC_USE_J2_AD_TANGENT
+    // c_ijkl = (d tau_ij / d F_km) F_lm, where the Kirchhoff stress is tau = F S F^T
+    const auto dH      = make_dual(H);
+    const auto F       = I + dH;
+    const auto tau     = dot(dot(F, stress(parameters_, greenLagrangeStrain(dH), state)), transpose(F));
+    const auto dtau_dF = get_gradient(tau);
+    const auto F_value = I + H;
+    c                  = make_tensor<3, 3, 3, 3>([&](auto i, auto j, auto k, auto l) {
+      double c_ijkl = 0.0;
+      for (int m = 0; m < 3; m++) {
+        c_ijkl += dtau_dF[i][j][k][m] * F_value[l][m];
+      }
+      return c_ijkl;
+    });
+#else
+    // Push the material tangent forward and add the terms from the variation of F in tau = F S F^T
+    const auto F   = I + H;
+    const auto S   = stress(parameters_, greenLagrangeStrain(H), state);
+    const auto tau = dot(dot(F, S), transpose(F));
+    const auto dS  = tangent(parameters_, state);
+
+    tensor<double, 3, 3, 3, 3> dS_FF{};
+    for (int a = 0; a < 3; a++) {
+      for (int b = 0; b < 3; b++) {
+        for (int k = 0; k < 3; k++) {
+          for (int l = 0; l < 3; l++) {
+            for (int m = 0; m < 3; m++) {
+              for (int n = 0; n < 3; n++) {
+                dS_FF[a][b][k][l] += dS[a][b][m][n] * F[k][m] * F[l][n];
+              }
+            }
+          }
+        }
+      }
+    }
+    c = make_tensor<3, 3, 3, 3>([&](auto i, auto j, auto k, auto l) {
+      double c_ijkl = (i == k) * tau[l][j] + (j == k) * tau[i][l];
+      for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+          c_ijkl += F[i][a] * F[j][b] * dS_FF[a][b][k][l];
+        }
+      }
+      return c_ijkl;
+    });
+#endif
+  } else {
+    c = smallStrainStressAndTangent(parameters_, H, state).second;
+  }
+
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      for (int k = 0; k < dim; k++) {
+        for (int l = 0; l < dim; l++) {
+          C(i, j, k, l) = c[i][j][k][l];
+        }
+      }
+    }
+  }
+}
+
+std::pair<tensor<double, 3, 3>, tensor<double, 3, 3, 3, 3>> J2Material::smallStrainStressAndTangent(
+    const Parameters& parameters, const tensor<double, 3, 3>& du_dX, State& state)
+{
+#ifdef SERAC_USE_J2_AD_TANGENT
+  // Differentiating through sym() gives the tangent with minor symmetries, like the hand-coded one
+  const auto stress_and_tangent = stress(parameters, sym(make_dual(du_dX)), state);
+  return {get_value(stress_and_tangent), get_gradient(stress_and_tangent)};
+#else
+  const auto sigma = stress(parameters, sym(du_dX), state);
+  return {sigma, tangent(parameters, state)};
+#endif
+}
+
+tensor<double, 3, 3, 3, 3> J2Material::tangent(const Parameters& parameters, const State& state)
+{
+  const auto& [K, G, Hi, Hk, sigma_y] = parameters;
+
+  double A1 = 2.0 * G;
+  double A2 = 0.0;
+
+  tensor<double, 3, 3> N{};
+
+  if (state.pl_strain_inc > 0.0) {
+    tensor<double, 3, 3> s = 2.0 * G * dev(state.el_strain);
+    N                      = normalize(s - state.beta);
+
+    A1 -= 6 * G * G * state.pl_strain_inc / state.q;
+    A2 = 6 * G * G * ((state.pl_strain_inc / state.q) - (1.0 / (3.0 * G + Hi + Hk)));
+  }
+
+  return make_tensor<3, 3, 3, 3>([&](auto i, auto j, auto k, auto l) {
+    double I4    = (i == j) * (k == l);
+    double I4sym = 0.5 * ((i == k) * (j == l) + (i == l) * (j == k));
+    double I4dev = I4sym - (i == j) * (k == l) / 3.0;
+    return K * I4 + A1 * I4dev + A2 * N[i][j] * N[k][l];
+  });
+}
+
+}  // namespace serac
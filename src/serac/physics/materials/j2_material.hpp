@@ -0,0 +1,241 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file j2_material.hpp
+ *
+ * @brief J2 plasticity with linear isotropic and kinematic hardening for the solid module
+ */
+
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+#include "mfem.hpp"
+
+#include "serac/physics/materials/hyperelastic_material.hpp"
+#include "serac/physics/utilities/quadrature_data.hpp"
+#include "serac/physics/utilities/functional/tensor.hpp"
+
+namespace serac {
+
+/**
+ * @brief J2 (von Mises) plasticity with linear isotropic and kinematic hardening
+ *
+ * The stress is updated with the radial return algorithm of box 7.5 in "Computational Methods for Plasticity" by
+ * de Souza Neto, Peric, and Owen. With small strains the return mapping is applied to the linearized strain and
+ * gives the Cauchy stress. With finite strains it is applied to the Green-Lagrange strain and gives the second
+ * Piola-Kirchhoff stress, which is pushed forward to the Cauchy stress.
+ *
+ * The internal state at each quadrature point of the solid's integration rule lives in quadrature data, which
+ * must be committed after each converged time step. Two-dimensional meshes are treated as plane strain.
+ *
+ * The consistent tangent is hand-coded unless Serac is configured with SERAC_ENABLE_J2_AD_TANGENT, in which case it
+ * is computed with dual numbers. The benchmark_J2_material benchmark times both.
+ */
+class J2Material : public HyperelasticMaterial {
+public:
+  /**
+   * @brief The material parameters
+   */
+  struct Parameters {
+    /**
+     * @brief Bulk modulus
+     */
+    double K;
+
+    /**
+     * @brief Shear modulus
+     */
+    double G;
+
+    /**
+     * @brief Isotropic hardening modulus
+     */
+    double Hi;
+
+    /**
+     * @brief Kinematic hardening modulus
+     */
+    double Hk;
+
+    /**
+     * @brief Initial yield stress
+     */
+    double sigma_y;
+  };
+
+  /**
+   * @brief The internal state at a quadrature point
+   */
+  struct State {
+    /**
+     * @brief Back-stress tensor
+     */
+    tensor<double, 3, 3> beta;
+
+    /**
+     * @brief Elastic strain
+     */
+    tensor<double, 3, 3> el_strain;
+
+    /**
+     * @brief Accumulated plastic strain
+     */
+    double pl_strain;
+
+    /**
+     * @brief Plastic strain increment of the most recent update
+     */
+    double pl_strain_inc;
+
+    /**
+     * @brief Trial J2 stress of the most recent update
+     */
+    double q;
+  };
+
+  /**
+   * @brief Construct a new J2 material
+   *
+   * @param[in] parameters The material parameters
+   * @param[in] finite_strain Whether the return mapping is applied to the Green-Lagrange strain rather than the
+   * linearized strain
+   * @param[in] state The internal state at each point of the integration rule, which must outlive the material
+   */
+  J2Material(const Parameters& parameters, const bool finite_strain, QuadratureData<State>& state)
+      : parameters_(parameters), finite_strain_(finite_strain), state_(state)
+  {
+  }
+
+  /**
+   * @brief Evaluate the strain energy density function, W = W(F).
+   *
+   * @return Strain energy density
+   */
+  virtual double evalStrainEnergy(const mfem::DenseMatrix&) const
+  {
+    SLIC_ERROR("Strain energy not implemented for the J2 material!");
+    return 0.0;
+  }
+
+  /**
+   * @brief Evaluate the Cauchy stress at the current integration point
+   *
+   * @param[in] du_dX the displacement gradient
+   * @param[out] sigma The evaluated Cauchy stress
+   */
+  virtual void evalStress(const mfem::DenseMatrix& du_dX, mfem::DenseMatrix& sigma) const;
+
+  /**
+   * @brief Evaluate the Cauchy stress at all points of an integration rule, with the return mapping of all points
+   * in a single loop
+   *
+   * @param[in] ir The integration rule of the element
+   * @param[in] du_dX The displacement gradient at each point
+   * @param[out] sigma The evaluated Cauchy stress at each point
+   */
+  virtual void evalStresses(const mfem::IntegrationRule& ir, const mfem::DenseTensor& du_dX,
+                            mfem::DenseTensor& sigma) const;
+
+  /**
+   * @brief Evaluate the derivative of the Kirchoff stress wrt the deformation gradient
+   * and assemble its contribution to the 4D array (spatial elasticity tensor)
+   * @param[in] du_dX the displacement gradient
+   * @param[out] C Tangent moduli 4D Array
+   */
+  virtual void evalTangentStiffness(const mfem::DenseMatrix& du_dX, serac::mfem_ext::Array4D<double>& C) const;
+
+  /**
+   * @brief Destroy the J2 Material object
+   *
+   */
+  virtual ~J2Material() = default;
+
+  /**
+   * @brief Return mapping for a single point, written for both double and dual number strains
+   *
+   * @param[in] parameters The material parameters
+   * @param[in] strain The total strain
+   * @param[inout] state The committed state on input, the updated state on output
+   * @return The stress conjugate to @a strain, with derivatives when @a strain holds dual numbers
+   */
+  template <typename T>
+  static auto stress(const Parameters& parameters, const T& strain, State& state)
+  {
+    using std::sqrt;
+    const auto& [K, G, Hi, Hk, sigma_y] = parameters;
+    constexpr auto I                    = Identity<3>();
+
+    // (i) elastic predictor
+    auto p   = K * tr(strain);
+    auto s   = 2.0 * G * dev(strain);
+    auto eta = s - state.beta;
+    auto q   = sqrt(3.0 / 2.0) * norm(eta);
+    auto phi = q - (sigma_y + Hi * state.pl_strain);
+
+    state.el_strain     = get_value(strain);
+    state.q             = get_value(q);
+    state.pl_strain_inc = 0.0;
+
+    // (ii) admissibility
+    if (phi > 0.0) {
+      // see (7.207) on pg. 261
+      auto pl_strain_inc = phi / (3.0 * G + Hk + Hi);
+
+      // (iii) return mapping
+      s = s - sqrt(6.0) * G * pl_strain_inc * normalize(eta);
+
+      state.pl_strain_inc = get_value(pl_strain_inc);
+      state.pl_strain     = state.pl_strain + state.pl_strain_inc;
+      state.el_strain     = get_value(s) / (2.0 * G) + (get_value(p) / (3.0 * K)) * I;
+      state.beta          = state.beta + sqrt(2.0 / 3.0) * Hk * state.pl_strain_inc * normalize(get_value(eta));
+    }
+
+    return s + p * I;
+  }
+
+  /**
+   * @brief The hand-coded derivative of the stress returned by stress() with respect to the strain
+   *
+   * @param[in] parameters The material parameters
+   * @param[in] state The state after the update
+   * @return The algorithmic tangent moduli
+   */
+  static tensor<double, 3, 3, 3, 3> tangent(const Parameters& parameters, const State& state);
+
+  /**
+   * @brief Return mapping for a single point with small strains, and the consistent tangent of the stress
+   *
+   * The tangent is hand-coded, or computed with dual numbers if Serac is configured with SERAC_ENABLE_J2_AD_TANGENT.
+   *
+   * @param[in] parameters The material parameters
+   * @param[in] du_dX The displacement gradient
+   * @param[inout] state The committed state on input, the updated state on output
+   * @return The Cauchy stress and its derivative with respect to the displacement gradient
+   */
+  static std::pair<tensor<double, 3, 3>, tensor<double, 3, 3, 3, 3>> smallStrainStressAndTangent(
+      const Parameters& parameters, const tensor<double, 3, 3>& du_dX, State& state);
+
+private:
+  /**
+   * @brief The material parameters
+   */
+  Parameters parameters_;
+
+  /**
+   * @brief Whether the return mapping is applied to the Green-Lagrange strain
+   */
+  bool finite_strain_;
+
+  /**
+   * @brief The internal state at each point of the integration rule
+   */
+  QuadratureData<State>& state_;
+};
+
+}  // namespace serac
@@ -6,7 +6,9 @@
 
 #include "serac/physics/solid.hpp"
 
+#include "serac/coefficients/quadrature_cached_coefficient.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/physics/integrators/traction_integrator.hpp"
 #include "serac/physics/integrators/displacement_hyperelastic_integrator.hpp"
 #include "serac/physics/integrators/wrapper_integrator.hpp"
@@ -72,6 +74,11 @@ Solid::Solid(int order, const SolverOptions& options, GeometricNonlinearities ge
 
   zero_.SetSize(true_size);
   zero_ = 0.0;
+
+  if (!is_quasistatic_) {
+    workspace_.u_predicted.SetSize(true_size);
+    workspace_.du_dt_predicted.SetSize(true_size);
+  }
 }
 
 Solid::Solid(const Solid::InputOptions& options, const std::string& name)
@@ -81,6 +88,9 @@ Solid::Solid(const Solid::InputOptions& options, const std::string& name)
   // in the initialization stage
   setMaterialParameters(std::make_unique<mfem::ConstantCoefficient>(options.mu),
                         std::make_unique<mfem::ConstantCoefficient>(options.K), options.material_nonlin);
+  if (options.plasticity) {
+    setPlasticMaterialParameters(*options.plasticity);
+  }
 
   auto dim = mesh_.Dimension();
   if (options.initial_displacement) {
@@ -191,13 +201,43 @@ void Solid::addBodyForce(std::shared_ptr<mfem::VectorCoefficient> ext_force_coef
 }
 
 void Solid::setMaterialParameters(std::unique_ptr<mfem::Coefficient>&& mu, std::unique_ptr<mfem::Coefficient>&& K,
-                                  const bool material_nonlin)
+                                  const bool material_nonlin, const bool depends_on_state)
 {
+  // The material is always evaluated on the reference configuration, so parameters that don't change with the state
+  // only need to be evaluated once per step at each point of the hyperelastic integrator's rule
+  cached_parameters_.clear();
+  if (!depends_on_state) {
+    const int order     = 2 * order_ + 3;
+    auto      cached_mu = std::make_unique<mfem_ext::QuadratureCachedCoefficient>(std::move(mu), mesh_, order);
+    auto      cached_K  = std::make_unique<mfem_ext::QuadratureCachedCoefficient>(std::move(K), mesh_, order);
+    cached_parameters_  = {cached_mu.get(), cached_K.get()};
+    mu                  = std::move(cached_mu);
+    K                   = std::move(cached_K);
+  }
   if (material_nonlin) {
     material_ = std::make_unique<NeoHookeanMaterial>(std::move(mu), std::move(K));
   } else {
     material_ = std::make_unique<LinearElasticMaterial>(std::move(mu), std::move(K));
   }
+
+  // The state of a previous plastic material should no longer be committed or written to restart files
+  if (plastic_state_) {
+    plastic_state_.reset();
+    StateManager::deleteQuadratureData(displacement_.name() + "_plastic_state");
+  }
+}
+
+void Solid::setPlasticMaterialParameters(const J2Material::Parameters& parameters)
+{
+  // The state lives at the points of the rule used by the hyperelastic integrator, and is kept if the parameters of
+  // an existing plastic material are replaced
+  if (!plastic_state_) {
+    const auto& rule = mfem::IntRules.Get(mesh_.GetElementBaseGeometry(0), 2 * order_ + 3);
+    plastic_state_ =
+        StateManager::newQuadratureData<J2Material::State>(displacement_.name() + "_plastic_state", rule.GetNPoints());
+  }
+  material_ = std::make_unique<J2Material>(parameters, geom_nonlin_ == GeometricNonlinearities::On, *plastic_state_);
+  cached_parameters_.clear();
 }
 
 void Solid::setViscosity(std::unique_ptr<mfem::Coefficient>&& visc_coef) { viscosity_ = std::move(visc_coef); }
@@ -319,22 +359,31 @@ void Solid::completeSetup()
 
         // residual function
         [this](const mfem::Vector& d2u_dt2, mfem::Vector& r) {
-          r = (*M_mat_) * d2u_dt2 + (*C_mat_) * (du_dt_ + c1_ * d2u_dt2) + (*H_) * (u_ + c0_ * d2u_dt2);
+          SERAC_PROFILE_SCOPE("Assembly");
+          // r = M * d2u_dt2 + C * (du_dt + c1 * d2u_dt2) + H(u + c0 * d2u_dt2), accumulated without temporaries
+          add(u_, c0_, d2u_dt2, workspace_.u_predicted);
+          add(du_dt_, c1_, d2u_dt2, workspace_.du_dt_predicted);
+          H_->Mult(workspace_.u_predicted, r);
+          C_mat_->Mult(1.0, workspace_.du_dt_predicted, 1.0, r);
+          M_mat_->Mult(1.0, d2u_dt2, 1.0, r);
           r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
         },
 
         // gradient of residual function
         [this](const mfem::Vector& d2u_dt2) -> mfem::Operator& {
+          SERAC_PROFILE_SCOPE("Assembly");
           // J = M + c1 * C + c0 * H(u_predicted)
-          auto localJ = std::unique_ptr<mfem::SparseMatrix>(Add(1.0, M_->SpMat(), c1_, C_->SpMat()));
-          localJ->Add(c0_, H_->GetLocalGradient(u_ + c0_ * d2u_dt2));
-          J_mat_.reset(M_->ParallelAssemble(localJ.get()));
-          bcs_.eliminateAllEssentialDofsFromMatrix(*J_mat_);
-          return *J_mat_;
+          add(u_, c0_, d2u_dt2, workspace_.u_predicted);
+          auto& K = dynamic_cast<mfem::HypreParMatrix&>(H_->GetGradient(workspace_.u_predicted));
+          auto& J = workspace_.jacobian.update({1.0, c1_, c0_}, {M_mat_.get(), C_mat_.get(), &K});
+          bcs_.eliminateAllEssentialDofsFromMatrix(J);
+          profiling::counter("Jacobian assemblies")++;
+          return J;
         });
   }
 
   nonlin_solver_.SetOperator(*residual_);
+  nonlin_solver_.SetEssentialTrueDofs(bcs_.allEssentialDofs());
 }
 
 // Solve the Quasi-static Newton system
@@ -349,14 +398,17 @@ std::unique_ptr<mfem::Operator> Solid::buildQuasistaticOperator()
 
       // residual function
       [this](const mfem::Vector& u, mfem::Vector& r) {
+        SERAC_PROFILE_SCOPE("Assembly");
         H_->Mult(u, r);  // r := H(u)
         r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
       },
 
       // gradient of residual function
       [this](const mfem::Vector& u) -> mfem::Operator& {
+        SERAC_PROFILE_SCOPE("Assembly");
         auto& J = dynamic_cast<mfem::HypreParMatrix&>(H_->GetGradient(u));
         bcs_.eliminateAllEssentialDofsFromMatrix(J);
+        profiling::counter("Jacobian assemblies")++;
         return J;
       });
   return residual;
@@ -374,6 +426,12 @@ void Solid::advanceTimestep(double& dt)
 
   bcs_.setTime(time_);
 
+  // The parameters may depend on the time, or on states that changed since the last step such as the temperature
+  for (auto* parameter : cached_parameters_) {
+    parameter->invalidate();
+    parameter->setTime(time_);
+  }
+
   if (is_quasistatic_) {
     quasiStaticSolve();
     // Update the time for housekeeping purposes
@@ -382,6 +440,15 @@ void Solid::advanceTimestep(double& dt)
     ode2_.Step(displacement_.trueVec(), velocity_.trueVec(), time_, dt);
   }
 
+  // Accept the internal state of a converged step, a failed step is retried from the committed state
+  if (plastic_state_) {
+    if (converged()) {
+      plastic_state_->commit();
+    } else {
+      plastic_state_->rollback();
+    }
+  }
+
   // Distribute the shared DOFs
   velocity_.distributeSharedDofs();
   displacement_.distributeSharedDofs();
@@ -395,6 +462,32 @@ void Solid::advanceTimestep(double& dt)
   cycle_ += 1;
 }
 
+MemoryUsage Solid::memoryUsage() const
+{
+  auto usage = BasePhysics::memoryUsage();
+  if (M_mat_) {
+    usage.add("mass matrix", memory::bytes(*M_mat_));
+  }
+  if (C_mat_) {
+    usage.add("damping matrix", memory::bytes(*C_mat_));
+  }
+  usage.add("Jacobian", workspace_.jacobian.memoryUsage());
+  if (plastic_state_) {
+    usage.add("plastic state", plastic_state_->bytes());
+  }
+  for (const auto* nodes : {reference_nodes_.get(), deformed_nodes_.get()}) {
+    if (nodes) {
+      usage.add("mesh nodes", memory::bytes(*nodes));
+    }
+  }
+  for (const auto* work : {&zero_, &x_, &u_, &du_dt_, &previous_, &workspace_.u_predicted,
+                           &workspace_.du_dt_predicted}) {
+    usage.add("work vectors", memory::bytes(*work));
+  }
+  usage.add("nonlinear solver", nonlin_solver_.memoryUsage());
+  return usage;
+}
+
 void Solid::InputOptions::defineInputFileSchema(axom::inlet::Container& container)
 {
   // Polynomial interpolation order - currently up to 8th order is allowed
@@ -418,6 +511,12 @@ void Solid::InputOptions::defineInputFileSchema(axom::inlet::Container& containe
 
   container.addDouble("density", "Initial mass density").defaultValue(1.0);
 
+  // J2 plasticity parameters, the elastic moduli are mu and K
+  auto& plasticity_container = container.addStruct("plasticity", "J2 plasticity with linear hardening");
+  plasticity_container.addDouble("yield_stress", "Initial yield stress").required();
+  plasticity_container.addDouble("isotropic_hardening", "Isotropic hardening modulus").defaultValue(0.0);
+  plasticity_container.addDouble("kinematic_hardening", "Kinematic hardening modulus").defaultValue(0.0);
+
   auto& equation_solver_container =
       container.addStruct("equation_solver", "Linear and Nonlinear stiffness Solver Parameters.");
   serac::mfem_ext::EquationSolver::DefineInputFileSchema(equation_solver_container);
@@ -521,6 +620,17 @@ serac::Solid::InputOptions FromInlet<serac::Solid::InputOptions>::operator()(con
   // Set the material nonlinearity flag
   result.material_nonlin = base["material_nonlin"];
 
+  if (base.contains("plasticity")) {
+    auto                          plasticity = base["plasticity"];
+    serac::J2Material::Parameters parameters;
+    parameters.K       = result.K;
+    parameters.G       = result.mu;
+    parameters.Hi      = plasticity["isotropic_hardening"];
+    parameters.Hk      = plasticity["kinematic_hardening"];
+    parameters.sigma_y = plasticity["yield_stress"];
+    result.plasticity  = parameters;
+  }
+
   if (base.contains("boundary_conds")) {
     result.boundary_conditions =
         base["boundary_conds"].get<std::unordered_map<std::string, serac::input::BoundaryConditionInputOptions>>();
@@ -13,14 +13,19 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include "mfem.hpp"
 
+#include "serac/coefficients/quadrature_cached_coefficient.hpp"
 #include "serac/infrastructure/input.hpp"
+#include "serac/numerics/assembled_linear_combination.hpp"
 #include "serac/physics/base_physics.hpp"
 #include "serac/physics/operators/odes.hpp"
 #include "serac/physics/operators/stdfunction_operator.hpp"
 #include "serac/physics/materials/hyperelastic_material.hpp"
+#include "serac/physics/materials/j2_material.hpp"
+#include "serac/physics/utilities/quadrature_data.hpp"
 #include "serac/physics/integrators/displacement_hyperelastic_integrator.hpp"
 
 namespace serac {
@@ -157,6 +162,12 @@ public:
      */
     bool material_nonlin;
 
+    /**
+     * @brief The J2 plasticity parameters, which replace the hyperelastic material when given
+     *
+     */
+    std::optional<J2Material::Parameters> plasticity;
+
     /**
      * @brief Boundary condition information
      *
@@ -266,9 +277,21 @@ public:
    * @param[in] mu Set the shear modulus for the solid
    * @param[in] K Set the bulk modulus for the solid
    * @param[in] material_nonlin Flag to include material nonlinearities (linear elastic vs. neo-Hookean model)
+   * @param[in] depends_on_state Whether the parameters change with the state during a timestep, in which case they
+   * are evaluated every time the residual is, otherwise their values at the quadrature points are kept within a step
    */
   void setMaterialParameters(std::unique_ptr<mfem::Coefficient>&& mu, std::unique_ptr<mfem::Coefficient>&& K,
-                             bool material_nonlin = true);
+                             bool material_nonlin = true, bool depends_on_state = false);
+
+  /**
+   * @brief Use J2 plasticity with linear hardening as the material
+   *
+   * @param[in] parameters The material parameters
+   * @note The return mapping uses finite strains when geometric nonlinearities are enabled. The internal state is
+   * registered with the StateManager, so it is written to and read from restart files, until the material is replaced
+   * with setMaterialParameters.
+   */
+  void setPlasticMaterialParameters(const J2Material::Parameters& parameters);
 
   /**
    * @brief Set the initial displacement value
@@ -326,6 +349,34 @@ public:
    */
   void advanceTimestep(double& dt) override;
 
+  /**
+   * @brief Returns whether the most recent nonlinear solve converged
+   *
+   * @return True if the Newton solver converged during the last timestep
+   */
+  bool converged() const override { return nonlin_solver_.NonlinearSolver().GetConverged(); }
+
+  /**
+   * @brief Returns the final norm of the residual of the most recent Newton solve
+   *
+   * @return The nonlinear residual norm
+   */
+  double nonlinearResidualNorm() const override { return nonlin_solver_.NonlinearSolver().GetFinalNorm(); }
+
+  /**
+   * @brief Returns the final residual norm of the most recent linear solve within the Newton solve
+   *
+   * @return The linear residual norm, or zero for a direct solver
+   */
+  double linearResidualNorm() const override { return nonlin_solver_.LinearResidualNorm(); }
+
+  /**
+   * @brief Returns the memory held by the module, including its matrices, nonlinear solver, and work vectors
+   *
+   * @return The memory usage on this rank
+   */
+  MemoryUsage memoryUsage() const override;
+
   /**
    * @brief Destroy the Nonlinear Solid Solver object
    */
@@ -392,6 +443,16 @@ protected:
    */
   std::unique_ptr<HyperelasticMaterial> material_;
 
+  /**
+   * @brief The parameters of material_ whose values at the quadrature points are kept within a step
+   */
+  std::vector<mfem_ext::QuadratureCachedCoefficient*> cached_parameters_;
+
+  /**
+   * @brief The internal state of the plastic material at the points of the hyperelastic integrator's rule
+   */
+  std::optional<QuadratureData<J2Material::State>> plastic_state_;
+
   /**
    * @brief Flag for enabling geometric nonlinearities in the residual calculation
    */
@@ -422,11 +483,6 @@ protected:
    */
   std::unique_ptr<mfem::HypreParMatrix> C_mat_;
 
-  /**
-   * @brief Jacobian (or "effective mass") matrix
-   */
-  std::unique_ptr<mfem::HypreParMatrix> J_mat_;
-
   /**
    * @brief Mass bilinear form object
    */
@@ -485,6 +541,31 @@ protected:
    */
   mfem::Vector previous_;
 
+  /**
+   * @brief Storage reused by the dynamic residual and gradient operators across Newton iterations
+   */
+  struct Workspace {
+    /**
+     * @brief The predicted displacement, u + c0 * d2u_dt2
+     */
+    mfem::Vector u_predicted;
+
+    /**
+     * @brief The predicted velocity, du_dt + c1 * d2u_dt2
+     */
+    mfem::Vector du_dt_predicted;
+
+    /**
+     * @brief The Jacobian (or "effective mass") matrix M + c1 * C + c0 * H'(u_predicted), whose sparsity is kept
+     */
+    mfem_ext::AssembledLinearCombination jacobian;
+  };
+
+  /**
+   * @brief Preallocated intermediate results of the dynamic operators
+   */
+  Workspace workspace_;
+
   /**
    * @brief Current time step
    */
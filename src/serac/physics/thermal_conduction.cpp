@@ -7,6 +7,7 @@
 #include "serac/physics/thermal_conduction.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/expr_template_ops.hpp"
 #include "serac/physics/integrators/nonlinear_reaction_integrator.hpp"
 #include "serac/physics/integrators/wrapper_integrator.hpp"
@@ -27,9 +28,11 @@ ThermalConduction::ThermalConduction(int order, const SolverOptions& options, co
            nonlin_solver_, bcs_)
 {
   state_.push_back(temperature_);
+  cache_element_matrices_ = options.cache_element_matrices;
 
   nonlin_solver_ = mfem_ext::EquationSolver(mesh_.GetComm(), options.T_lin_options, options.T_nonlin_options);
   nonlin_solver_.SetOperator(residual_);
+  nonlin_solver_.SetEssentialTrueDofs(bcs_.allEssentialDofs());
 
   // Check for dynamic mode
   if (options.dyn_options) {
@@ -119,25 +122,46 @@ void ThermalConduction::setFluxBCs(const std::set<int>& flux_bdr, std::shared_pt
   bcs_.addNatural(flux_bdr, flux_bdr_coef, -1);
 }
 
-void ThermalConduction::setConductivity(std::unique_ptr<mfem::Coefficient>&& kappa)
+void ThermalConduction::setConductivity(std::unique_ptr<mfem::Coefficient>&& kappa, bool depends_on_state)
 {
   // Set the conduction coefficient
-  kappa_ = std::move(kappa);
+  kappa_                         = std::move(kappa);
+  conductivity_depends_on_state_ = depends_on_state;
 }
 
-void ThermalConduction::setSource(std::unique_ptr<mfem::Coefficient>&& source)
+void ThermalConduction::setSource(std::unique_ptr<mfem::Coefficient>&& source, bool depends_on_state)
 {
-  // Set the body source integral coefficient
-  source_ = std::move(source);
+  // Set the body source integral coefficient, cached at the points of the default mfem::DomainLFIntegrator rule
+  // unless it changes within a step
+  if (depends_on_state) {
+    source_        = std::move(source);
+    cached_source_ = nullptr;
+  } else {
+    auto cached    = std::make_unique<mfem_ext::QuadratureCachedCoefficient>(std::move(source), mesh_, 2 * order_);
+    cached_source_ = cached.get();
+    source_        = std::move(cached);
+  }
 }
 
 void ThermalConduction::setNonlinearReaction(std::function<double(double)>        reaction,
                                              std::function<double(double)>        d_reaction,
-                                             std::unique_ptr<mfem::Coefficient>&& scale)
+                                             std::unique_ptr<mfem::Coefficient>&& scale, bool depends_on_state)
+{
+  setNonlinearReaction(mfem_ext::batchReaction(reaction, d_reaction), std::move(scale), depends_on_state);
+}
+
+void ThermalConduction::setNonlinearReaction(mfem_ext::ReactionEvaluation         reaction,
+                                             std::unique_ptr<mfem::Coefficient>&& scale, bool depends_on_state)
 {
-  reaction_       = reaction;
-  d_reaction_     = d_reaction;
-  reaction_scale_ = std::move(scale);
+  reaction_ = std::move(reaction);
+  if (depends_on_state) {
+    reaction_scale_        = std::move(scale);
+    cached_reaction_scale_ = nullptr;
+  } else {
+    auto cached = std::make_unique<mfem_ext::QuadratureCachedCoefficient>(std::move(scale), mesh_, 2 * order_ + 3);
+    cached_reaction_scale_ = cached.get();
+    reaction_scale_        = std::move(cached);
+  }
 }
 
 void ThermalConduction::setSpecificHeatCapacity(std::unique_ptr<mfem::Coefficient>&& cp)
@@ -158,8 +182,13 @@ void ThermalConduction::completeSetup()
 
   // Add the domain diffusion integrator to the K form
   K_form_ = temperature_.createOnSpace<mfem::ParNonlinearForm>();
-  K_form_->AddDomainIntegrator(
-      new mfem_ext::BilinearToNonlinearFormIntegrator(std::make_unique<mfem::DiffusionIntegrator>(*kappa_)));
+  // The diffusion term is linear in the temperature, so its element matrices can be assembled once per step, unless
+  // the conductivity changes with the state within a step
+  const bool keep_matrices = cache_element_matrices_ && !conductivity_depends_on_state_;
+  diffusion_integrator_    = new mfem_ext::BilinearToNonlinearFormIntegrator(
+      std::make_unique<mfem::DiffusionIntegrator>(*kappa_),
+      keep_matrices ? mfem_ext::ElementMatrixStorage::Symmetric : mfem_ext::ElementMatrixStorage::None);
+  K_form_->AddDomainIntegrator(diffusion_integrator_);
 
   // Add the body source to the RS if specified
   if (source_) {
@@ -170,7 +199,7 @@ void ThermalConduction::completeSetup()
   // Add a nonlinear reaction term if specified
   if (reaction_) {
     K_form_->AddDomainIntegrator(
-        new serac::mfem_ext::NonlinearReactionIntegrator(reaction_, d_reaction_, *reaction_scale_));
+        new serac::mfem_ext::NonlinearReactionIntegrator(reaction_, *reaction_scale_));
   }
 
   // Build the dof array lookup tables
@@ -189,13 +218,16 @@ void ThermalConduction::completeSetup()
         temperature_.space().TrueVSize(),
 
         [this](const mfem::Vector& u, mfem::Vector& r) {
+          SERAC_PROFILE_SCOPE("Assembly");
           K_form_->Mult(u, r);
           r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
         },
 
         [this](const mfem::Vector& u) -> mfem::Operator& {
+          SERAC_PROFILE_SCOPE("Assembly");
           auto& J = dynamic_cast<mfem::HypreParMatrix&>(K_form_->GetGradient(u));
           bcs_.eliminateAllEssentialDofsFromMatrix(J);
+          profiling::counter("Jacobian assemblies")++;
           return J;
         });
 
@@ -215,17 +247,19 @@ void ThermalConduction::completeSetup()
     residual_ = mfem_ext::StdFunctionOperator(
         temperature_.space().TrueVSize(),
         [this](const mfem::Vector& du_dt, mfem::Vector& r) {
-          r = (*M_) * du_dt + (*K_form_) * (u_ + dt_ * du_dt);
+          SERAC_PROFILE_SCOPE("Assembly");
+          evaluate((*M_) * du_dt + (*K_form_) * (u_ + dt_ * du_dt), r);
           r.SetSubVector(bcs_.allEssentialDofs(), 0.0);
         },
 
         [this](const mfem::Vector& du_dt) -> mfem::Operator& {
+          SERAC_PROFILE_SCOPE("Assembly");
           // Only reassemble the stiffness if it is a new timestep or we have a nonlinear reaction
           if (dt_ != previous_dt_ || reaction_) {
-            auto localJ = std::unique_ptr<mfem::SparseMatrix>(
-                mfem::Add(1.0, M_form_->SpMat(), dt_, K_form_->GetLocalGradient(u_ + dt_ * du_dt)));
-            J_.reset(M_form_->ParallelAssemble(localJ.get()));
+            auto& K = dynamic_cast<mfem::HypreParMatrix&>(K_form_->GetGradient(u_ + dt_ * du_dt));
+            J_      = &J_combination_.update({1.0, dt_}, {M_.get(), &K});
             bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            profiling::counter("Jacobian assemblies")++;
           }
           return *J_;
         });
@@ -236,6 +270,18 @@ void ThermalConduction::advanceTimestep(double& dt)
 {
   temperature_.initializeTrueVec();
 
+  // The mesh may have moved since the last step, e.g. when coupled to a solid, so the cached element matrices and
+  // coefficient values are only reused within a step
+  if (diffusion_integrator_) {
+    diffusion_integrator_->invalidateElementMatrices();
+  }
+  if (cached_source_) {
+    cached_source_->invalidate();
+  }
+  if (cached_reaction_scale_) {
+    cached_reaction_scale_->invalidate();
+  }
+
   if (is_quasistatic_) {
     nonlin_solver_.Mult(zero_, temperature_.trueVec());
   } else {
@@ -249,6 +295,29 @@ void ThermalConduction::advanceTimestep(double& dt)
   cycle_ += 1;
 }
 
+MemoryUsage ThermalConduction::memoryUsage() const
+{
+  auto usage = BasePhysics::memoryUsage();
+  if (M_) {
+    usage.add("mass matrix", memory::bytes(*M_));
+  }
+  usage.add("Jacobian", J_combination_.memoryUsage());
+  if (diffusion_integrator_) {
+    usage.add("diffusion element matrices", diffusion_integrator_->elementMatrixBytes());
+  }
+  if (cached_source_) {
+    usage.add("cached coefficients", cached_source_->cacheBytes());
+  }
+  if (cached_reaction_scale_) {
+    usage.add("cached coefficients", cached_reaction_scale_->cacheBytes());
+  }
+  for (const auto* work : {&zero_, &u_, &previous_}) {
+    usage.add("work vectors", memory::bytes(*work));
+  }
+  usage.add("nonlinear solver", nonlin_solver_.memoryUsage());
+  return usage;
+}
+
 void ThermalConduction::InputOptions::defineInputFileSchema(axom::inlet::Container& container)
 {
   // Polynomial interpolation order - currently up to 8th order is allowed
@@ -258,6 +327,8 @@ void ThermalConduction::InputOptions::defineInputFileSchema(axom::inlet::Contain
   container.addDouble("kappa", "Thermal conductivity").defaultValue(0.5);
   container.addDouble("rho", "Density").defaultValue(1.0);
   container.addDouble("cp", "Specific heat capacity").defaultValue(1.0);
+  container.addBool("cache_element_matrices", "Keep the diffusion element matrices within a timestep")
+      .defaultValue(false);
 
   auto& source = container.addStruct("source", "Scalar source term (RHS of the thermal conduction PDE)");
   serac::input::CoefficientInputOptions::defineInputFileSchema(source);
@@ -303,6 +374,7 @@ serac::ThermalConduction::InputOptions FromInlet<serac::ThermalConduction::Input
   auto equation_solver                   = base["equation_solver"];
   result.solver_options.T_lin_options    = equation_solver["linear"].get<serac::LinearSolverOptions>();
   result.solver_options.T_nonlin_options = equation_solver["nonlinear"].get<serac::NonlinearSolverOptions>();
+  result.solver_options.cache_element_matrices = base["cache_element_matrices"];
 
   if (base.contains("dynamics")) {
     ThermalConduction::TimesteppingOptions dyn_options;
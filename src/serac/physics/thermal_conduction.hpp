@@ -14,7 +14,11 @@
 
 #include "mfem.hpp"
 
+#include "serac/coefficients/quadrature_cached_coefficient.hpp"
+#include "serac/numerics/assembled_linear_combination.hpp"
 #include "serac/physics/base_physics.hpp"
+#include "serac/physics/integrators/nonlinear_reaction_integrator.hpp"
+#include "serac/physics/integrators/wrapper_integrator.hpp"
 #include "serac/physics/operators/odes.hpp"
 #include "serac/physics/operators/stdfunction_operator.hpp"
 
@@ -72,6 +76,13 @@ public:
      *
      */
     std::optional<TimesteppingOptions> dyn_options = std::nullopt;
+
+    /**
+     * @brief Whether to keep the element matrices of the diffusion term within a timestep
+     * @note The matrices are only kept if the conductivity doesn't depend on the state, see setConductivity
+     *
+     */
+    bool cache_element_matrices = false;
   };
 
   /**
@@ -240,12 +251,42 @@ public:
    */
   void advanceTimestep(double& dt) override;
 
+  /**
+   * @brief Returns whether the most recent nonlinear solve converged
+   *
+   * @return True if the Newton solver converged during the last timestep
+   */
+  bool converged() const override { return nonlin_solver_.NonlinearSolver().GetConverged(); }
+
+  /**
+   * @brief Returns the final norm of the residual of the most recent Newton solve
+   *
+   * @return The nonlinear residual norm
+   */
+  double nonlinearResidualNorm() const override { return nonlin_solver_.NonlinearSolver().GetFinalNorm(); }
+
+  /**
+   * @brief Returns the final residual norm of the most recent linear solve within the Newton solve
+   *
+   * @return The linear residual norm, or zero for a direct solver
+   */
+  double linearResidualNorm() const override { return nonlin_solver_.LinearResidualNorm(); }
+
+  /**
+   * @brief Returns the memory held by the module, including its matrices, nonlinear solver, and work vectors
+   *
+   * @return The memory usage on this rank
+   */
+  MemoryUsage memoryUsage() const override;
+
   /**
    * @brief Set the thermal conductivity
    *
    * @param[in] kappa The thermal conductivity
+   * @param[in] depends_on_state Whether the conductivity changes with the state during a timestep, in which case
+   * the element matrices of the diffusion term are never kept
    */
-  void setConductivity(std::unique_ptr<mfem::Coefficient>&& kappa);
+  void setConductivity(std::unique_ptr<mfem::Coefficient>&& kappa, bool depends_on_state = false);
 
   /**
    * @brief Set the temperature state vector from a coefficient
@@ -258,8 +299,10 @@ public:
    * @brief Set the thermal body source from a coefficient
    *
    * @param[in] source The source function coefficient
+   * @param[in] depends_on_state Whether the source changes with the state during a timestep, in which case it is
+   * evaluated every time the residual is, otherwise its values at the quadrature points are kept within a step
    */
-  void setSource(std::unique_ptr<mfem::Coefficient>&& source);
+  void setSource(std::unique_ptr<mfem::Coefficient>&& source, bool depends_on_state = false);
 
   /**
    * @brief Set a nonlinear temperature dependent reaction term
@@ -267,9 +310,36 @@ public:
    * @param[in] reaction A function describing the temperature dependent reaction q=q(T)
    * @param[in] d_reaction A function describing the derivative of the reaction dq = dq(T)/dT
    * @param[in] scale A scaling coefficient for the reaction term
+   * @param[in] depends_on_state Whether the scale changes with the state during a timestep, in which case it is
+   * evaluated every time the residual is, otherwise its values at the quadrature points are kept within a step
    */
   void setNonlinearReaction(std::function<double(double)> reaction, std::function<double(double)> d_reaction,
-                            std::unique_ptr<mfem::Coefficient>&& scale);
+                            std::unique_ptr<mfem::Coefficient>&& scale, bool depends_on_state = false);
+
+  /**
+   * @brief Set a nonlinear temperature dependent reaction term whose derivative is computed automatically
+   *
+   * @tparam Reaction A callable accepting both double and dual<double> temperatures, e.g. a generic lambda
+   * @param[in] reaction A function describing the temperature dependent reaction q=q(T)
+   * @param[in] scale A scaling coefficient for the reaction term
+   * @param[in] depends_on_state Whether the scale changes with the state during a timestep
+   */
+  template <typename Reaction>
+  void setNonlinearReaction(Reaction reaction, std::unique_ptr<mfem::Coefficient>&& scale,
+                            bool depends_on_state = false)
+  {
+    setNonlinearReaction(mfem_ext::batchReaction(reaction), std::move(scale), depends_on_state);
+  }
+
+  /**
+   * @brief Set a nonlinear temperature dependent reaction term evaluated in batches of quadrature points
+   *
+   * @param[in] reaction The batched evaluation of the reaction and its derivative
+   * @param[in] scale A scaling coefficient for the reaction term
+   * @param[in] depends_on_state Whether the scale changes with the state during a timestep
+   */
+  void setNonlinearReaction(mfem_ext::ReactionEvaluation reaction, std::unique_ptr<mfem::Coefficient>&& scale,
+                            bool depends_on_state = false);
 
   /**
    * @brief Set the density field. Defaults to 1.0 if not set.
@@ -336,11 +406,31 @@ protected:
    */
   std::unique_ptr<mfem::Coefficient> kappa_;
 
+  /**
+   * @brief Whether the conductivity changes with the state during a timestep
+   */
+  bool conductivity_depends_on_state_ = false;
+
+  /**
+   * @brief Whether the element matrices of the diffusion term may be kept within a timestep
+   */
+  bool cache_element_matrices_ = false;
+
+  /**
+   * @brief The diffusion integrator of K_form_, which may keep its element matrices between residual evaluations
+   */
+  mfem_ext::BilinearToNonlinearFormIntegrator* diffusion_integrator_ = nullptr;
+
   /**
    * @brief Body source coefficient
    */
   std::unique_ptr<mfem::Coefficient> source_;
 
+  /**
+   * @brief The source_ if its values at the quadrature points of the source integrator are kept within a step
+   */
+  mfem_ext::QuadratureCachedCoefficient* cached_source_ = nullptr;
+
   /**
    * @brief Density coefficient
    *
@@ -380,9 +470,14 @@ protected:
 
   /**
    * @brief assembled sparse matrix for the Jacobian
-   * at the predicted temperature
+   * at the predicted temperature, M + dt * K
    */
-  std::unique_ptr<mfem::HypreParMatrix> J_;
+  mfem_ext::AssembledLinearCombination J_combination_;
+
+  /**
+   * @brief The current value of J_combination_
+   */
+  mfem::HypreParMatrix* J_ = nullptr;
 
   /**
    * @brief The current timestep
@@ -411,22 +506,22 @@ protected:
   mfem::Vector previous_;
 
   /**
-   * @brief the nonlinear reaction function
+   * @brief the nonlinear reaction function and its derivative
    *
    */
-  std::function<double(double)> reaction_;
+  mfem_ext::ReactionEvaluation reaction_;
 
   /**
-   * @brief the derivative of the nonlinear reaction function
+   * @brief a scaling factor for the reaction
    *
    */
-  std::function<double(double)> d_reaction_;
+  std::unique_ptr<mfem::Coefficient> reaction_scale_;
 
   /**
-   * @brief a scaling factor for the reaction
-   *
+   * @brief The reaction_scale_ if its values at the quadrature points of the reaction integrator are kept within a
+   * step
    */
-  std::unique_ptr<mfem::Coefficient> reaction_scale_;
+  mfem_ext::QuadratureCachedCoefficient* cached_reaction_scale_ = nullptr;
 };
 
 }  // namespace serac
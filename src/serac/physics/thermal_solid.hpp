@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "mfem.hpp"
 
 #include "serac/physics/base_physics.hpp"
@@ -72,8 +74,12 @@ public:
    * @brief Set the thermal conductivity
    *
    * @param[in] kappa The thermal conductivity
+   * @param[in] depends_on_state Whether the conductivity changes with the state during a timestep
    */
-  void setConductivity(std::unique_ptr<mfem::Coefficient>&& kappa) { therm_solver_.setConductivity(std::move(kappa)); };
+  void setConductivity(std::unique_ptr<mfem::Coefficient>&& kappa, bool depends_on_state = false)
+  {
+    therm_solver_.setConductivity(std::move(kappa), depends_on_state);
+  };
 
   /**
    * @brief Set the mass density
@@ -107,8 +113,12 @@ public:
    * @brief Set the thermal body source from a coefficient
    *
    * @param[in] source The source function coefficient
+   * @param[in] depends_on_state Whether the source changes with the state during a timestep
    */
-  void setSource(std::unique_ptr<mfem::Coefficient>&& source) { therm_solver_.setSource(std::move(source)); };
+  void setSource(std::unique_ptr<mfem::Coefficient>&& source, bool depends_on_state = false)
+  {
+    therm_solver_.setSource(std::move(source), depends_on_state);
+  };
 
   /**
    * @brief Set displacement boundary conditions
@@ -179,11 +189,12 @@ public:
    * @param[in] mu Set the shear modulus for the solid
    * @param[in] K Set the bulk modulus for the solid
    * @param[in] material_nonlin Flag to include material nonlinearities (linear elastic vs. neo-Hookean model)
+   * @param[in] depends_on_state Whether the parameters change with the state during a timestep
    */
   void setSolidMaterialParameters(std::unique_ptr<mfem::Coefficient>&& mu, std::unique_ptr<mfem::Coefficient>&& K,
-                                  bool material_nonlin = true)
+                                  bool material_nonlin = true, bool depends_on_state = false)
   {
-    solid_solver_.setMaterialParameters(std::move(mu), std::move(K), material_nonlin);
+    solid_solver_.setMaterialParameters(std::move(mu), std::move(K), material_nonlin, depends_on_state);
   };
 
   /**
@@ -245,6 +256,46 @@ public:
    */
   void advanceTimestep(double& dt) override;
 
+  /**
+   * @brief Returns whether both the thermal and solid solves converged
+   *
+   * @return True if both of the single physics modules converged during the last timestep
+   */
+  bool converged() const override { return therm_solver_.converged() && solid_solver_.converged(); }
+
+  /**
+   * @brief Returns the larger of the final nonlinear residual norms of the thermal and solid solves
+   *
+   * @return The nonlinear residual norm
+   */
+  double nonlinearResidualNorm() const override
+  {
+    return std::max(therm_solver_.nonlinearResidualNorm(), solid_solver_.nonlinearResidualNorm());
+  }
+
+  /**
+   * @brief Returns the larger of the final linear residual norms of the thermal and solid solves
+   *
+   * @return The linear residual norm
+   */
+  double linearResidualNorm() const override
+  {
+    return std::max(therm_solver_.linearResidualNorm(), solid_solver_.linearResidualNorm());
+  }
+
+  /**
+   * @brief Returns the memory held by the thermal and solid modules
+   *
+   * @return The memory usage on this rank
+   */
+  MemoryUsage memoryUsage() const override
+  {
+    MemoryUsage usage;
+    usage.add("thermal", therm_solver_.memoryUsage());
+    usage.add("solid", solid_solver_.memoryUsage());
+    return usage;
+  }
+
   /**
    * @brief Destroy the Thermal Structural Solver object
    */
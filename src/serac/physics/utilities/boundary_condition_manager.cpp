@@ -56,6 +56,22 @@ void BoundaryConditionManager::updateAllEssentialDofs() const
   all_dofs_.Sort();
   all_dofs_.Unique();
   all_dofs_valid_ = true;
+  elimination_plan_.reset();
+}
+
+void BoundaryConditionManager::eliminateAllEssentialDofsFromMatrix(mfem::HypreParMatrix& matrix) const
+{
+  const auto& dofs = allEssentialDofs();
+  if (!elimination_plan_ || !elimination_plan_->appliesTo(matrix)) {
+    elimination_plan_ = std::make_unique<mfem_ext::EliminationPlan>(matrix, dofs);
+  }
+  elimination_plan_->eliminate(matrix);
+}
+
+void BoundaryConditionManager::eliminateAllEssentialDofsFromRHS(const mfem::Vector& solution, mfem::Vector& rhs) const
+{
+  SLIC_ERROR_ROOT_IF(!elimination_plan_, "Essential DOFs must be eliminated from a matrix before the right-hand side");
+  elimination_plan_->eliminateRHS(solution, rhs);
 }
 
 void BoundaryConditionManager::setTime(const double time)
@@ -15,6 +15,7 @@
 #include <memory>
 #include <set>
 
+#include "serac/numerics/elimination_plan.hpp"
 #include "serac/physics/utilities/boundary_condition.hpp"
 #include "serac/physics/utilities/finite_element_state.hpp"
 
@@ -227,14 +228,20 @@ public:
   /**
    * @brief Eliminates all essential BCs from a matrix
    * @param[inout] matrix The matrix to eliminate from, will be modified
-   * @return The eliminated matrix entries
-   * @note The sum of the eliminated matrix and the modified parameter is
-   * equal to the initial state of the parameter
+   * @note The positions of the eliminated entries are planned once and reused for later matrices with the same
+   * sparsity, e.g. the Jacobians of a Newton solve. The eliminated entries are kept for
+   * eliminateAllEssentialDofsFromRHS. This is a collective operation.
    */
-  std::unique_ptr<mfem::HypreParMatrix> eliminateAllEssentialDofsFromMatrix(mfem::HypreParMatrix& matrix) const
-  {
-    return std::unique_ptr<mfem::HypreParMatrix>(matrix.EliminateRowsCols(allEssentialDofs()));
-  }
+  void eliminateAllEssentialDofsFromMatrix(mfem::HypreParMatrix& matrix) const;
+
+  /**
+   * @brief Corrects a right-hand side for the essential BCs eliminated from the last matrix
+   * @param[in] solution The vector whose values at the essential DOFs are prescribed
+   * @param[inout] rhs The right-hand side, will be modified
+   * @pre eliminateAllEssentialDofsFromMatrix was called
+   * @note This is a collective operation
+   */
+  void eliminateAllEssentialDofsFromRHS(const mfem::Vector& solution, mfem::Vector& rhs) const;
 
   /**
    * @brief Sets the time for all stored boundary conditions
@@ -327,6 +334,11 @@ private:
    * @brief Whether the set of stored total DOFs is valid
    */
   mutable bool all_dofs_valid_ = false;
+
+  /**
+   * @brief The positions of all essential DOFs in the sparsity of the last matrix they were eliminated from
+   */
+  mutable std::unique_ptr<mfem_ext::EliminationPlan> elimination_plan_;
 };
 
 }  // namespace serac
@@ -6,13 +6,17 @@
 
 #include "serac/physics/utilities/equation_solver.hpp"
 
+#include <limits>
+
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
 
 namespace serac::mfem_ext {
 
 EquationSolver::EquationSolver(MPI_Comm comm, const LinearSolverOptions& lin_options,
                                const std::optional<NonlinearSolverOptions>& nonlin_options)
+    : comm_(comm)
 {
   // If it's an iterative solver, build it and set the preconditioner
   if (auto iter_options = std::get_if<IterativeSolverOptions>(&lin_options)) {
@@ -25,16 +29,23 @@ EquationSolver::EquationSolver(MPI_Comm comm, const LinearSolverOptions& lin_opt
   }
   // If it's a direct solver (currently SuperLU only)
   else if (auto direct_options = std::get_if<DirectSolverOptions>(&lin_options)) {
-    auto direct_solver = std::make_unique<mfem::SuperLUSolver>(comm);
-    direct_solver->SetColumnPermutation(mfem::superlu::PARMETIS);
-    if (direct_options->print_level == 0) {
-      direct_solver->SetPrintStatistics(false);
-    }
-    lin_solver_ = std::move(direct_solver);
+    lin_solver_ = std::make_unique<SuperLUSolver>(comm, direct_options->print_level != 0);
   }
 
   if (nonlin_options) {
     nonlin_solver_ = BuildNewtonSolver(comm, *nonlin_options);
+
+    // The Krylov solver is given matrix-free Jacobians, so its preconditioner is only updated with assembled ones
+    if (nonlin_options->jacobian_free) {
+      auto krylov_solver = std::get_if<std::unique_ptr<mfem::IterativeSolver>>(&lin_solver_);
+      SLIC_ERROR_ROOT_IF(krylov_solver == nullptr,
+                         "Jacobian-free Newton-Krylov solves need an iterative linear solver");
+      if (prec_) {
+        lagged_prec_ = std::make_unique<LaggedPreconditioner>(*prec_);
+        (*krylov_solver)->SetPreconditioner(*lagged_prec_);
+      }
+      jacobian_free_options_ = nonlin_options->jacobian_free;
+    }
   }
 }
 
@@ -183,53 +194,101 @@ std::unique_ptr<mfem::NewtonSolver> EquationSolver::BuildNewtonSolver(MPI_Comm
 void EquationSolver::SetOperator(const mfem::Operator& op)
 {
   if (nonlin_solver_) {
-    if (std::holds_alternative<std::unique_ptr<mfem::SuperLUSolver>>(lin_solver_)) {
-      superlu_wrapper_ = std::make_unique<SuperLUNonlinearOperatorWrapper>(op);
-      nonlin_solver_->SetOperator(*superlu_wrapper_);
+    if (jacobian_free_options_) {
+      auto& krylov_solver = *std::get<std::unique_ptr<mfem::IterativeSolver>>(lin_solver_);
+      jacobian_free_ = std::make_unique<JacobianFreeOperator>(comm_, op, *jacobian_free_options_, krylov_solver,
+                                                              lagged_prec_.get());
+      if (essential_dofs_) {
+        jacobian_free_->setEssentialDofs(*essential_dofs_);
+      }
+      nonlin_solver_->SetOperator(*jacobian_free_);
     } else {
       nonlin_solver_->SetOperator(op);
     }
     // Now that the nonlinear solver knows about the operator, we can set its linear solver
     if (!nonlin_solver_set_solver_called_) {
-      nonlin_solver_->SetSolver(LinearSolver());
+      krylov_counter_ = std::make_unique<KrylovIterationCounter>(LinearSolver());
+      nonlin_solver_->SetSolver(*krylov_counter_);
       nonlin_solver_set_solver_called_ = true;
     }
   } else {
+    SERAC_PROFILE_SCOPE("Linear solver setup");
     std::visit([&op](auto&& solver) { solver->SetOperator(op); }, lin_solver_);
   }
   height = op.Height();
   width  = op.Width();
 }
 
-void EquationSolver::SetOperator(const mfem::HypreParMatrix& matrix)
+void EquationSolver::SetEssentialTrueDofs(const mfem::Array<int>& dofs)
 {
-  if (std::holds_alternative<std::unique_ptr<mfem::SuperLUSolver>>(lin_solver_)) {
-    superlu_mat_ = matrix;
-    SetOperator(*superlu_mat_);
-  }
-  // Otherwise just upcast and call as usual
-  else {
-    SetOperator(static_cast<const mfem::Operator&>(matrix));
+  essential_dofs_ = &dofs;
+  if (jacobian_free_) {
+    jacobian_free_->setEssentialDofs(dofs);
   }
 }
 
 void EquationSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
 {
+  // The counters are looked up once, this is called for every solve
+  static profiling::Counter&     newton_iterations = profiling::counter("Newton iterations");
+  static profiling::Counter&     krylov_iterations = profiling::counter("Krylov iterations");
+  static profiling::TimerRecord& linear_solve      = profiling::timer("Linear solve");
+
   if (nonlin_solver_) {
+    if (jacobian_free_) {
+      jacobian_free_->beginSolve(b);
+    }
     nonlin_solver_->Mult(b, x);
+    newton_iterations += nonlin_solver_->GetNumIterations();
   } else {
+    const profiling::ScopedTimer timer(linear_solve);
     std::visit([&b, &x](auto&& solver) { solver->Mult(b, x); }, lin_solver_);
+    if (auto iter_solver = dynamic_cast<const mfem::IterativeSolver*>(&LinearSolver())) {
+      krylov_iterations += iter_solver->GetNumIterations();
+    }
   }
 }
 
-mfem::Operator& EquationSolver::SuperLUNonlinearOperatorWrapper::GetGradient(const mfem::Vector& x) const
+double EquationSolver::LinearResidualNorm() const
 {
-  mfem::Operator&       grad      = oper_.GetGradient(x);
-  mfem::HypreParMatrix* matr_grad = dynamic_cast<mfem::HypreParMatrix*>(&grad);
+  if (auto iter_solver = dynamic_cast<const mfem::IterativeSolver*>(&LinearSolver())) {
+    return iter_solver->GetFinalNorm();
+  }
+  return 0.0;
+}
 
-  SLIC_ERROR_ROOT_IF(matr_grad == nullptr, "Nonlinear operator gradient must be a HypreParMatrix");
-  superlu_grad_mat_.emplace(*matr_grad);
-  return *superlu_grad_mat_;
+MemoryUsage EquationSolver::memoryUsage() const
+{
+  MemoryUsage usage;
+  if (auto amg = dynamic_cast<const mfem::HypreBoomerAMG*>(prec_.get())) {
+    usage.add("AMG hierarchy", memory::bytes(*amg));
+  }
+  if (auto direct = std::get_if<std::unique_ptr<SuperLUSolver>>(&lin_solver_)) {
+    usage.add("SuperLU", (*direct)->memoryUsage());
+  }
+  return usage;
+}
+
+void EquationSolver::KrylovIterationCounter::SetOperator(const mfem::Operator& op)
+{
+  SERAC_PROFILE_SCOPE("Linear solver setup");
+  solver_.SetOperator(op);
+  height = op.Height();
+  width  = op.Width();
+}
+
+void EquationSolver::KrylovIterationCounter::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  static profiling::Counter&     krylov_iterations = profiling::counter("Krylov iterations");
+  static profiling::TimerRecord& linear_solve      = profiling::timer("Linear solve");
+  const profiling::ScopedTimer   timer(linear_solve);
+
+  // The nonlinear solver sets the iterative mode of its linear solver
+  solver_.iterative_mode = iterative_mode;
+  solver_.Mult(b, x);
+  if (auto iter_solver = dynamic_cast<const mfem::IterativeSolver*>(&solver_)) {
+    krylov_iterations += iter_solver->GetNumIterations();
+  }
 }
 
 void EquationSolver::DefineInputFileSchema(axom::inlet::Container& container)
@@ -271,6 +330,21 @@ void EquationSolver::DefineInputFileSchema(axom::inlet::Container& container)
   nonlinear_container.addInt("print_level", "Nonlinear print level.").defaultValue(0);
   nonlinear_container.addString("solver_type", "Solver type (MFEMNewton|KINFullStep|KINLineSearch)")
       .defaultValue("MFEMNewton");
+
+  // Only needed for Jacobian-free Newton-Krylov solves, which are only used if enabled explicitly
+  auto& jacobian_free_container =
+      nonlinear_container.addStruct("jacobian_free", "Jacobian-free Newton-Krylov Parameters").required(false);
+  jacobian_free_container.addBool("enabled", "Apply the Jacobian matrix-free.").defaultValue(false);
+  jacobian_free_container.addInt("preconditioner_lag", "Newton iterations an assembled Jacobian preconditions.")
+      .defaultValue(10)
+      .range(1, std::numeric_limits<int>::max());
+  jacobian_free_container.addDouble("initial_forcing_term", "Relative tolerance of the first linear solve.")
+      .defaultValue(0.5);
+  jacobian_free_container.addDouble("max_forcing_term", "Largest relative tolerance of the linear solves.")
+      .defaultValue(0.9);
+  jacobian_free_container.addDouble("gamma", "Factor of the Eisenstat-Walker forcing terms, in (0, 1].")
+      .defaultValue(0.9)
+      .range(std::numeric_limits<double>::min(), 1.0);
 }
 
 }  // namespace serac::mfem_ext
@@ -344,6 +418,14 @@ serac::NonlinearSolverOptions FromInlet<serac::NonlinearSolverOptions>::operator
   } else {
     SLIC_ERROR_ROOT(fmt::format("Unknown nonlinear solver type given: {0}", solver_type));
   }
+  if (base.contains("jacobian_free/enabled") && base["jacobian_free/enabled"].get<bool>()) {
+    serac::JacobianFreeOptions jacobian_free;
+    jacobian_free.preconditioner_lag   = base["jacobian_free/preconditioner_lag"];
+    jacobian_free.initial_forcing_term = base["jacobian_free/initial_forcing_term"];
+    jacobian_free.max_forcing_term     = base["jacobian_free/max_forcing_term"];
+    jacobian_free.gamma                = base["jacobian_free/gamma"];
+    options.jacobian_free              = jacobian_free;
+  }
   return options;
 }
 
@@ -19,6 +19,9 @@
 #include "mfem.hpp"
 
 #include "serac/infrastructure/input.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
+#include "serac/numerics/superlu_solver.hpp"
+#include "serac/physics/utilities/jacobian_free_operator.hpp"
 #include "serac/physics/utilities/solver_config.hpp"
 
 namespace serac::mfem_ext {
@@ -50,12 +53,12 @@ public:
   void SetOperator(const mfem::Operator& op) override;
 
   /**
-   * @brief An overload for "intercepting" HypreParMatrices
-   * such that they can be converted to a SuperLURowLocMatrix
-   * when running in SuperLU mode
-   * @param[in] matrix The operator (system matrix) to use, "A" in Ax = b
+   * @brief Sets the essential true degrees of freedom, whose rows and columns are eliminated from the Jacobians
+   * applied by Jacobian-free Newton-Krylov solves
+   * @param[in] dofs The local true degrees of freedom, which are referenced, so that updates are seen
+   * @note The assembled Jacobians are expected to be eliminated by the physics modules already
    */
-  void SetOperator(const mfem::HypreParMatrix& matrix);
+  void SetEssentialTrueDofs(const mfem::Array<int>& dofs);
 
   /**
    * Solves the system
@@ -93,6 +96,18 @@ public:
     return std::visit([](auto&& solver) -> const mfem::Solver& { return *solver; }, lin_solver_);
   }
 
+  /**
+   * @brief Returns the final residual norm of the most recent linear solve
+   * @return The residual norm, or zero if the linear solver is not iterative
+   */
+  double LinearResidualNorm() const;
+
+  /**
+   * @brief Returns the memory held by the solver
+   * @note The AMG hierarchy and the copy of the matrix held by SuperLU are counted, the SuperLU factors are not
+   */
+  MemoryUsage memoryUsage() const;
+
   /**
    * Input file parameters specific to this class
    **/
@@ -116,49 +131,37 @@ private:
                                                                const NonlinearSolverOptions& nonlin_options);
 
   /**
-   * @brief A wrapper class for combining a nonlinear solver with a SuperLU direct solver
+   * @brief A wrapper class that times the linear solves within a nonlinear solve and counts their Krylov iterations
    */
-  class SuperLUNonlinearOperatorWrapper : public mfem::Operator {
+  class KrylovIterationCounter : public mfem::Solver {
   public:
     /**
-     * @brief Constructs a wrapper over an mfem::Operator
-     * @param[in] oper The operator to wrap
+     * @brief Constructs a wrapper over a linear solver
+     * @param[in] solver The solver to wrap
      */
-    SuperLUNonlinearOperatorWrapper(const mfem::Operator& oper) : oper_(oper)
-    {
-      height = oper_.Height();
-      width  = oper_.Width();
-    }
-    /**
-     * @brief Applies the operator
-     * @param[in] b The input vector
-     * @param[out] x The output vector
-     * @note Implements mfem::Operator::Mult, forwards directly to underlying operator
-     */
-    void Mult(const mfem::Vector& b, mfem::Vector& x) const override { oper_.Mult(b, x); }
+    KrylovIterationCounter(mfem::Solver& solver) : solver_(solver) {}
 
     /**
-     * @brief Obtains the gradient of the underlying operator
-     * as a SuperLU matrix
-     * @param[in] x The point at which the gradient should be evaluated
-     * @return A non-owning reference to an mfem::SuperLURowLocMatrix (upcasts
-     * to match interface)
-     * @note Implements mfem::Operator::GetGradient
+     * @brief Sets the operator of the underlying solver, timed as "Linear solver setup"
+     * @param[in] op The operator to solve with
      */
-    mfem::Operator& GetGradient(const mfem::Vector& x) const override;
+    void SetOperator(const mfem::Operator& op) override;
 
-  private:
     /**
-     * @brief The underlying operator
+     * @brief Solves with the underlying solver, timed as "Linear solve", and adds its iterations to the
+     * "Krylov iterations" counter
+     * @param[in] b The right-hand side
+     * @param[out] x The solution
      */
-    const mfem::Operator& oper_;
+    void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
 
+  private:
     /**
-     * @brief The owner of the SuperLU matrix for the gradient, stored
-     * as a member variable for lifetime purposes
+     * @brief The underlying solver
      */
-    mutable std::optional<mfem::SuperLURowLocMatrix> superlu_grad_mat_;
+    mfem::Solver& solver_;
   };
+
   /**
    * @brief The preconditioner (used for an iterative solver only)
    */
@@ -167,7 +170,12 @@ private:
   /**
    * @brief The linear solver object, either custom, direct (SuperLU), or iterative
    */
-  std::variant<std::unique_ptr<mfem::IterativeSolver>, std::unique_ptr<mfem::SuperLUSolver>, mfem::Solver*> lin_solver_;
+  std::variant<std::unique_ptr<mfem::IterativeSolver>, std::unique_ptr<SuperLUSolver>, mfem::Solver*> lin_solver_;
+
+  /**
+   * @brief The communicator of the solver
+   */
+  MPI_Comm comm_ = MPI_COMM_WORLD;
 
   /**
    * @brief The optional nonlinear Newton-Raphson solver object
@@ -182,14 +190,30 @@ private:
   bool nonlin_solver_set_solver_called_ = false;
 
   /**
-   * @brief The operator (system matrix) used with a SuperLU solver
+   * @brief The linear solver as seen by the nonlinear solver, which counts its iterations
+   */
+  std::unique_ptr<KrylovIterationCounter> krylov_counter_;
+
+  /**
+   * @brief The Jacobian-free Newton-Krylov parameters, if the nonlinear solver applies the Jacobian matrix-free
+   */
+  std::optional<JacobianFreeOptions> jacobian_free_options_;
+
+  /**
+   * @brief The preconditioner as seen by the Krylov solver in Jacobian-free mode, which is only updated with
+   * assembled Jacobians
+   */
+  std::unique_ptr<LaggedPreconditioner> lagged_prec_;
+
+  /**
+   * @brief The residual as seen by the nonlinear solver in Jacobian-free mode
    */
-  std::optional<mfem::SuperLURowLocMatrix> superlu_mat_;
+  std::unique_ptr<JacobianFreeOperator> jacobian_free_;
 
   /**
-   * @brief A wrapper class that allows a direct solver to be used underneath a Newton-Raphson solver
+   * @brief The essential true degrees of freedom to eliminate from the Jacobian-free Jacobians, if any
    */
-  std::unique_ptr<SuperLUNonlinearOperatorWrapper> superlu_wrapper_;
+  const mfem::Array<int>* essential_dofs_ = nullptr;
 };
 
 /**
@@ -14,6 +14,8 @@
 #include "mfem.hpp"
 #include "mfem/linalg/dtensor.hpp"
 
+#include "serac/infrastructure/memory_usage.hpp"
+
 #include "serac/physics/utilities/functional/tensor.hpp"
 #include "serac/physics/utilities/functional/quadrature.hpp"
 #include "serac/physics/utilities/functional/finite_element.hpp"
@@ -602,6 +604,18 @@ public:
    */
   void GradientMult(const mfem::Vector& input_E, mfem::Vector& output_E) const { gradient_(input_E, output_E); }
 
+  /**
+   * @brief Returns the memory held by the integral
+   */
+  MemoryUsage memoryUsage() const
+  {
+    MemoryUsage usage;
+    usage.add("quadrature function derivatives", qf_derivatives_.capacity());
+    usage.add("Jacobians", memory::bytes(J_));
+    usage.add("positions", memory::bytes(X_));
+    return usage;
+  }
+
 private:
   /**
    * @brief Jacobians of the element transformations at all quadrature points
@@ -133,11 +133,13 @@ public:
    * @tparam lambda the type of the integrand functor: must implement operator() with an appropriate function signature
    * @param[in] integrand The user-provided quadrature function, see @p Integral
    * @param[in] domain The domain on which to evaluate the integral
+   * @param[inout] data The internal state at each quadrature point, or nullptr if the integrand has no state
    * @note The @p Dimension parameters are used to assist in the deduction of the @a geometry_dim
    * and @a spatial_dim template parameter
    */
-  template <int geometry_dim, int spatial_dim, typename lambda>
-  void AddIntegral(Dimension<geometry_dim>, Dimension<spatial_dim>, lambda&& integrand, mfem::Mesh& domain)
+  template <int geometry_dim, int spatial_dim, typename lambda, typename qdata_type = std::nullptr_t>
+  void AddIntegral(Dimension<geometry_dim>, Dimension<spatial_dim>, lambda&& integrand, mfem::Mesh& domain,
+                   qdata_type data = nullptr)
   {
     if constexpr (geometry_dim == spatial_dim) {
       auto num_elements = domain.GetNE();
@@ -154,7 +156,7 @@ public:
       constexpr auto flags = mfem::GeometricFactors::COORDINATES | mfem::GeometricFactors::JACOBIANS;
       auto           geom  = domain.GetGeometricFactors(ir, flags);
       domain_integrals_.emplace_back(num_elements, geom->J, geom->X, Dimension<geometry_dim>{},
-                                     Dimension<spatial_dim>{}, integrand);
+                                     Dimension<spatial_dim>{}, integrand, data);
       return;
     }
 #ifdef ENABLE_BOUNDARY_INTEGRALS
@@ -234,6 +236,25 @@ public:
     AddIntegral(Dimension<d>{} /* geometry */, Dimension<d>{} /* spatial */, integrand, domain);
   }
 
+  /**
+   * @brief Adds a domain integral whose integrand updates an internal state at each quadrature point
+   * @tparam d The dimension of the elements *and* the space they're embedded in
+   * @tparam lambda the type of the integrand functor: must implement operator() with an appropriate function signature
+   * @tparam T The state at a single quadrature point
+   * @param[in] integrand The quadrature function, which is called as integrand(x, u_du, state)
+   * @param[in] domain The mesh to evaluate the integral on
+   * @param[inout] data The internal state at each quadrature point
+   *
+   * Every evaluation passes the integrand the committed state at each quadrature point, and the state that the
+   * integrand leaves behind becomes the trial state, see QuadratureData::commit and QuadratureData::rollback.
+   * The data must be sized for (max(test order, trial order) + 1)^d points per element.
+   */
+  template <int d, typename lambda, typename T>
+  void AddDomainIntegral(Dimension<d>, lambda&& integrand, mfem::Mesh& domain, QuadratureData<T>& data)
+  {
+    AddIntegral(Dimension<d>{} /* geometry */, Dimension<d>{} /* spatial */, integrand, domain, &data);
+  }
+
 #ifdef ENABLE_BOUNDARY_INTEGRALS
   /**
    * @brief Adds a surface integral, i.e., over 2D elements in R^3 space
@@ -343,6 +364,51 @@ public:
     test_space_->GetEssentialTrueDofs(ess_attr, ess_tdof_list_);
   }
 
+  /**
+   * @brief Returns the memory held by the functional, including the quadrature function derivatives that are kept for
+   * the gradient and the element matrices
+   */
+  MemoryUsage memoryUsage() const
+  {
+    MemoryUsage usage;
+    for (const auto* work : {&input_L_, &output_L_, &input_E_, &output_E_, &my_output_T_, &dummy_}) {
+      usage.add("work vectors", memory::bytes(*work));
+    }
+    for (const auto& integral : domain_integrals_) {
+      usage.add("domain integrals", integral.memoryUsage());
+    }
+#ifdef ENABLE_BOUNDARY_INTEGRALS
+    for (const auto* work : {&input_E_boundary_, &output_E_boundary_, &output_L_boundary_}) {
+      usage.add("work vectors", memory::bytes(*work));
+    }
+    for (const auto& integral : boundary_integrals_) {
+      usage.add("boundary integrals", integral.memoryUsage());
+    }
+#endif
+    usage.add("element matrices", memory::bytes(K_e_));
+    if (assembled_spmat_) {
+      usage.add("assembled matrix", assembled_spmat_->memoryUsage());
+    }
+    return usage;
+  }
+
+  /**
+   * @brief Returns the analytic cost of a call of each domain integral's kernels, with the number of calls and the time
+   * spent in them, e.g. for profiling::reportKernelPerformance
+   * @note Boundary integrals have no cost model or timers, so they are not included
+   */
+  std::vector<profiling::KernelPerformance> kernelPerformance() const
+  {
+    std::vector<profiling::KernelPerformance> kernels;
+    for (std::size_t i = 0; i < domain_integrals_.size(); i++) {
+      for (auto kernel : domain_integrals_[i].kernelPerformance()) {
+        kernel.name = fmt::format("domain integral {0}/{1}", i, kernel.name);
+        kernels.push_back(kernel);
+      }
+    }
+    return kernels;
+  }
+
 private:
   /**
    * @brief Indicates whether to obtain values or gradients from a calculation
@@ -14,6 +14,10 @@
 #include "mfem.hpp"
 #include "mfem/linalg/dtensor.hpp"
 
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/physics/utilities/quadrature_data.hpp"
 #include "serac/physics/utilities/functional/tensor.hpp"
 #include "serac/physics/utilities/functional/quadrature.hpp"
 #include "serac/physics/utilities/functional/finite_element.hpp"
@@ -294,11 +298,14 @@ auto Measure(const tensor<double, m, n>& A)
  * @see mfem::GeometricFactors
  * @param[in] num_elements The number of elements in the mesh
  * @param[in] qf The actual quadrature function, see @p lambda
+ * @param[inout] data The internal state at each quadrature point, or nullptr if @a lambda has no state. The
+ * q-function is passed the committed state at each point, and what it leaves there becomes the trial state
  */
 template <Geometry g, typename test, typename trial, int geometry_dim, int spatial_dim, int Q,
-          typename derivatives_type, typename lambda>
+          typename derivatives_type, typename lambda, typename qdata_type = std::nullptr_t>
 void evaluation_kernel(const mfem::Vector& U, mfem::Vector& R, derivatives_type* derivatives_ptr,
-                       const mfem::Vector& J_, const mfem::Vector& X_, int num_elements, lambda qf)
+                       const mfem::Vector& J_, const mfem::Vector& X_, int num_elements, lambda qf,
+                       qdata_type data = nullptr)
 {
   using test_element               = finite_element<g, test>;
   using trial_element              = finite_element<g, trial>;
@@ -339,7 +346,16 @@ void evaluation_kernel(const mfem::Vector& U, mfem::Vector& R, derivatives_type*
       //
       // note: make_dual(arg) promotes those arguments to dual number types
       // so that qf_output will contain values and derivatives
-      auto qf_output = qf(x_q, make_dual(arg));
+      auto qf_output = [&]() {
+        if constexpr (std::is_same_v<qdata_type, std::nullptr_t>) {
+          return qf(x_q, make_dual(arg));
+        } else {
+          auto state  = data->committed(e, q);
+          auto output = qf(x_q, make_dual(arg), state);
+          data->set(e, q, state);
+          return output;
+        }
+      }();
 
       // integrate qf_output against test space shape functions / gradients
       // to get element residual contributions
@@ -439,6 +455,166 @@ void gradient_kernel(const mfem::Vector& dU, mfem::Vector& dR, derivatives_type*
   }
 }
 
+namespace detail {
+
+/**
+ * @brief Counts the floating point operations of the determinant of a square matrix
+ * @tparam n The number of rows and columns
+ */
+template <int n>
+constexpr double determinant_flops()
+{
+  return (n == 1) ? 0.0 : (n == 2) ? 3.0 : 14.0;
+}
+
+/**
+ * @brief Counts the floating point operations of the inverse of a square matrix, through its adjugate
+ * @tparam n The number of rows and columns
+ */
+template <int n>
+constexpr double inverse_flops()
+{
+  return determinant_flops<n>() + ((n == 1) ? 1.0 : (n == 2) ? 4.0 : 36.0);
+}
+
+/**
+ * @brief Counts the floating point operations of detail::Measure at a quadrature point
+ * @tparam geometry_dim The dimension of the element
+ * @tparam spatial_dim The dimension of the mesh
+ */
+template <int geometry_dim, int spatial_dim>
+constexpr double measure_flops()
+{
+  if constexpr (geometry_dim == spatial_dim) {
+    return determinant_flops<spatial_dim>();
+  } else {
+    // sqrt(det(J^T * J))
+    return 2.0 * spatial_dim * geometry_dim * geometry_dim + determinant_flops<geometry_dim>() + 1.0;
+  }
+}
+
+/**
+ * @brief Counts the floating point operations of detail::Preprocess at a quadrature point, which are also those of
+ * integrating against the same shape functions in detail::Postprocess
+ *
+ * The values and derivatives are contractions of the element's DOF values with the shape functions and their
+ * derivatives, which are first mapped to physical space. The evaluation of the reference shape functions themselves
+ * is not counted.
+ *
+ * @tparam element_type The type of the element
+ * @tparam geometry_dim The dimension of the element
+ * @tparam spatial_dim The dimension of the mesh
+ */
+template <typename element_type, int geometry_dim, int spatial_dim>
+constexpr double interpolation_flops()
+{
+  constexpr double ndof       = element_type::ndof;
+  constexpr double components = element_type::components;
+
+  if constexpr (geometry_dim != spatial_dim) {
+    // only the values are used on the boundary
+    if constexpr (element_type::family == Family::HCURL) {
+      return 2.0 * ndof * spatial_dim * (geometry_dim + 1.0);
+    } else {
+      return 2.0 * ndof * components;
+    }
+  } else if constexpr (element_type::family == Family::HCURL) {
+    // covariant Piola transformation of the values, and the curls scaled by det(J) and in 3D transformed by J
+    constexpr double curl_dim = (spatial_dim == 3) ? 3.0 : 1.0;
+    constexpr double mapping  = 2.0 * ndof * spatial_dim * spatial_dim + ndof * curl_dim +
+                               ((spatial_dim == 3) ? 2.0 * ndof * 9.0 : 0.0) + inverse_flops<spatial_dim>();
+    return mapping + 2.0 * ndof * (spatial_dim + curl_dim);
+  } else {
+    // values, and gradients mapped to physical space with the inverse Jacobian
+    constexpr double mapping = 2.0 * ndof * spatial_dim * spatial_dim + inverse_flops<spatial_dim>();
+    return mapping + 2.0 * ndof * components * (1.0 + spatial_dim);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Counts the bytes and floating point operations of a call of evaluation_kernel
+ *
+ * The bytes are those of the element DOF values and residuals, the Jacobians and positions at the quadrature points,
+ * the derivatives of the q-function that are stored for the gradient, and the state at the quadrature points. The
+ * flops are those of the interpolation and integration at the quadrature points, the q-function itself is not counted,
+ * so the flops are a lower bound.
+ *
+ * @tparam g The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space
+ * @tparam geometry_dim The dimension of the element
+ * @tparam spatial_dim The dimension of the mesh
+ * @tparam Q Quadrature parameter describing how many points per dimension
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ * @param[in] num_elements The number of elements in the mesh
+ * @param[in] qdata_bytes The bytes of the state at a quadrature point, which is read and written, or zero
+ */
+template <Geometry g, typename test, typename trial, int geometry_dim, int spatial_dim, int Q,
+          typename derivatives_type>
+profiling::KernelCost evaluation_kernel_cost(int num_elements, std::size_t qdata_bytes = 0)
+{
+  using test_element            = finite_element<g, test>;
+  using trial_element           = finite_element<g, trial>;
+  constexpr double points       = GaussQuadratureRule<g, Q>().size();
+  constexpr double test_values  = test_element::ndof * test_element::components;
+  constexpr double trial_values = trial_element::ndof * trial_element::components;
+
+  // the element DOF values are read, and the element residuals read and written
+  constexpr double element_bytes = (trial_values + 2.0 * test_values) * sizeof(double);
+  const double     point_bytes   = (spatial_dim * geometry_dim + spatial_dim) * sizeof(double) +
+                               static_cast<double>(sizeof(derivatives_type) + 2 * qdata_bytes);
+
+  // the residual contributions are scaled by the measure, and added
+  constexpr double point_flops = detail::measure_flops<geometry_dim, spatial_dim>() + 1.0 +
+                                 detail::interpolation_flops<trial_element, geometry_dim, spatial_dim>() +
+                                 detail::interpolation_flops<test_element, geometry_dim, spatial_dim>() +
+                                 2.0 * test_values;
+
+  return {num_elements * (element_bytes + points * point_bytes), num_elements * points * point_flops};
+}
+
+/**
+ * @brief Counts the bytes and floating point operations of a call of gradient_kernel
+ *
+ * The bytes are those of the element DOF values and residuals, the Jacobians at the quadrature points, and the
+ * derivatives of the q-function. The flops are those of the interpolation, the chain rule, and the integration at the
+ * quadrature points.
+ *
+ * @tparam g The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space
+ * @tparam geometry_dim The dimension of the element
+ * @tparam spatial_dim The dimension of the mesh
+ * @tparam Q Quadrature parameter describing how many points per dimension
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ * @param[in] num_elements The number of elements in the mesh
+ */
+template <Geometry g, typename test, typename trial, int geometry_dim, int spatial_dim, int Q,
+          typename derivatives_type>
+profiling::KernelCost gradient_kernel_cost(int num_elements)
+{
+  using test_element            = finite_element<g, test>;
+  using trial_element           = finite_element<g, trial>;
+  constexpr double points       = GaussQuadratureRule<g, Q>().size();
+  constexpr double test_values  = test_element::ndof * test_element::components;
+  constexpr double trial_values = trial_element::ndof * trial_element::components;
+
+  // each of the derivatives multiplies one of the changes in the arguments, and is added to a change in the output
+  constexpr double derivatives = sizeof(derivatives_type) / sizeof(double);
+
+  constexpr double element_bytes = (trial_values + 2.0 * test_values) * sizeof(double);
+  constexpr double point_bytes   = spatial_dim * geometry_dim * sizeof(double) + sizeof(derivatives_type);
+  constexpr double point_flops   = detail::measure_flops<geometry_dim, spatial_dim>() + 1.0 +
+                                 detail::interpolation_flops<trial_element, geometry_dim, spatial_dim>() +
+                                 2.0 * derivatives +
+                                 detail::interpolation_flops<test_element, geometry_dim, spatial_dim>() +
+                                 2.0 * test_values;
+
+  return {num_elements * (element_bytes + points * point_bytes), num_elements * points * point_flops};
+}
+
 /**
  * @brief The base kernel template used to compute tangent element entries that can be assembled
  * into a tangent matrix
@@ -750,6 +926,25 @@ struct lambda_argument<Hcurl<p>, 3, 3> {
   using type = std::tuple<tensor<double, 3>, tensor<double, 3> >;
 };
 
+/**
+ * @brief a type function that determines the output of a q-function
+ * @tparam lambda The q-function
+ * @tparam x_t The type of the position of a quadrature point
+ * @tparam arg_t The type of the value/derivatives passed to the q-function
+ * @tparam qdata_type The quadrature data passed to the q-function, or @p std::nullptr_t if it has none
+ */
+template <typename lambda, typename x_t, typename arg_t, typename qdata_type>
+struct qf_output {
+  using type = decltype(std::declval<lambda>()(std::declval<x_t>(), std::declval<arg_t>()));
+};
+
+// specialization for a q-function that updates the internal state at each quadrature point
+template <typename lambda, typename x_t, typename arg_t, typename state_type>
+struct qf_output<lambda, x_t, arg_t, QuadratureData<state_type>*> {
+  using type =
+      decltype(std::declval<lambda>()(std::declval<x_t>(), std::declval<arg_t>(), std::declval<state_type&>()));
+};
+
 }  // namespace detail
 /// @endcond
 
@@ -790,12 +985,14 @@ public:
    * @param[in] X The actual (not reference) coordinates of all quadrature points
    * @see mfem::GeometricFactors
    * @param[in] qf The user-provided quadrature function
+   * @param[inout] data The internal state at each quadrature point, which is passed to @a qf as a third argument,
+   * or nullptr if @a qf has no state
    * @note The @p Dimension parameters are used to assist in the deduction of the @a geometry_dim
    * and @a spatial_dim template parameters
    */
-  template <int geometry_dim, int spatial_dim, typename lambda_type>
+  template <int geometry_dim, int spatial_dim, typename lambda_type, typename qdata_type = std::nullptr_t>
   Integral(int num_elements, const mfem::Vector& J, const mfem::Vector& X, Dimension<geometry_dim>,
-           Dimension<spatial_dim>, lambda_type&& qf)
+           Dimension<spatial_dim>, lambda_type&& qf, qdata_type data = nullptr)
       : J_(J), X_(X)
   {
     constexpr auto geometry                      = supported_geometries[geometry_dim];
@@ -804,6 +1001,14 @@ public:
 
     uint32_t num_quadrature_points = quadrature_points_per_element * uint32_t(num_elements);
 
+    if constexpr (!std::is_same_v<qdata_type, std::nullptr_t>) {
+      SLIC_ERROR_IF(data->numElements() != num_elements || data->pointsPerElement() != quadrature_points_per_element,
+                    fmt::format("Quadrature data has {0} points in each of {1} elements, expected {2} points in each "
+                                "of {3} elements",
+                                data->pointsPerElement(), data->numElements(), quadrature_points_per_element,
+                                num_elements));
+    }
+
     // these lines of code figure out the argument types that will be passed
     // into the quadrature function in the finite element kernel.
     //
@@ -811,7 +1016,9 @@ public:
     // the derivative information at each quadrature point
     using x_t             = tensor<double, spatial_dim>;
     using u_du_t          = typename detail::lambda_argument<trial_space, geometry_dim, spatial_dim>::type;
-    using derivative_type = decltype(get_gradient(qf(x_t{}, make_dual(u_du_t{}))));
+    using dual_u_du_t     = decltype(make_dual(u_du_t{}));
+    using qf_output_type  = typename detail::qf_output<lambda_type, x_t, dual_u_du_t, qdata_type>::type;
+    using derivative_type = decltype(get_gradient(std::declval<qf_output_type>()));
 
     // the derivative_type data is stored in a shared_ptr here, because it can't be a
     // member variable on the Integral class template (since it depends on the lambda function,
@@ -825,6 +1032,19 @@ public:
     // derivatives are stored as a 2D array, such that quadrature point q of element e is accessed by
     // qf_derivatives[e * quadrature_points_per_element + q]
     std::shared_ptr<derivative_type[]> qf_derivatives(new derivative_type[num_quadrature_points]);
+    qf_derivatives_bytes_ = sizeof(derivative_type) * num_quadrature_points;
+
+    // the analytic cost of a call of each kernel, which is compared with the time spent in them to see
+    // how close they come to the bandwidth and flop rate of the machine
+    std::size_t qdata_bytes = 0;
+    if constexpr (!std::is_same_v<qdata_type, std::nullptr_t>) {
+      qdata_bytes = std::remove_pointer_t<qdata_type>::num_components * sizeof(double);
+    }
+    evaluation_cost_ = evaluation_kernel_cost<geometry, test_space, trial_space, geometry_dim, spatial_dim, Q,
+                                              derivative_type>(num_elements, qdata_bytes);
+    gradient_cost_ =
+        gradient_kernel_cost<geometry, test_space, trial_space, geometry_dim, spatial_dim, Q, derivative_type>(
+            num_elements);
 
     // this is where we actually specialize the finite element kernel templates with
     // our specific requirements (element type, test/trial spaces, quadrature rule, q-function, etc).
@@ -835,7 +1055,7 @@ public:
     //       to allow the evaluation kernel to pass derivative values to the gradient kernel
     evaluation_ = [=](const mfem::Vector& U, mfem::Vector& R) {
       evaluation_kernel<geometry, test_space, trial_space, geometry_dim, spatial_dim, Q>(U, R, qf_derivatives.get(), J_,
-                                                                                         X_, num_elements, qf);
+                                                                                         X_, num_elements, qf, data);
     };
 
     gradient_ = [=](const mfem::Vector& dU, mfem::Vector& dR) {
@@ -855,7 +1075,11 @@ public:
    * @param[out] output_E The output of the evalution; per-element DOF residuals
    * @see evaluation_kernel
    */
-  void Mult(const mfem::Vector& input_E, mfem::Vector& output_E) const { evaluation_(input_E, output_E); }
+  void Mult(const mfem::Vector& input_E, mfem::Vector& output_E) const
+  {
+    profiling::ScopedTimer timing(*evaluation_timer_);
+    evaluation_(input_E, output_E);
+  }
 
   /**
    * @brief Applies the integral, i.e., @a output_E = gradient( @a input_E )
@@ -863,7 +1087,11 @@ public:
    * @param[out] output_E The output of the evalution; per-element DOF residuals
    * @see gradient_kernel
    */
-  void GradientMult(const mfem::Vector& input_E, mfem::Vector& output_E) const { gradient_(input_E, output_E); }
+  void GradientMult(const mfem::Vector& input_E, mfem::Vector& output_E) const
+  {
+    profiling::ScopedTimer timing(*gradient_timer_);
+    gradient_(input_E, output_E);
+  }
 
   /**
    * @brief Computes the element stiffness matrices, storing them in an `mfem::Vector` that has been reshaped into a
@@ -873,6 +1101,32 @@ public:
    */
   void ComputeElementMatrices(mfem::Vector& K_e) const { gradient_mat_(K_e); }
 
+  /**
+   * @brief Returns the memory held by the integral
+   */
+  MemoryUsage memoryUsage() const
+  {
+    MemoryUsage usage;
+    usage.add("quadrature function derivatives", qf_derivatives_bytes_);
+    usage.add("Jacobians", memory::bytes(J_));
+    usage.add("positions", memory::bytes(X_));
+    return usage;
+  }
+
+  /**
+   * @brief Returns the analytic cost of a call of the evaluation and gradient kernels, with the number of calls and
+   * the time spent in them
+   * @see evaluation_kernel_cost, gradient_kernel_cost
+   */
+  std::vector<profiling::KernelPerformance> kernelPerformance() const
+  {
+    const auto seconds = [](const profiling::TimerRecord& timer) {
+      return static_cast<double>(timer.nanoseconds) * 1.0e-9;
+    };
+    return {{"evaluation", evaluation_cost_, evaluation_timer_->calls, seconds(*evaluation_timer_)},
+            {"gradient", gradient_cost_, gradient_timer_->calls, seconds(*gradient_timer_)}};
+  }
+
 private:
   /**
    * @brief Jacobians of the element transformations at all quadrature points
@@ -883,6 +1137,31 @@ private:
    */
   const mfem::Vector X_;
 
+  /**
+   * @brief The size of the derivatives of the quadrature function, which are owned by the kernels
+   */
+  std::size_t qf_derivatives_bytes_ = 0;
+
+  /**
+   * @brief The analytic cost of a call of the evaluation kernel
+   */
+  profiling::KernelCost evaluation_cost_;
+
+  /**
+   * @brief The analytic cost of a call of the gradient kernel
+   */
+  profiling::KernelCost gradient_cost_;
+
+  /**
+   * @brief The time spent in the evaluation kernel, which is shared by copies of the integral
+   */
+  std::shared_ptr<profiling::TimerRecord> evaluation_timer_ = std::make_shared<profiling::TimerRecord>();
+
+  /**
+   * @brief The time spent in the gradient kernel, which is shared by copies of the integral
+   */
+  std::shared_ptr<profiling::TimerRecord> gradient_timer_ = std::make_shared<profiling::TimerRecord>();
+
   /**
    * @brief Type-erased handle to evaluation kernel
    * @see evaluation_kernel
@@ -1386,7 +1386,7 @@ auto get_value(const tensor<dual<T>, n...>& arg)
  * @brief Retrieves the gradient component of a double (which is nothing)
  * @return The sentinel, @see zero
  */
-auto get_gradient(double /* arg */) { return zero{}; }
+inline auto get_gradient(double /* arg */) { return zero{}; }
 
 /**
  * @brief Retrieves a gradient tensor from a tensor of dual numbers
@@ -0,0 +1,176 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+// Compares the cost of the J2 material update with its hand-coded tangent against the same update with the tangent
+// from automatic differentiation, and times the tangent that this build of Serac uses
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "axom/slic.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/physics/materials/j2_material.hpp"
+
+using namespace serac;
+
+// impose some arbitrary time-dependent deformation
+auto displacement_gradient(double t)
+{
+  /** CUDA WORKAROUND deduction guide failed **/
+  return 10 * tensor<double, 3, 3>{{
+                  {sin(t), 0.0, 0.0},
+                  {0.0, t, exp(t) - 1},
+                  {0.0, 0.0, t * t},
+              }};
+}
+
+/**
+ * @brief The material used by all of the benchmarks, with a Young's modulus of 100 and a Poisson's ratio of 0.25
+ */
+static constexpr J2Material::Parameters parameters{
+    100.0 / (3.0 * (1.0 - 2.0 * 0.25)),  // bulk modulus
+    0.5 * 100.0 / (1.0 + 0.25),          // shear modulus
+    1.0,                                 // isotropic hardening modulus
+    2.3,                                 // kinematic hardening modulus
+    300.0                                // yield stress
+};
+
+/**
+ * @brief The displacement gradients of a loading history that yields partway through
+ */
+static std::vector<tensor<double, 3, 3> > loading_history()
+{
+  constexpr int                      steps = 1000;
+  std::vector<tensor<double, 3, 3> > history;
+  for (int i = 0; i < steps; i++) {
+    history.push_back(displacement_gradient(i * (1.0 / steps)));
+  }
+  return history;
+}
+
+/**
+ * @brief Checks that automatic differentiation reproduces the stresses, hand-coded tangents, and states of the
+ * material over the loading history
+ */
+static void verify()
+{
+  J2Material::State state{};
+  J2Material::State state_AD{};
+  for (const auto& grad_u : loading_history()) {
+    tensor<double, 3, 3>       stress       = J2Material::stress(parameters, sym(grad_u), state);
+    tensor<double, 3, 3, 3, 3> C            = J2Material::tangent(parameters, state);
+    auto                       stress_and_C = J2Material::stress(parameters, sym(make_dual(grad_u)), state_AD);
+
+    bool error_too_big =
+        (norm(stress - get_value(stress_and_C)) > 1.0e-12) || (norm(C - get_gradient(stress_and_C)) > 1.0e-12) ||
+        (norm(state.beta - state_AD.beta) > 1.0e-12) || (fabs(state.pl_strain - state_AD.pl_strain) > 1.0e-12);
+
+    SLIC_ERROR_IF(error_too_big, "Significant difference between expected and actual results. Exiting...");
+  }
+}
+
+static void BM_J2_stress(benchmark::State& state)
+{
+  const auto history = loading_history();
+
+  for (auto _ : state) {
+    // This code gets timed
+    J2Material::State material_state{};
+    for (const auto& grad_u : history) {
+      auto stress = J2Material::stress(parameters, sym(grad_u), material_state);
+      benchmark::DoNotOptimize(stress);
+    }
+  }
+
+  const auto evaluations        = static_cast<double>(history.size());
+  state.counters["evaluations"] = benchmark::Counter(evaluations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_J2_stress_and_gradient(benchmark::State& state)
+{
+  const auto history = loading_history();
+
+  for (auto _ : state) {
+    // This code gets timed
+    J2Material::State material_state{};
+    for (const auto& grad_u : history) {
+      auto stress = J2Material::stress(parameters, sym(grad_u), material_state);
+      auto C      = J2Material::tangent(parameters, material_state);
+      benchmark::DoNotOptimize(stress);
+      benchmark::DoNotOptimize(C);
+    }
+  }
+
+  const auto evaluations        = static_cast<double>(history.size());
+  state.counters["evaluations"] = benchmark::Counter(evaluations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_J2_stress_and_gradient_AD(benchmark::State& state)
+{
+  const auto history = loading_history();
+
+  for (auto _ : state) {
+    // This code gets timed
+    J2Material::State material_state{};
+    for (const auto& grad_u : history) {
+      auto stress_and_C = J2Material::stress(parameters, sym(make_dual(grad_u)), material_state);
+      benchmark::DoNotOptimize(stress_and_C);
+    }
+  }
+
+  const auto evaluations        = static_cast<double>(history.size());
+  state.counters["evaluations"] = benchmark::Counter(evaluations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/**
+ * @brief Times the stress and tangent used by J2Material::evalTangentStiffness with small strains, which is one of the
+ * two cases above depending on SERAC_ENABLE_J2_AD_TANGENT
+ */
+static void BM_J2_stress_and_gradient_configured(benchmark::State& state)
+{
+  const auto history = loading_history();
+
+  for (auto _ : state) {
+    // This code gets timed
+    J2Material::State material_state{};
+    for (const auto& grad_u : history) {
+      auto stress_and_C = J2Material::smallStrainStressAndTangent(parameters, grad_u, material_state);
+      benchmark::DoNotOptimize(stress_and_C);
+    }
+  }
+
+#ifdef SERAC_USE_J2_AD_TANGENT
+  state.SetLabel("dual number tangent");
+#else
+  state.SetLabel("hand-coded tangent");
+#endif
+  const auto evaluations        = static_cast<double>(history.size());
+  state.counters["evaluations"] = benchmark::Counter(evaluations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_J2_stress);
+BENCHMARK(BM_J2_stress_and_gradient);
+BENCHMARK(BM_J2_stress_and_gradient_AD);
+BENCHMARK(BM_J2_stress_and_gradient_configured);
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  ::benchmark::Initialize(&argc, argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  verify();
+
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
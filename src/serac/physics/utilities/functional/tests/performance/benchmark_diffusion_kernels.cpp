@@ -0,0 +1,395 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+// Compares the element kernels of mfem's partial assembly diffusion operator against diffusion kernels written
+// in the style of Functional, applied to all of the elements of a mesh of hexahedra. Before they are timed, the
+// Functional-style kernels are checked against the partial assembly kernel.
+
+#include <benchmark/benchmark.h>
+
+#include "mfem.hpp"
+
+#include "serac/numerics/mesh_utils_base.hpp"
+#include "serac/physics/utilities/functional/tensor.hpp"
+#include "serac/physics/utilities/functional/integral.hpp"
+#include "serac/physics/utilities/functional/quadrature.hpp"
+#include "serac/physics/utilities/functional/finite_element.hpp"
+#include "serac/physics/utilities/functional/tuple_arithmetic.hpp"
+
+using namespace serac;
+
+namespace mfem {
+
+/**
+ * @brief Computes the quadrature point data of mfem's partial assembly diffusion kernel for a unit coefficient,
+ * the symmetric matrix w det(J) J^{-1} J^{-T}, of which the upper triangle is stored
+ */
+static void PADiffusionSetup3D_(const int Q1D, const int NE, const Array<double>& w, const Vector& j, Vector& d)
+{
+  const int  num_points = Q1D * Q1D * Q1D;
+  const auto W          = Reshape(w.Read(), num_points);
+  const auto J          = Reshape(j.Read(), num_points, 3, 3, NE);
+  auto       D          = Reshape(d.Write(), num_points, 6, NE);
+  for (int e = 0; e < NE; e++) {
+    for (int q = 0; q < num_points; q++) {
+      const auto J_q   = serac::make_tensor<3, 3>([&](int i, int k) { return J(q, i, k, e); });
+      const auto inv_J = serac::inv(J_q);
+      const auto A     = (W(q) * serac::det(J_q)) * serac::dot(inv_J, serac::transpose(inv_J));
+      D(q, 0, e)       = A(0, 0);
+      D(q, 1, e)       = A(0, 1);
+      D(q, 2, e)       = A(0, 2);
+      D(q, 3, e)       = A(1, 1);
+      D(q, 4, e)       = A(1, 2);
+      D(q, 5, e)       = A(2, 2);
+    }
+  }
+}
+
+// PA Diffusion Apply 3D kernel
+template <int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApply3D_(const int NE, const bool symmetric, const Array<double>& b, const Array<double>& g,
+                                const Array<double>& bt, const Array<double>& gt, const Vector& d_, const Vector& x_,
+                                Vector& y_, int d1d = 0, int q1d = 0)
+{
+  const int D1D = T_D1D ? T_D1D : d1d;
+  const int Q1D = T_Q1D ? T_Q1D : q1d;
+  MFEM_VERIFY(D1D <= MAX_D1D, "");
+  MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+  auto B  = Reshape(b.Read(), Q1D, D1D);
+  auto G  = Reshape(g.Read(), Q1D, D1D);
+  auto Bt = Reshape(bt.Read(), D1D, Q1D);
+  auto Gt = Reshape(gt.Read(), D1D, Q1D);
+  auto D  = Reshape(d_.Read(), Q1D * Q1D * Q1D, symmetric ? 6 : 9, NE);
+  auto X  = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+  auto Y  = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+  for (int e = 0; e < NE; e++) {
+    constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+    constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+    double        grad[max_Q1D][max_Q1D][max_Q1D][3];
+    for (int qz = 0; qz < Q1D; ++qz) {
+      for (int qy = 0; qy < Q1D; ++qy) {
+        for (int qx = 0; qx < Q1D; ++qx) {
+          grad[qz][qy][qx][0] = 0.0;
+          grad[qz][qy][qx][1] = 0.0;
+          grad[qz][qy][qx][2] = 0.0;
+        }
+      }
+    }
+    for (int dz = 0; dz < D1D; ++dz) {
+      double gradXY[max_Q1D][max_Q1D][3];
+      for (int qy = 0; qy < Q1D; ++qy) {
+        for (int qx = 0; qx < Q1D; ++qx) {
+          gradXY[qy][qx][0] = 0.0;
+          gradXY[qy][qx][1] = 0.0;
+          gradXY[qy][qx][2] = 0.0;
+        }
+      }
+      for (int dy = 0; dy < D1D; ++dy) {
+        double gradX[max_Q1D][2];
+        for (int qx = 0; qx < Q1D; ++qx) {
+          gradX[qx][0] = 0.0;
+          gradX[qx][1] = 0.0;
+        }
+        for (int dx = 0; dx < D1D; ++dx) {
+          const double s = X(dx, dy, dz, e);
+          for (int qx = 0; qx < Q1D; ++qx) {
+            gradX[qx][0] += s * B(qx, dx);
+            gradX[qx][1] += s * G(qx, dx);
+          }
+        }
+        for (int qy = 0; qy < Q1D; ++qy) {
+          const double wy  = B(qy, dy);
+          const double wDy = G(qy, dy);
+          for (int qx = 0; qx < Q1D; ++qx) {
+            const double wx  = gradX[qx][0];
+            const double wDx = gradX[qx][1];
+            gradXY[qy][qx][0] += wDx * wy;
+            gradXY[qy][qx][1] += wx * wDy;
+            gradXY[qy][qx][2] += wx * wy;
+          }
+        }
+      }
+      for (int qz = 0; qz < Q1D; ++qz) {
+        const double wz  = B(qz, dz);
+        const double wDz = G(qz, dz);
+        for (int qy = 0; qy < Q1D; ++qy) {
+          for (int qx = 0; qx < Q1D; ++qx) {
+            grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+            grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+            grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+          }
+        }
+      }
+    }
+    // Calculate Dxyz, xDyz, xyDz in plane
+    for (int qz = 0; qz < Q1D; ++qz) {
+      for (int qy = 0; qy < Q1D; ++qy) {
+        for (int qx = 0; qx < Q1D; ++qx) {
+          const int    q      = qx + (qy + qz * Q1D) * Q1D;
+          const double O11    = D(q, 0, e);
+          const double O12    = D(q, 1, e);
+          const double O13    = D(q, 2, e);
+          const double O21    = symmetric ? O12 : D(q, 3, e);
+          const double O22    = symmetric ? D(q, 3, e) : D(q, 4, e);
+          const double O23    = symmetric ? D(q, 4, e) : D(q, 5, e);
+          const double O31    = symmetric ? O13 : D(q, 6, e);
+          const double O32    = symmetric ? O23 : D(q, 7, e);
+          const double O33    = symmetric ? D(q, 5, e) : D(q, 8, e);
+          const double gradX  = grad[qz][qy][qx][0];
+          const double gradY  = grad[qz][qy][qx][1];
+          const double gradZ  = grad[qz][qy][qx][2];
+          grad[qz][qy][qx][0] = (O11 * gradX) + (O12 * gradY) + (O13 * gradZ);
+          grad[qz][qy][qx][1] = (O21 * gradX) + (O22 * gradY) + (O23 * gradZ);
+          grad[qz][qy][qx][2] = (O31 * gradX) + (O32 * gradY) + (O33 * gradZ);
+        }
+      }
+    }
+    for (int qz = 0; qz < Q1D; ++qz) {
+      double gradXY[max_D1D][max_D1D][3];
+      for (int dy = 0; dy < D1D; ++dy) {
+        for (int dx = 0; dx < D1D; ++dx) {
+          gradXY[dy][dx][0] = 0;
+          gradXY[dy][dx][1] = 0;
+          gradXY[dy][dx][2] = 0;
+        }
+      }
+      for (int qy = 0; qy < Q1D; ++qy) {
+        double gradX[max_D1D][3];
+        for (int dx = 0; dx < D1D; ++dx) {
+          gradX[dx][0] = 0;
+          gradX[dx][1] = 0;
+          gradX[dx][2] = 0;
+        }
+        for (int qx = 0; qx < Q1D; ++qx) {
+          const double gX = grad[qz][qy][qx][0];
+          const double gY = grad[qz][qy][qx][1];
+          const double gZ = grad[qz][qy][qx][2];
+          for (int dx = 0; dx < D1D; ++dx) {
+            const double wx  = Bt(dx, qx);
+            const double wDx = Gt(dx, qx);
+            gradX[dx][0] += gX * wDx;
+            gradX[dx][1] += gY * wx;
+            gradX[dx][2] += gZ * wx;
+          }
+        }
+        for (int dy = 0; dy < D1D; ++dy) {
+          const double wy  = Bt(dy, qy);
+          const double wDy = Gt(dy, qy);
+          for (int dx = 0; dx < D1D; ++dx) {
+            gradXY[dy][dx][0] += gradX[dx][0] * wy;
+            gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+            gradXY[dy][dx][2] += gradX[dx][2] * wy;
+          }
+        }
+      }
+      for (int dz = 0; dz < D1D; ++dz) {
+        const double wz  = Bt(dz, qz);
+        const double wDz = Gt(dz, qz);
+        for (int dy = 0; dy < D1D; ++dy) {
+          for (int dx = 0; dx < D1D; ++dx) {
+            Y(dx, dy, dz, e) += ((gradXY[dy][dx][0] * wz) + (gradXY[dy][dx][1] * wz) + (gradXY[dy][dx][2] * wDz));
+          }
+        }
+      }
+    }
+  }
+}
+}  // namespace mfem
+
+template <Geometry g, int P, int Q, typename lambda>
+void H1_kernel(const mfem::Vector& U, mfem::Vector& R, const mfem::Vector& J_, int num_elements, lambda&& qf)
+{
+  using trial                      = H1<P>;
+  using test                       = H1<P>;
+  using test_element               = finite_element<g, trial>;
+  using trial_element              = finite_element<g, test>;
+  using element_residual_type      = typename trial_element::residual_type;
+  static constexpr int  dim        = dimension_of(g);
+  static constexpr int  test_ndof  = test_element::ndof;
+  static constexpr int  trial_ndof = trial_element::ndof;
+  static constexpr auto rule       = GaussQuadratureRule<g, Q>();
+
+  auto J = mfem::Reshape(J_.Read(), rule.size(), dim, dim, num_elements);
+  auto u = serac::detail::Reshape<trial>(U.Read(), trial_ndof, num_elements);
+  auto r = serac::detail::Reshape<test>(R.ReadWrite(), test_ndof, num_elements);
+
+  for (int e = 0; e < num_elements; e++) {
+    tensor u_elem = serac::detail::Load<trial_element>(u, e);
+
+    element_residual_type r_elem{};
+
+    for (int q = 0; q < static_cast<int>(rule.size()); q++) {
+      auto   xi  = rule.points[q];
+      auto   dxi = rule.weights[q];
+      auto   J_q = make_tensor<dim, dim>([&](int i, int j) { return J(q, i, j, e); });
+      double dx  = serac::detail::Measure(J_q) * dxi;
+
+      auto dN    = trial_element::shape_function_gradients(xi);
+      auto inv_J = inv(J_q);
+
+      auto grad_u = dot(dot(u_elem, dN), inv_J);
+
+      auto qf_output = qf(grad_u);
+
+      r_elem += dot(dN, dot(inv_J, qf_output)) * dx;
+    }
+
+    serac::detail::Add(r, r_elem, e);
+  }
+}
+
+template <Geometry g, int P, int Q, typename lambda>
+void H1_kernel_constexpr(const mfem::Vector& U, mfem::Vector& R, const mfem::Vector& J_, int num_elements, lambda&& qf)
+{
+  using trial                      = H1<P>;
+  using test                       = H1<P>;
+  using test_element               = finite_element<g, trial>;
+  using trial_element              = finite_element<g, test>;
+  using element_residual_type      = typename trial_element::residual_type;
+  static constexpr int  dim        = dimension_of(g);
+  static constexpr int  test_ndof  = test_element::ndof;
+  static constexpr int  trial_ndof = trial_element::ndof;
+  static constexpr auto rule       = GaussQuadratureRule<g, Q>();
+
+  auto J = mfem::Reshape(J_.Read(), rule.size(), dim, dim, num_elements);
+  auto u = serac::detail::Reshape<trial>(U.Read(), trial_ndof, num_elements);
+  auto r = serac::detail::Reshape<test>(R.ReadWrite(), test_ndof, num_elements);
+
+  for (int e = 0; e < num_elements; e++) {
+    tensor u_elem = serac::detail::Load<trial_element>(u, e);
+
+    element_residual_type r_elem{};
+
+    for_constexpr<rule.size()>([&](auto q) {
+      static constexpr auto xi  = rule.points[q];
+      static constexpr auto dxi = rule.weights[q];
+      auto                  J_q = make_tensor<dim, dim>([&](int i, int j) { return J(q, i, j, e); });
+      double                dx  = serac::detail::Measure(J_q) * dxi;
+
+      static constexpr auto dN    = trial_element::shape_function_gradients(xi);
+      auto                  inv_J = inv(J_q);
+
+      auto grad_u = dot(dot(u_elem, dN), inv_J);
+
+      auto qf_output = qf(grad_u);
+
+      r_elem += dot(dN, dot(inv_J, qf_output)) * dx;
+    });
+
+    serac::detail::Add(r, r_elem, e);
+  }
+}
+
+/**
+ * @brief The kernels that are compared
+ */
+enum class Kernel
+{
+  PartialAssembly,
+  H1,
+  H1Constexpr
+};
+
+template <int p, Kernel kernel>
+static void BM_diffusion(benchmark::State& state)
+{
+  constexpr int D1D = p + 1;
+  constexpr int Q1D = p + 1;
+
+  // The size of the problem is the number of uniform refinements of the mesh
+  mfem::Mesh mesh = serac::buildCuboidMesh(4, 4, 4);
+  for (int i = 0; i < state.range(0); i++) {
+    mesh.UniformRefinement();
+  }
+  mfem::H1_FECollection    fec(p, 3);
+  mfem::FiniteElementSpace fespace(&mesh, &fec);
+  const int                num_elements = mesh.GetNE();
+
+  const mfem::FiniteElement&   el   = *(fespace.GetFE(0));
+  const mfem::IntegrationRule& ir   = mfem::IntRules.Get(el.GetGeomType(), el.GetOrder() * 2);
+  const auto*                  geom = mesh.GetGeometricFactors(ir, mfem::GeometricFactors::JACOBIANS);
+  const auto&                  maps = el.GetDofToQuad(ir, mfem::DofToQuad::TENSOR);
+
+  const int    element_dofs = D1D * D1D * D1D * num_elements;
+  mfem::Vector U_E(element_dofs);
+  mfem::Vector R_E(element_dofs);
+  U_E.Randomize();
+  R_E = 0.0;
+
+  [[maybe_unused]] static constexpr double k               = 1.0;
+  constexpr auto                           diffusion_qfunc = [](auto grad_u) {
+    return k * grad_u;  // heat_flux
+  };
+
+  // The partial assembly kernel reads its quadrature point data, the others read the Jacobians
+  mfem::Vector D(Q1D * Q1D * Q1D * 6 * num_elements);
+  mfem::PADiffusionSetup3D_(Q1D, num_elements, ir.GetWeights(), geom->J, D);
+  const double quadrature_data_bytes =
+      ((kernel == Kernel::PartialAssembly) ? D.Size() : geom->J.Size()) * static_cast<double>(sizeof(double));
+
+  const auto apply = [&](mfem::Vector& R) {
+    if constexpr (kernel == Kernel::PartialAssembly) {
+      mfem::PADiffusionApply3D_<D1D, Q1D>(num_elements, true, maps.B, maps.G, maps.Bt, maps.Gt, D, U_E, R);
+    } else if constexpr (kernel == Kernel::H1) {
+      H1_kernel<Geometry::Hexahedron, p, Q1D>(U_E, R, geom->J, num_elements, diffusion_qfunc);
+    } else {
+      H1_kernel_constexpr<Geometry::Hexahedron, p, Q1D>(U_E, R, geom->J, num_elements, diffusion_qfunc);
+    }
+  };
+
+  // The kernels should only differ by round-off, otherwise their timings are not comparable
+  if constexpr (kernel != Kernel::PartialAssembly) {
+    mfem::Vector expected(element_dofs);
+    mfem::Vector difference(element_dofs);
+    expected   = 0.0;
+    difference = 0.0;
+    mfem::PADiffusionApply3D_<D1D, Q1D>(num_elements, true, maps.B, maps.G, maps.Bt, maps.Gt, D, U_E, expected);
+    apply(difference);
+    difference -= expected;
+
+    constexpr double tolerance = 1.0e-10;
+    if (difference.Norml2() > tolerance * expected.Norml2()) {
+      state.SkipWithError("The element residuals differ from those of the partial assembly kernel");
+      return;
+    }
+  }
+
+  for (auto _ : state) {
+    // This code gets timed
+    apply(R_E);
+  }
+  benchmark::DoNotOptimize(R_E.GetData());
+
+  // The element values are read, the element residuals are read and written
+  const double bytes      = 3.0 * element_dofs * sizeof(double) + quadrature_data_bytes;
+  state.counters["DOFs"]  = benchmark::Counter(element_dofs, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["bytes"] = benchmark::Counter(bytes, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_diffusion, 1, Kernel::PartialAssembly)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 1, Kernel::H1)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 1, Kernel::H1Constexpr)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 2, Kernel::PartialAssembly)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 2, Kernel::H1)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 2, Kernel::H1Constexpr)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 3, Kernel::PartialAssembly)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 3, Kernel::H1)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_diffusion, 3, Kernel::H1Constexpr)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  ::benchmark::Initialize(&argc, argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
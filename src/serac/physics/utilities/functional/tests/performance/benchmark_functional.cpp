@@ -0,0 +1,252 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+// Compares the action of a residual evaluated with Functional against the same operator applied with mfem's partial
+// assembly and with a matrix assembled by mfem's (legacy) integrators, sweeping over the element geometry, the
+// polynomial order, the q-function, and the size of the mesh
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "mfem.hpp"
+
+#include "serac/infrastructure/memory_usage.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/numerics/mesh_utils_base.hpp"
+#include "serac/physics/utilities/functional/functional.hpp"
+
+using namespace serac;
+
+/**
+ * @brief The ways of applying the operator
+ */
+enum class Path
+{
+  Functional,
+  PartialAssembly,
+  LegacyAssembled
+};
+
+/**
+ * @brief The q-functions, only the linear ones can be expressed with mfem's integrators
+ */
+enum class QFunction
+{
+  Diffusion,
+  MassDiffusion,
+  NonlinearDiffusion
+};
+
+/**
+ * @brief Builds a mesh of quadrilaterals or hexahedra
+ *
+ * @param[in] dim The dimension of the mesh
+ * @param[in] refinements The number of uniform refinements, which sets the size of the problem
+ */
+static std::unique_ptr<mfem::ParMesh> build_mesh(int dim, int refinements)
+{
+  if (dim == 2) {
+    return mesh::refineAndDistribute(buildRectangleMesh(8, 8), refinements);
+  }
+  return mesh::refineAndDistribute(buildCuboidMesh(4, 4, 4), refinements);
+}
+
+/**
+ * @brief Reports the rates of degrees of freedom, bytes, and floating point operations processed by each application
+ * of the operator
+ *
+ * @param[in] state The benchmark state
+ * @param[in] dofs The true degrees of freedom of the operator on this rank
+ * @param[in] bytes An estimate of the memory traffic of one application on this rank
+ * @param[in] flops The floating point operations of one application on this rank, which are only reported if known
+ * @note The counters are summed over the ranks
+ */
+static void set_counters(benchmark::State& state, double dofs, double bytes, double flops = 0.0)
+{
+  double local[3] = {dofs, bytes, flops};
+  double total[3];
+  MPI_Allreduce(local, total, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  state.counters["DOFs"]  = benchmark::Counter(total[0], benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["bytes"] = benchmark::Counter(total[1], benchmark::Counter::kIsIterationInvariantRate);
+  if (total[2] > 0.0) {
+    state.counters["FLOPs"] = benchmark::Counter(total[2], benchmark::Counter::kIsIterationInvariantRate);
+  }
+}
+
+/**
+ * @brief Returns the bytes of the vectors each matrix-free path streams through: the true, local, and element
+ * vectors, each read once and written once for the input and for the output
+ *
+ * @param[in] fespace The finite element space of the input and output
+ */
+static double matrix_free_vector_bytes(mfem::ParFiniteElementSpace& fespace)
+{
+  const auto* G = fespace.GetElementRestriction(mfem::ElementDofOrdering::LEXICOGRAPHIC);
+  return 4.0 * (fespace.GetTrueVSize() + fespace.GetVSize() + G->Height()) * sizeof(double);
+}
+
+template <int p, int dim, QFunction qfunction, Path path>
+static void BM_apply(benchmark::State& state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  static constexpr double a = 1.7;
+  static constexpr double b = 2.1;
+
+  auto                        mesh = build_mesh(dim, static_cast<int>(state.range(0)));
+  mfem::H1_FECollection       fec(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector U(fespace.GetTrueVSize());
+  mfem::Vector R(fespace.GetTrueVSize());
+  U.Randomize();
+
+  // All of the paths use the p + 1 point Gauss rule of Functional
+  const mfem::IntegrationRule& ir = mfem::IntRules.Get(fespace.GetFE(0)->GetGeomType(), 2 * p + 1);
+
+  double bytes = 0.0;
+  double flops = 0.0;
+
+  if constexpr (path == Path::Functional) {
+    Functional<H1<p>(H1<p>)> residual(&fespace, &fespace);
+    residual.AddDomainIntegral(
+        Dimension<dim>{},
+        [](auto /* x */, auto temperature) {
+          auto [u, du_dx] = temperature;
+          if constexpr (qfunction == QFunction::Diffusion) {
+            return std::tuple{0.0 * u, b * du_dx};
+          }
+          if constexpr (qfunction == QFunction::MassDiffusion) {
+            return std::tuple{a * u, b * du_dx};
+          }
+          if constexpr (qfunction == QFunction::NonlinearDiffusion) {
+            return std::tuple{a * u, (1.0 + u * u) * du_dx};
+          }
+        },
+        *mesh);
+
+    for (auto _ : state) {
+      // This code gets timed
+      residual.Mult(U, R);
+    }
+
+    // The analytic cost of the evaluation kernel, which does not count the flops of the q-function itself
+    const auto kernel = residual.kernelPerformance().front();
+    bytes             = matrix_free_vector_bytes(fespace) + kernel.cost.bytes;
+    flops             = kernel.cost.flops;
+  } else {
+    static_assert(qfunction != QFunction::NonlinearDiffusion, "mfem's integrators are linear");
+
+    mfem::ConstantCoefficient a_coef(a);
+    mfem::ConstantCoefficient b_coef(b);
+
+    mfem::ParBilinearForm A(&fespace);
+    if constexpr (path == Path::PartialAssembly) {
+      A.SetAssemblyLevel(mfem::AssemblyLevel::PARTIAL);
+    }
+    auto diffusion = new mfem::DiffusionIntegrator(b_coef);
+    diffusion->SetIntRule(&ir);
+    A.AddDomainIntegrator(diffusion);
+    if constexpr (qfunction == QFunction::MassDiffusion) {
+      auto mass = new mfem::MassIntegrator(a_coef);
+      mass->SetIntRule(&ir);
+      A.AddDomainIntegrator(mass);
+    }
+    A.Assemble(0);
+
+    if constexpr (path == Path::PartialAssembly) {
+      mfem::Array<int>  no_essential_dofs;
+      mfem::OperatorPtr op;
+      A.FormSystemMatrix(no_essential_dofs, op);
+
+      for (auto _ : state) {
+        // This code gets timed
+        op->Mult(U, R);
+      }
+
+      // The symmetric diffusion coefficient, and the mass coefficient, are read at each quadrature point
+      const int    doubles_per_point = dim * (dim + 1) / 2 + (qfunction == QFunction::MassDiffusion ? 1 : 0);
+      const double points            = static_cast<double>(mesh->GetNE()) * ir.GetNPoints();
+      bytes = matrix_free_vector_bytes(fespace) + points * doubles_per_point * sizeof(double);
+    } else {
+      A.Finalize();
+      std::unique_ptr<mfem::HypreParMatrix> K(A.ParallelAssemble());
+
+      for (auto _ : state) {
+        // This code gets timed
+        K->Mult(U, R);
+      }
+
+      // The matrix is read, and the true vectors read and written, once
+      bytes = static_cast<double>(memory::bytes(*K)) + 2.0 * fespace.GetTrueVSize() * sizeof(double);
+    }
+  }
+
+  set_counters(state, fespace.GetTrueVSize(), bytes, flops);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/**
+ * @brief Registers the sweep over the q-functions and the paths for one geometry and polynomial order
+ *
+ * @param[in] max_refinements The largest number of uniform refinements of the mesh
+ */
+template <int p, int dim>
+void register_benchmarks(int max_refinements)
+{
+  const std::string element = (dim == 2) ? "quad" : "hex";
+  const auto        name    = [&](const std::string& path, const std::string& qfunction) {
+    return path + "/" + qfunction + "/" + element + "/p:" + std::to_string(p);
+  };
+  const auto add = [max_refinements](const std::string& benchmark_name, void (*function)(benchmark::State&)) {
+    benchmark::RegisterBenchmark(benchmark_name.c_str(), function)
+        ->DenseRange(0, max_refinements)
+        ->Unit(benchmark::kMillisecond);
+  };
+
+  add(name("functional", "diffusion"), BM_apply<p, dim, QFunction::Diffusion, Path::Functional>);
+  add(name("functional", "mass_diffusion"), BM_apply<p, dim, QFunction::MassDiffusion, Path::Functional>);
+  add(name("functional", "nonlinear_diffusion"), BM_apply<p, dim, QFunction::NonlinearDiffusion, Path::Functional>);
+  add(name("mfem_pa", "diffusion"), BM_apply<p, dim, QFunction::Diffusion, Path::PartialAssembly>);
+  add(name("mfem_pa", "mass_diffusion"), BM_apply<p, dim, QFunction::MassDiffusion, Path::PartialAssembly>);
+  add(name("mfem_legacy", "diffusion"), BM_apply<p, dim, QFunction::Diffusion, Path::LegacyAssembled>);
+  add(name("mfem_legacy", "mass_diffusion"), BM_apply<p, dim, QFunction::MassDiffusion, Path::LegacyAssembled>);
+}
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::benchmark::Initialize(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+
+  // The bandwidth the byte counters can be compared with
+  const double bandwidth = profiling::streamBandwidth();
+  SLIC_INFO_ROOT(fmt::format("STREAM triad bandwidth: {0:.3f} GB/s", bandwidth * 1.0e-9));
+
+  register_benchmarks<1, 2>(3);
+  register_benchmarks<2, 2>(3);
+  register_benchmarks<3, 2>(3);
+  register_benchmarks<1, 3>(2);
+  register_benchmarks<2, 3>(2);
+  register_benchmarks<3, 3>(2);
+
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -4,103 +4,20 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
-#include <chrono>
-#include <iostream>
+// Compares ways of evaluating the gradients of a hexahedral H1 element at all of its quadrature points: sum
+// factorization (as in mfem's partial assembly kernels) against contracting with the gradients of the shape functions
+// at each point (as in the Functional kernels)
 
-#include "mfem.hpp"
+#include <string>
 
-#include "serac/serac_config.hpp"
-#include "serac/numerics/expr_template_ops.hpp"
-
-#include "axom/core/utilities/Timer.hpp"
+#include <benchmark/benchmark.h>
 
 #include "serac/physics/utilities/functional/tensor.hpp"
-#include "serac/physics/utilities/functional/integral.hpp"
 #include "serac/physics/utilities/functional/quadrature.hpp"
 #include "serac/physics/utilities/functional/finite_element.hpp"
-#include "serac/physics/utilities/functional/tuple_arithmetic.hpp"
-
-static void escape([[maybe_unused]] void* p) { asm volatile("" : : "g"(p) : "memory"); }
-
-// static void clobber() {
-//  asm volatile("" : : : "memory");
-//}
 
 using namespace serac;
 
-template <int Q1D, int D1D>
-auto count_ops0(tensor<double, D1D, D1D, D1D> x)
-{
-  static constexpr auto xi = GaussLegendreNodes<Q1D>();
-
-  auto B = make_tensor<D1D, Q1D>([](auto i, auto j) { return GaussLobattoInterpolation<D1D>(xi[j])[i]; });
-
-  auto G = make_tensor<D1D, Q1D>([](auto i, auto j) { return GaussLobattoInterpolationDerivative<D1D>(xi[j])[i]; });
-
-  int count = 0;
-
-  tensor<double, Q1D, Q1D, Q1D, 3> grad{};
-  for (int dz = 0; dz < D1D; ++dz) {
-    tensor<double, Q1D, Q1D, 3> gradXY{};
-    for (int dy = 0; dy < D1D; ++dy) {
-      tensor<double, Q1D, 2> gradX{};
-      for (int dx = 0; dx < D1D; ++dx) {
-        const double s = x(dx, dy, dz);
-        for (int qx = 0; qx < Q1D; ++qx) {
-          gradX[qx][0] += s * B(qx, dx);
-          gradX[qx][1] += s * G(qx, dx);
-          count += 2;
-        }
-      }
-      for (int qy = 0; qy < Q1D; ++qy) {
-        const double wy  = B(qy, dy);
-        const double wDy = G(qy, dy);
-        for (int qx = 0; qx < Q1D; ++qx) {
-          const double wx  = gradX[qx][0];
-          const double wDx = gradX[qx][1];
-          gradXY[qy][qx][0] += wDx * wy;
-          gradXY[qy][qx][1] += wx * wDy;
-          gradXY[qy][qx][2] += wx * wy;
-          count += 3;
-        }
-      }
-    }
-    for (int qz = 0; qz < Q1D; ++qz) {
-      const double wz  = B(qz, dz);
-      const double wDz = G(qz, dz);
-      for (int qy = 0; qy < Q1D; ++qy) {
-        for (int qx = 0; qx < Q1D; ++qx) {
-          grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-          grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-          grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
-          count += 3;
-        }
-      }
-    }
-  }
-
-  return count;
-}
-
-template <int Q1D, int D1D>
-auto count_ops1(tensor<double, D1D * D1D * D1D> x)
-{
-  using element_type = finite_element< ::Geometry::Hexahedron, H1<D1D - 1> >;
-
-  auto xi = GaussLegendreNodes<Q1D>();
-
-  tensor<double, Q1D, Q1D, Q1D, 3> grad{};
-
-  int count = 0;
-
-  for_constexpr<Q1D, Q1D, Q1D>([&](auto i, auto j, auto k) {
-    grad[i][j][k] = dot(x, element_type::shape_function_gradients({xi[i], xi[j], xi[k]}));
-    count += D1D * D1D * D1D * 3;
-  });
-
-  return count;
-}
-
 template <int Q1D, int D1D>
 auto compute_all_gradients0(const tensor<double, D1D, D1D, D1D>& x)
 {
@@ -306,120 +223,91 @@ auto compute_all_gradients5(const tensor<double, D1D * D1D * D1D>& u)
   return grad;
 }
 
-template <typename lambda>
-auto time(lambda&& f)
+/**
+ * @brief The number of multiply-adds to evaluate the gradients of an element with sum factorization
+ */
+template <int Q1D, int D1D>
+constexpr int sum_factorization_ops()
 {
-  axom::utilities::Timer stopwatch;
-  stopwatch.start();
-  f();
-  stopwatch.stop();
-  return stopwatch.elapsed();
+  return 2 * D1D * D1D * D1D * Q1D + 3 * D1D * D1D * Q1D * Q1D + 3 * D1D * Q1D * Q1D * Q1D;
 }
 
+/**
+ * @brief The number of multiply-adds to evaluate the gradients of an element one quadrature point at a time
+ */
 template <int Q1D, int D1D>
-void run_tests(int n)
+constexpr int pointwise_ops()
 {
-  tensor<double, D1D, D1D, D1D>   y;
-  tensor<double, D1D * D1D * D1D> y2;
-
-  std::cout << "running tests " << n << " times, with D1D: " << D1D << ", Q1D: " << Q1D << std::endl;
-
-  std::cout << "ops (compute all quadrature point values together): " << count_ops0<Q1D, D1D>(y) << std::endl;
-  std::cout << "ops (compute all quadrature point values individually): " << count_ops1<Q1D, D1D>(y2) << std::endl;
-
-  std::cout << "average tensor creation time: "
-            << time([&]() {
-                 for (int i = 0; i < n; i++) {
-                   auto x = make_tensor<D1D * D1D * D1D, 3>([=](int I, int J) { return n / (I + J + 1.0); });
-                   escape(&x);
-                 }
-               }) / n
-            << std::endl;
-
-  double baseline = time([&]() {
-                      for (int i = 0; i < n; i++) {
-                        auto x = compute_all_gradients0<Q1D, D1D>(y);
-                        escape(&x);
-                      }
-                    }) /
-                    n;
-
-  std::cout << "average gradient 0 time: " << baseline << std::endl;
-
-  {
-    double runtime = time([&]() {
-                       for (int i = 0; i < n; i++) {
-                         auto x = compute_all_gradients1<Q1D, D1D>(y);
-                         escape(&x);
-                       }
-                     }) /
-                     n;
-
-    std::cout << "average gradient 1 time: " << runtime << " (relative speedup vs. gradient 0): " << baseline / runtime
-              << std::endl;
-  }
-
-  {
-    double runtime = time([&]() {
-                       for (int i = 0; i < n; i++) {
-                         auto x = compute_all_gradients2<Q1D, D1D>(y2);
-                         escape(&x);
-                       }
-                     }) /
-                     n;
-
-    std::cout << "average gradient 2 time: " << runtime << " (relative speedup vs. gradient 0): " << baseline / runtime
-              << std::endl;
-  }
-
-  {
-    double runtime = time([&]() {
-                       for (int i = 0; i < n; i++) {
-                         auto x = compute_all_gradients3<Q1D, D1D>(y2);
-                         escape(&x);
-                       }
-                     }) /
-                     n;
-
-    std::cout << "average gradient 3 time: " << runtime << " (relative speedup vs. gradient 0): " << baseline / runtime
-              << std::endl;
-  }
+  return 3 * D1D * D1D * D1D * Q1D * Q1D * Q1D;
+}
 
-  {
-    double runtime = time([&]() {
-                       for (int i = 0; i < n; i++) {
-                         auto x = compute_all_gradients4<Q1D, D1D>(y2);
-                         escape(&x);
-                       }
-                     }) /
-                     n;
-
-    std::cout << "average gradient 4 time: " << runtime << " (relative speedup vs. gradient 0): " << baseline / runtime
-              << std::endl;
+template <int Q1D, int D1D, int variant>
+static void BM_gradients(benchmark::State& state)
+{
+  auto x      = make_tensor<D1D, D1D, D1D>([](int i, int j, int k) { return 1.0 / (i + 2.0 * j + 3.0 * k + 1.0); });
+  auto x_flat = make_tensor<D1D * D1D * D1D>([](int i) { return 1.0 / (i + 1.0); });
+
+  for (auto _ : state) {
+    // This code gets timed
+    if constexpr (variant == 0) {
+      auto grad = compute_all_gradients0<Q1D, D1D>(x);
+      benchmark::DoNotOptimize(grad);
+    }
+    if constexpr (variant == 1) {
+      auto grad = compute_all_gradients1<Q1D, D1D>(x);
+      benchmark::DoNotOptimize(grad);
+    }
+    if constexpr (variant == 2) {
+      auto grad = compute_all_gradients2<Q1D, D1D>(x_flat);
+      benchmark::DoNotOptimize(grad);
+    }
+    if constexpr (variant == 3) {
+      auto grad = compute_all_gradients3<Q1D, D1D>(x_flat);
+      benchmark::DoNotOptimize(grad);
+    }
+    if constexpr (variant == 4) {
+      auto grad = compute_all_gradients4<Q1D, D1D>(x_flat);
+      benchmark::DoNotOptimize(grad);
+    }
+    if constexpr (variant == 5) {
+      auto grad = compute_all_gradients5<Q1D, D1D>(x_flat);
+      benchmark::DoNotOptimize(grad);
+    }
   }
 
-  {
-    double runtime = time([&]() {
-                       for (int i = 0; i < n; i++) {
-                         auto x = compute_all_gradients5<Q1D, D1D>(y2);
-                         escape(&x);
-                       }
-                     }) /
-                     n;
-
-    std::cout << "average gradient 5 time: " << runtime << " (relative speedup vs. gradient 0): " << baseline / runtime
-              << std::endl;
-  }
+  // The element values are read, and the gradients written, once per evaluation
+  constexpr double multiply_adds = (variant < 2) ? sum_factorization_ops<Q1D, D1D>() : pointwise_ops<Q1D, D1D>();
+  constexpr double bytes         = (D1D * D1D * D1D + 3 * Q1D * Q1D * Q1D) * sizeof(double);
+  state.counters["DOFs"]         = benchmark::Counter(D1D * D1D * D1D, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["FLOPs"]        = benchmark::Counter(2 * multiply_adds, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["bytes"]        = benchmark::Counter(bytes, benchmark::Counter::kIsIterationInvariantRate);
+}
 
-  std::cout << std::endl;
-  std::cout << std::endl;
+/**
+ * @brief Registers each way of evaluating the gradients for elements with D1D nodes and Q1D quadrature points per
+ * direction
+ */
+template <int Q1D, int D1D>
+void register_benchmarks()
+{
+  const std::string suffix = "/D1D:" + std::to_string(D1D) + "/Q1D:" + std::to_string(Q1D);
+  benchmark::RegisterBenchmark(("sum_factorization" + suffix).c_str(), BM_gradients<Q1D, D1D, 0>);
+  benchmark::RegisterBenchmark(("sum_factorization_constexpr" + suffix).c_str(), BM_gradients<Q1D, D1D, 1>);
+  benchmark::RegisterBenchmark(("shape_function_gradients" + suffix).c_str(), BM_gradients<Q1D, D1D, 2>);
+  benchmark::RegisterBenchmark(("shape_function_gradients_constexpr" + suffix).c_str(), BM_gradients<Q1D, D1D, 3>);
+  benchmark::RegisterBenchmark(("pointwise_1D_products" + suffix).c_str(), BM_gradients<Q1D, D1D, 4>);
+  benchmark::RegisterBenchmark(("pointwise_1D_products_constexpr" + suffix).c_str(), BM_gradients<Q1D, D1D, 5>);
 }
 
-int main()
+int main(int argc, char* argv[])
 {
-  run_tests<2, 2>(10000);
-  run_tests<3, 3>(2000);
-  run_tests<4, 4>(1000);
+  ::benchmark::Initialize(&argc, argv);
+
+  register_benchmarks<2, 2>();
+  register_benchmarks<3, 3>();
+  register_benchmarks<4, 4>();
+
+  ::benchmark::RunSpecifiedBenchmarks();
 
   return 0;
 }
@@ -0,0 +1,132 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/jacobian_free_operator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac::mfem_ext {
+
+FiniteDifferenceJacobian::FiniteDifferenceJacobian(MPI_Comm comm, const mfem::Operator& residual)
+    : mfem::Operator(residual.Height(), residual.Width()), comm_(comm), residual_(residual)
+{
+}
+
+void FiniteDifferenceJacobian::linearize(const mfem::Vector& point, const mfem::Vector& residual_at_point)
+{
+  point_             = point;
+  residual_at_point_ = residual_at_point;
+}
+
+void FiniteDifferenceJacobian::Mult(const mfem::Vector& direction, mfem::Vector& derivative) const
+{
+  direction_ = direction;
+  if (essential_dofs_) {
+    direction_.SetSubVector(*essential_dofs_, 0.0);
+  }
+
+  const double direction_norm = std::sqrt(mfem::InnerProduct(comm_, direction_, direction_));
+  if (direction_norm > 0.0) {
+    const double point_norm = std::sqrt(mfem::InnerProduct(comm_, point_, point_));
+    const double step = std::sqrt((1.0 + point_norm) * std::numeric_limits<double>::epsilon()) / direction_norm;
+
+    perturbed_.SetSize(point_.Size());
+    add(point_, step, direction_, perturbed_);
+    derivative.SetSize(height);
+    residual_.Mult(perturbed_, derivative);
+    derivative -= residual_at_point_;
+    derivative *= 1.0 / step;
+  } else {
+    derivative.SetSize(height);
+    derivative = 0.0;
+  }
+
+  // The eliminated rows and columns have ones on the diagonal
+  if (essential_dofs_) {
+    for (auto dof : *essential_dofs_) {
+      derivative(dof) = direction(dof);
+    }
+  }
+}
+
+JacobianFreeOperator::JacobianFreeOperator(MPI_Comm comm, const mfem::Operator& residual,
+                                           const JacobianFreeOptions& options, mfem::IterativeSolver& krylov_solver,
+                                           LaggedPreconditioner* preconditioner)
+    : mfem::Operator(residual.Height(), residual.Width()),
+      comm_(comm),
+      residual_(residual),
+      options_(options),
+      krylov_solver_(krylov_solver),
+      preconditioner_(preconditioner),
+      jacobian_(comm, residual),
+      gradients_since_update_(options.preconditioner_lag),
+      forcing_term_(options.initial_forcing_term)
+{
+  SLIC_ERROR_ROOT_IF(options.preconditioner_lag < 1, "The preconditioner lag must be at least one Newton iteration");
+  SLIC_ERROR_ROOT_IF(options.gamma <= 0.0 || options.gamma > 1.0, "The forcing term gamma must be in (0, 1]");
+}
+
+void JacobianFreeOperator::beginSolve(const mfem::Vector& rhs)
+{
+  rhs_           = &rhs;
+  previous_norm_ = -1.0;
+  forcing_term_  = options_.initial_forcing_term;
+}
+
+void JacobianFreeOperator::Mult(const mfem::Vector& x, mfem::Vector& r) const
+{
+  residual_.Mult(x, r);
+  last_point_    = x;
+  last_residual_ = r;
+}
+
+mfem::Operator& JacobianFreeOperator::GetGradient(const mfem::Vector& x) const
+{
+  // Newton solvers ask for the gradient where they last evaluated the residual, which is usually kept
+  const bool kept = (last_point_.Size() == x.Size()) &&
+                    std::equal(x.HostRead(), x.HostRead() + x.Size(), last_point_.HostRead());
+  if (!kept) {
+    last_residual_.SetSize(height);
+    Mult(x, last_residual_);
+  }
+  jacobian_.linearize(last_point_, last_residual_);
+
+  if (preconditioner_ && gradients_since_update_ >= options_.preconditioner_lag) {
+    preconditioner_->update(residual_.GetGradient(x));
+    gradients_since_update_ = 0;
+  }
+  gradients_since_update_++;
+
+  // The norm of the nonlinear residual, whose right-hand side is zero if it has no entries
+  double     norm_squared = 0.0;
+  const bool has_rhs      = (rhs_ != nullptr) && (rhs_->Size() == height);
+  for (int i = 0; i < height; i++) {
+    const double entry = has_rhs ? last_residual_(i) - (*rhs_)(i) : last_residual_(i);
+    norm_squared += entry * entry;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &norm_squared, 1, MPI_DOUBLE, MPI_SUM, comm_);
+  const double norm = std::sqrt(norm_squared);
+
+  if (previous_norm_ > 0.0) {
+    const double alpha     = 0.5 * (1.0 + std::sqrt(5.0));
+    const double safeguard = options_.gamma * std::pow(forcing_term_, alpha);
+    double       eta       = options_.gamma * std::pow(norm / previous_norm_, alpha);
+    if (safeguard > 0.1) {
+      eta = std::max(eta, safeguard);
+    }
+    forcing_term_ = std::min(eta, options_.max_forcing_term);
+  }
+  previous_norm_ = norm;
+  krylov_solver_.SetRelTol(forcing_term_);
+
+  return jacobian_;
+}
+
+}  // namespace serac::mfem_ext
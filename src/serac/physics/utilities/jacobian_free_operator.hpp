@@ -0,0 +1,258 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file jacobian_free_operator.hpp
+ *
+ * @brief Operators for Jacobian-free Newton-Krylov solves
+ */
+
+#pragma once
+
+#include "mfem.hpp"
+#include "mpi.h"
+
+#include "serac/physics/utilities/solver_config.hpp"
+
+namespace serac::mfem_ext {
+
+/**
+ * @brief The Jacobian of a residual at a point, applied by directional finite differences of the residual
+ *
+ * The product with a direction v is (F(x + h v) - F(x)) / h, with the step h = sqrt((1 + |x|) eps) / |v| balancing the
+ * truncation and the round-off errors. Like the assembled Jacobians of the physics modules, the rows and columns of
+ * the essential degrees of freedom are eliminated, with ones on the diagonal: the residual is expected to be zero at
+ * these degrees of freedom.
+ */
+class FiniteDifferenceJacobian : public mfem::Operator {
+public:
+  /**
+   * @brief Constructs the Jacobian of a residual
+   * @param[in] comm The communicator of the vectors
+   * @param[in] residual The residual, which must outlive the Jacobian
+   */
+  FiniteDifferenceJacobian(MPI_Comm comm, const mfem::Operator& residual);
+
+  /**
+   * @brief Sets the point to linearize about
+   * @param[in] point The point, which is copied
+   * @param[in] residual_at_point The residual at the point, which is copied
+   */
+  void linearize(const mfem::Vector& point, const mfem::Vector& residual_at_point);
+
+  /**
+   * @brief Sets the essential degrees of freedom to eliminate
+   * @param[in] dofs The local true degrees of freedom, which are referenced, so that updates are seen
+   */
+  void setEssentialDofs(const mfem::Array<int>& dofs) { essential_dofs_ = &dofs; }
+
+  /**
+   * @brief Applies the Jacobian
+   * @param[in] direction The direction to differentiate the residual in
+   * @param[out] derivative The directional derivative
+   * @note This is a collective operation, which evaluates the residual once
+   */
+  void Mult(const mfem::Vector& direction, mfem::Vector& derivative) const override;
+
+private:
+  /**
+   * @brief The communicator of the vectors
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The residual
+   */
+  const mfem::Operator& residual_;
+
+  /**
+   * @brief The essential degrees of freedom, if any
+   */
+  const mfem::Array<int>* essential_dofs_ = nullptr;
+
+  /**
+   * @brief The point the residual is linearized about
+   */
+  mfem::Vector point_;
+
+  /**
+   * @brief The residual at point_
+   */
+  mfem::Vector residual_at_point_;
+
+  /**
+   * @brief The direction without its essential components
+   */
+  mutable mfem::Vector direction_;
+
+  /**
+   * @brief The point moved along direction_
+   */
+  mutable mfem::Vector perturbed_;
+};
+
+/**
+ * @brief A preconditioner that is only updated with assembled Jacobians
+ *
+ * A Krylov solver sets the operator it solves with as the operator of its preconditioner. In a Jacobian-free solve,
+ * that is a FiniteDifferenceJacobian, which can't be used to set up a preconditioner, so this ignores it and the
+ * underlying preconditioner is updated by JacobianFreeOperator instead.
+ */
+class LaggedPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a wrapper over a preconditioner
+   * @param[in] preconditioner The preconditioner to wrap
+   */
+  LaggedPreconditioner(mfem::Solver& preconditioner) : preconditioner_(preconditioner) {}
+
+  /**
+   * @brief Ignores the operator of the Krylov solver
+   * @param[in] op The operator of the Krylov solver
+   */
+  void SetOperator(const mfem::Operator& op) override
+  {
+    height = op.Height();
+    width  = op.Width();
+  }
+
+  /**
+   * @brief Sets up the underlying preconditioner with an assembled Jacobian
+   * @param[in] jacobian The assembled Jacobian
+   */
+  void update(const mfem::Operator& jacobian) { preconditioner_.SetOperator(jacobian); }
+
+  /**
+   * @brief Applies the underlying preconditioner
+   * @param[in] b The input vector
+   * @param[out] x The output vector
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override { preconditioner_.Mult(b, x); }
+
+private:
+  /**
+   * @brief The underlying preconditioner
+   */
+  mfem::Solver& preconditioner_;
+};
+
+/**
+ * @brief A residual whose gradient is a FiniteDifferenceJacobian, for Jacobian-free Newton-Krylov solves
+ *
+ * Newton solvers evaluate the residual at a point and then ask for its gradient there, so the residual is kept from
+ * the evaluation and only one more residual evaluation is needed per Krylov iteration. The assembled Jacobian is only
+ * requested from the residual every JacobianFreeOptions::preconditioner_lag Newton iterations, to update the
+ * preconditioner, and not at all without one.
+ *
+ * The relative tolerance of the Krylov solver is set at every Newton iteration by the second forcing term choice of
+ * Eisenstat and Walker, eta_k = gamma (|r_k| / |r_k-1|)^alpha with alpha = (1 + sqrt(5)) / 2 and gamma given by
+ * JacobianFreeOptions::gamma. It is safeguarded by gamma eta_k-1^alpha whenever that is above 0.1, so it cannot drop
+ * much faster than the residual, and bounded by JacobianFreeOptions::max_forcing_term. Early Newton iterations are
+ * solved loosely, and the tolerance tightens as the Newton iterations converge superlinearly.
+ */
+class JacobianFreeOperator : public mfem::Operator {
+public:
+  /**
+   * @brief Constructs a Jacobian-free view of a residual
+   * @param[in] comm The communicator of the vectors
+   * @param[in] residual The residual, which must outlive this operator
+   * @param[in] options The lag of the preconditioner and the bounds of the forcing terms
+   * @param[in] krylov_solver The Krylov solver of the Newton iterations, whose relative tolerance is set
+   * @param[in] preconditioner The preconditioner of the Krylov solver, if any
+   */
+  JacobianFreeOperator(MPI_Comm comm, const mfem::Operator& residual, const JacobianFreeOptions& options,
+                       mfem::IterativeSolver& krylov_solver, LaggedPreconditioner* preconditioner);
+
+  /**
+   * @brief Starts a nonlinear solve, resetting the forcing terms
+   * @param[in] rhs The right-hand side of the nonlinear solve, which is referenced during the solve
+   */
+  void beginSolve(const mfem::Vector& rhs);
+
+  /**
+   * @brief Sets the essential degrees of freedom to eliminate from the Jacobian
+   * @param[in] dofs The local true degrees of freedom, which are referenced, so that updates are seen
+   */
+  void setEssentialDofs(const mfem::Array<int>& dofs) { jacobian_.setEssentialDofs(dofs); }
+
+  /**
+   * @brief Evaluates the residual, keeping it for a gradient at the same point
+   * @param[in] x The point
+   * @param[out] r The residual
+   */
+  void Mult(const mfem::Vector& x, mfem::Vector& r) const override;
+
+  /**
+   * @brief Returns the finite-difference Jacobian at a point, updating the preconditioner and the forcing term
+   * @param[in] x The point
+   * @return A non-owning reference to the Jacobian
+   * @note This is a collective operation
+   */
+  mfem::Operator& GetGradient(const mfem::Vector& x) const override;
+
+private:
+  /**
+   * @brief The communicator of the vectors
+   */
+  MPI_Comm comm_;
+
+  /**
+   * @brief The residual
+   */
+  const mfem::Operator& residual_;
+
+  /**
+   * @brief The lag of the preconditioner and the bounds of the forcing terms
+   */
+  JacobianFreeOptions options_;
+
+  /**
+   * @brief The Krylov solver of the Newton iterations
+   */
+  mfem::IterativeSolver& krylov_solver_;
+
+  /**
+   * @brief The preconditioner of the Krylov solver, if any
+   */
+  LaggedPreconditioner* preconditioner_;
+
+  /**
+   * @brief The Jacobian returned as the gradient
+   */
+  mutable FiniteDifferenceJacobian jacobian_;
+
+  /**
+   * @brief The right-hand side of the current nonlinear solve
+   */
+  const mfem::Vector* rhs_ = nullptr;
+
+  /**
+   * @brief The point of the last residual evaluation
+   */
+  mutable mfem::Vector last_point_;
+
+  /**
+   * @brief The residual of the last evaluation
+   */
+  mutable mfem::Vector last_residual_;
+
+  /**
+   * @brief The number of gradients since the preconditioner was updated, which starts out expired
+   */
+  mutable int gradients_since_update_;
+
+  /**
+   * @brief The norm of the nonlinear residual at the previous gradient of the solve, or a negative value at the first
+   */
+  mutable double previous_norm_ = -1.0;
+
+  /**
+   * @brief The forcing term of the previous Newton iteration
+   */
+  mutable double forcing_term_;
+};
+
+}  // namespace serac::mfem_ext
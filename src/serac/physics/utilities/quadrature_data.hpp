@@ -0,0 +1,254 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file quadrature_data.hpp
+ *
+ * @brief Storage for the internal state variables of path-dependent materials at quadrature points
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace serac {
+
+/**
+ * @brief The internal state of a material at every quadrature point of a mesh
+ *
+ * @tparam T The state at a single quadrature point, a trivially copyable struct made up of doubles, e.g.
+ * @code{.cpp}
+ * struct State {
+ *   tensor<double, 3, 3> plastic_strain;
+ *   double               accumulated_plastic_strain;
+ * };
+ * @endcode
+ *
+ * The values are stored as a structure of arrays: component k of the state at point i is located at
+ * component(k)[i], so a material update that is batched over the quadrature points reads and writes contiguous
+ * memory. Quadrature point q of element e is point e * pointsPerElement() + q.
+ *
+ * Two copies of the state are kept. The committed state belongs to the last converged time step and is what a
+ * material update starts from, while the trial state holds the result of the most recent update. Accepting a step
+ * commits the trial state, and rejecting a step (e.g. a failed Newton solve) rolls the trial state back.
+ */
+template <typename T>
+class QuadratureData {
+  static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                "Quadrature point state must be trivially copyable and default constructible");
+  static_assert(sizeof(T) % sizeof(double) == 0 && alignof(T) == alignof(double),
+                "Quadrature point state must be made up of doubles");
+
+public:
+  /**
+   * @brief The number of doubles in the state at a single quadrature point
+   */
+  static constexpr int num_components = static_cast<int>(sizeof(T) / sizeof(double));
+
+  /**
+   * @brief Returns the number of doubles needed to store one copy of the state
+   * @param[in] num_elements The number of elements in the mesh
+   * @param[in] points_per_element The number of quadrature points in each element
+   */
+  static constexpr int storageSize(const int num_elements, const int points_per_element)
+  {
+    return num_elements * points_per_element * num_components;
+  }
+
+  /**
+   * @brief Creates quadrature data that owns both copies of the state
+   * @param[in] num_elements The number of elements in the mesh
+   * @param[in] points_per_element The number of quadrature points in each element
+   * @param[in] initial The initial state at every quadrature point
+   */
+  QuadratureData(const int num_elements, const int points_per_element, const T& initial = T{})
+      : num_elements_(num_elements),
+        points_per_element_(points_per_element),
+        owned_committed_(static_cast<std::size_t>(storageSize(num_elements, points_per_element))),
+        committed_(owned_committed_.data()),
+        values_(owned_committed_.size())
+  {
+    fill(initial);
+  }
+
+  /**
+   * @brief Creates quadrature data whose committed state is stored externally, e.g. in a Sidre view
+   * @param[in] num_elements The number of elements in the mesh
+   * @param[in] points_per_element The number of quadrature points in each element
+   * @param[in] committed The committed state, storageSize() values that must outlive this object
+   * @note The trial state starts out as a copy of the committed state
+   */
+  QuadratureData(const int num_elements, const int points_per_element, double* committed)
+      : num_elements_(num_elements),
+        points_per_element_(points_per_element),
+        committed_(committed),
+        values_(committed, committed + storageSize(num_elements, points_per_element))
+  {
+  }
+
+  /**
+   * @brief Copying would alias externally stored committed state, so it is disallowed
+   */
+  QuadratureData(const QuadratureData&) = delete;
+
+  /**
+   * @brief Moves the state, the committed values do not change address
+   */
+  QuadratureData(QuadratureData&&) = default;
+
+  /**
+   * @brief Copying would alias externally stored committed state, so it is disallowed
+   */
+  QuadratureData& operator=(const QuadratureData&) = delete;
+
+  /**
+   * @brief Moves the state, the committed values do not change address
+   */
+  QuadratureData& operator=(QuadratureData&&) = default;
+
+  /**
+   * @brief Returns the trial state at a quadrature point
+   * @param[in] element The element that contains the point
+   * @param[in] point The index of the point within the element
+   */
+  T operator()(const int element, const int point) const { return gather(values_.data(), index(element, point)); }
+
+  /**
+   * @brief Returns the committed state at a quadrature point
+   * @param[in] element The element that contains the point
+   * @param[in] point The index of the point within the element
+   */
+  T committed(const int element, const int point) const { return gather(committed_, index(element, point)); }
+
+  /**
+   * @brief Sets the trial state at a quadrature point
+   * @param[in] element The element that contains the point
+   * @param[in] point The index of the point within the element
+   * @param[in] state The new state at the point
+   */
+  void set(const int element, const int point, const T& state)
+  {
+    double packed[num_components];
+    std::memcpy(packed, &state, sizeof(T));
+    const int i = index(element, point);
+    for (int k = 0; k < num_components; k++) {
+      values_[static_cast<std::size_t>(k * size() + i)] = packed[k];
+    }
+  }
+
+  /**
+   * @brief Sets both the trial and the committed state at every quadrature point
+   * @param[in] state The new state at every point
+   */
+  void fill(const T& state)
+  {
+    double packed[num_components];
+    std::memcpy(packed, &state, sizeof(T));
+    for (int k = 0; k < num_components; k++) {
+      std::fill(component(k), component(k) + size(), packed[k]);
+    }
+    commit();
+  }
+
+  /**
+   * @brief Returns one component of the trial state at all quadrature points
+   * @param[in] k The index of the component, i.e. the offset of the double within T
+   */
+  double* component(const int k) { return values_.data() + k * size(); }
+
+  /// @overload
+  const double* component(const int k) const { return values_.data() + k * size(); }
+
+  /**
+   * @brief Returns one component of the committed state at all quadrature points
+   * @param[in] k The index of the component, i.e. the offset of the double within T
+   */
+  const double* committedComponent(const int k) const { return committed_ + k * size(); }
+
+  /**
+   * @brief Accepts the trial state, e.g. after a converged time step
+   */
+  void commit() { std::copy(values_.begin(), values_.end(), committed_); }
+
+  /**
+   * @brief Discards the trial state, e.g. after a rejected Newton iteration or time step
+   */
+  void rollback() { std::copy(committed_, committed_ + values_.size(), values_.begin()); }
+
+  /**
+   * @brief Returns the total number of quadrature points
+   */
+  int size() const { return num_elements_ * points_per_element_; }
+
+  /**
+   * @brief Returns the number of elements in the mesh
+   */
+  int numElements() const { return num_elements_; }
+
+  /**
+   * @brief Returns the number of quadrature points in each element
+   */
+  int pointsPerElement() const { return points_per_element_; }
+
+  /**
+   * @brief Returns the size of the trial and the committed state in bytes
+   */
+  std::size_t bytes() const { return 2 * values_.size() * sizeof(double); }
+
+private:
+  /**
+   * @brief Returns the index of a quadrature point within each component
+   * @param[in] element The element that contains the point
+   * @param[in] point The index of the point within the element
+   */
+  int index(const int element, const int point) const { return element * points_per_element_ + point; }
+
+  /**
+   * @brief Assembles the state at a quadrature point from its components
+   * @param[in] values The start of the structure of arrays
+   * @param[in] i The index of the point
+   */
+  T gather(const double* values, const int i) const
+  {
+    double packed[num_components];
+    for (int k = 0; k < num_components; k++) {
+      packed[k] = values[k * size() + i];
+    }
+    T state;
+    std::memcpy(&state, packed, sizeof(T));
+    return state;
+  }
+
+  /**
+   * @brief The number of elements in the mesh
+   */
+  int num_elements_;
+
+  /**
+   * @brief The number of quadrature points in each element
+   */
+  int points_per_element_;
+
+  /**
+   * @brief The committed state, when it is not stored externally
+   */
+  std::vector<double> owned_committed_;
+
+  /**
+   * @brief The committed state
+   */
+  double* committed_;
+
+  /**
+   * @brief The trial state
+   */
+  std::vector<double> values_;
+};
+
+}  // namespace serac
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <optional>
 #include <variant>
 
 #include "mfem.hpp"
@@ -265,6 +266,32 @@ struct DirectSolverOptions {
  */
 using LinearSolverOptions = std::variant<IterativeSolverOptions, CustomSolverOptions, DirectSolverOptions>;
 
+/**
+ * @brief Parameters for Jacobian-free Newton-Krylov solves, which apply the Jacobian by finite differences of the
+ * residual and only assemble it for the preconditioner
+ */
+struct JacobianFreeOptions {
+  /**
+   * @brief The number of Newton iterations an assembled Jacobian is used to precondition
+   */
+  int preconditioner_lag = 10;
+
+  /**
+   * @brief The relative tolerance of the linear solve of the first Newton iteration
+   */
+  double initial_forcing_term = 0.5;
+
+  /**
+   * @brief The largest relative tolerance of the linear solves
+   */
+  double max_forcing_term = 0.9;
+
+  /**
+   * @brief The factor gamma of the Eisenstat-Walker forcing terms, in (0, 1]
+   */
+  double gamma = 0.9;
+};
+
 /**
  * @brief Nonlinear solution scheme parameters
  */
@@ -293,6 +320,11 @@ struct NonlinearSolverOptions {
    * @brief Nonlinear solver selection
    */
   NonlinearSolver nonlin_solver = NonlinearSolver::MFEMNewton;
+
+  /**
+   * @brief Jacobian-free Newton-Krylov parameters, if the Jacobian should be applied matrix-free
+   */
+  std::optional<JacobianFreeOptions> jacobian_free;
 };
 
 }  // namespace serac
@@ -6,13 +6,133 @@
 
 #include "serac/physics/utilities/state_manager.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <set>
+
+#include "axom/core/utilities/Timer.hpp"
+#include "axom/sidre.hpp"
+#include "conduit_relay_io_hdf5.hpp"
+
+#include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 
 namespace serac {
 
+namespace {
+
+/**
+ * @brief The number of values per block when comparing checkpoints
+ */
+constexpr int CHECKPOINT_BLOCK_SIZE = 4096;
+
+/**
+ * @brief Returns the 64-bit FNV-1a hash of a block of values
+ * @param[in] values The first value in the block
+ * @param[in] size The number of values in the block
+ */
+std::uint64_t hashBlock(const double* values, const int size)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  for (int i = 0; i < size; i++) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &values[i], sizeof(bits));
+    hash = (hash ^ bits) * 1099511628211ull;
+  }
+  return hash;
+}
+
+/**
+ * @brief Returns the name of the root file of a full checkpoint
+ * @param[in] collection_name The name of the datacollection
+ * @param[in] cycle The cycle of the checkpoint
+ */
+std::string fullCheckpointPath(const std::string& collection_name, const int cycle)
+{
+  return fmt::format("{0}_{1:0>6}", collection_name, cycle);
+}
+
+/**
+ * @brief Returns the name of the root file of an incremental checkpoint
+ * @param[in] collection_name The name of the datacollection
+ * @param[in] cycle The cycle of the checkpoint
+ */
+std::string incrementPath(const std::string& collection_name, const int cycle)
+{
+  return fmt::format("{0}_increment_{1:0>6}", collection_name, cycle);
+}
+
+/**
+ * @brief Returns the name of the datastore group that holds the committed quadrature data
+ * @param[in] collection_name The name of the datacollection
+ */
+std::string quadratureDataGroupName(const std::string& collection_name)
+{
+  return collection_name + "_quadrature_data";
+}
+
+/**
+ * @brief Reads the increments needed to reconstruct a cycle, most recent first
+ * @param[in] collection_name The name of the datacollection
+ * @param[in] cycle The cycle to reconstruct
+ * @param[out] base_cycle The cycle of the full checkpoint that the increments apply to
+ * @note Each increment must refer to an earlier cycle, so that the chain ends at a full checkpoint
+ */
+std::vector<std::unique_ptr<axom::sidre::DataStore>> readIncrements(const std::string& collection_name,
+                                                                    const int cycle, int& base_cycle)
+{
+  std::vector<std::unique_ptr<axom::sidre::DataStore>> increments;
+  std::set<int>                                        visited;
+  base_cycle = cycle;
+  while (!std::ifstream(fullCheckpointPath(collection_name, base_cycle) + ".root")) {
+    const std::string root_file = incrementPath(collection_name, base_cycle) + ".root";
+    SLIC_ERROR_ROOT_IF(!std::ifstream(root_file), fmt::format("No restart files found for cycle {0}", base_cycle));
+    SLIC_ERROR_ROOT_IF(!visited.insert(base_cycle).second,
+                       fmt::format("The increments of cycle {0} refer to cycle {1} more than once", cycle, base_cycle));
+
+    auto                   increment = std::make_unique<axom::sidre::DataStore>();
+    axom::sidre::IOManager reader(MPI_COMM_WORLD);
+    reader.read(increment->getRoot(), root_file);
+    const int previous_cycle = increment->getRoot()->getView("previous_cycle")->getScalar();
+    SLIC_ERROR_ROOT_IF(previous_cycle >= base_cycle,
+                       fmt::format("The increment of cycle {0} refers to cycle {1}, which is not earlier", base_cycle,
+                                   previous_cycle));
+    base_cycle = previous_cycle;
+    increments.push_back(std::move(increment));
+  }
+  return increments;
+}
+
+/**
+ * @brief Returns the number of bytes of data in a group and its subgroups
+ * @param[in] group The group to measure
+ */
+long long totalBytes(const axom::sidre::Group& group)
+{
+  long long bytes = 0;
+  for (auto i = group.getFirstValidViewIndex(); axom::sidre::indexIsValid(i); i = group.getNextValidViewIndex(i)) {
+    bytes += group.getView(i)->getTotalBytes();
+  }
+  for (auto i = group.getFirstValidGroupIndex(); axom::sidre::indexIsValid(i); i = group.getNextValidGroupIndex(i)) {
+    bytes += totalBytes(*group.getGroup(i));
+  }
+  return bytes;
+}
+
+}  // namespace
+
 // Initialize StateManager's static members - both of these will be fully initialized in StateManager::initialize
 std::optional<axom::sidre::MFEMSidreDataCollection> StateManager::datacoll_;
+axom::sidre::DataStore*                             StateManager::datastore_       = nullptr;
+StateManager::RestartOptions                        StateManager::restart_options_ = {};
+StateManager::CheckpointHistory                     StateManager::checkpoints_     = {};
+std::unordered_map<std::string, mfem::Vector>       StateManager::quadrature_vectors_;
 bool                                                StateManager::is_restart_      = false;
+int                                                 StateManager::loaded_cycle_    = 0;
+double                                              StateManager::loaded_time_     = 0.0;
 std::string                                         StateManager::collection_name_ = "";
 
 void StateManager::initialize(axom::sidre::DataStore& ds, const std::string& collection_name_prefix,
@@ -23,6 +143,7 @@ void StateManager::initialize(axom::sidre::DataStore& ds, const std::string& col
     reset();
   }
 
+  datastore_       = &ds;
   collection_name_ = collection_name_prefix + "_datacoll";
 
   auto global_grp   = ds.getRoot()->createGroup(collection_name_ + "_global");
@@ -34,9 +155,15 @@ void StateManager::initialize(axom::sidre::DataStore& ds, const std::string& col
   datacoll_.emplace(collection_name_, bp_index_grp, domain_grp, owns_mesh_data);
   datacoll_->SetComm(MPI_COMM_WORLD);
   if (cycle_to_load) {
+    SERAC_PROFILE_SCOPE("StateManager::load");
+    axom::utilities::Timer timer(true);
+
     is_restart_ = true;
     // NOTE: Load invalidates previous Sidre pointers
-    datacoll_->Load(*cycle_to_load);
+    // The number of files and the protocol are read from the root file, so any restart layout can be loaded
+    int  base_cycle = *cycle_to_load;
+    auto increments = readIncrements(collection_name_, *cycle_to_load, base_cycle);
+    datacoll_->Load(base_cycle);
     datacoll_->SetGroupPointers(
         ds.getRoot()->getGroup(collection_name_ + "_global/blueprint_index/" + collection_name_),
         ds.getRoot()->getGroup(collection_name_));
@@ -46,6 +173,45 @@ void StateManager::initialize(axom::sidre::DataStore& ds, const std::string& col
 
     datacoll_->UpdateStateFromDS();
     datacoll_->UpdateMeshAndFieldsFromDS();
+
+    // Replay the changed blocks of each increment, oldest first
+    if (!increments.empty()) {
+      auto data = checkpointedData();
+      for (auto increment = increments.rbegin(); increment != increments.rend(); ++increment) {
+        auto fields_grp = (*increment)->getRoot()->getGroup("fields");
+        for (auto& [name, values] : data) {
+          if (!fields_grp->hasGroup(name) || !fields_grp->getGroup(name)->hasView("blocks")) {
+            continue;
+          }
+          auto          field_grp  = fields_grp->getGroup(name);
+          auto          blocks     = field_grp->getView("blocks");
+          const int*    block_ids  = blocks->getData();
+          const double* new_values = field_grp->getView("values")->getData();
+          for (axom::sidre::IndexType i = 0; i < blocks->getNumElements(); i++) {
+            const int begin = block_ids[i] * CHECKPOINT_BLOCK_SIZE;
+            const int size  = std::min(CHECKPOINT_BLOCK_SIZE, values->Size() - begin);
+            std::copy(new_values, new_values + size, values->GetData() + begin);
+            new_values += size;
+          }
+        }
+      }
+
+      auto latest = increments.front()->getRoot();
+      datacoll_->SetCycle(latest->getView("cycle")->getScalar());
+      datacoll_->SetTime(latest->getView("time")->getScalar());
+
+      // Continue the chain of increments
+      recordCheckpoint(base_cycle, true);
+      checkpoints_.num_increments = static_cast<int>(increments.size());
+      checkpoints_.previous_cycle = *cycle_to_load;
+    }
+
+    // The physics modules continue from the loaded cycle, so that their next checkpoints extend the chain
+    loaded_cycle_ = datacoll_->GetCycle();
+    loaded_time_  = datacoll_->GetTime();
+
+    timer.stop();
+    SLIC_INFO_ROOT(fmt::format("Loaded restart files for cycle {0} in {1:.3f} s", *cycle_to_load, timer.elapsed()));
   } else {
     datacoll_->SetCycle(0);   // Iteration counter
     datacoll_->SetTime(0.0);  // Simulation time
@@ -71,12 +237,226 @@ FiniteElementState StateManager::newState(FiniteElementState::Options&& options)
   }
 }
 
+double* StateManager::quadratureDataStorage(const std::string& name, const int size, bool& loaded)
+{
+  SLIC_ERROR_ROOT_IF(!datacoll_, "Serac's datacollection was not initialized - call StateManager::initialize first");
+  auto root = datastore_->getRoot();
+  if (!root->hasGroup(quadratureDataGroupName(collection_name_))) {
+    root->createGroup(quadratureDataGroupName(collection_name_));
+  }
+  auto group = root->getGroup(quadratureDataGroupName(collection_name_));
+
+  loaded = group->hasView(name);
+  if (!loaded) {
+    return group->createViewAndAllocate(name, axom::sidre::DOUBLE_ID, size)->getData();
+  }
+
+  SLIC_ERROR_ROOT_IF(!is_restart_,
+                     fmt::format("Serac's datastore was already given quadrature data named '{0}'", name));
+  auto view = group->getView(name);
+  SLIC_ERROR_ROOT_IF(view->getNumElements() != size,
+                     fmt::format("Quadrature data '{0}' has {1} values in the restart files, expected {2}", name,
+                                 view->getNumElements(), size));
+  return view->getData();
+}
+
+void StateManager::deleteQuadratureData(const std::string& name)
+{
+  SLIC_ERROR_ROOT_IF(!datacoll_, "Serac's datacollection was not initialized - call StateManager::initialize first");
+  auto root = datastore_->getRoot();
+  if (root->hasGroup(quadratureDataGroupName(collection_name_))) {
+    auto group = root->getGroup(quadratureDataGroupName(collection_name_));
+    if (group->hasView(name)) {
+      group->destroyViewAndData(name);
+    }
+  }
+}
+
 void StateManager::save(const double t, const int cycle)
 {
+  SERAC_MARK_FUNCTION;
   SLIC_ERROR_ROOT_IF(!datacoll_, "Serac's datacollection was not initialized - call StateManager::initialize first");
+  axom::utilities::Timer timer(true);
+
   datacoll_->SetTime(t);
   datacoll_->SetCycle(cycle);
-  datacoll_->Save();
+
+  // Increments only extend the chain forward, a cycle that is saved again starts a new chain from a full checkpoint
+  const bool increment_due =
+      restart_options_.incremental && checkpoints_.base_cycle && cycle > checkpoints_.previous_cycle &&
+      (restart_options_.full_checkpoint_interval == 0 ||
+       checkpoints_.num_increments < restart_options_.full_checkpoint_interval);
+  SLIC_WARNING_ROOT_IF(restart_options_.incremental && checkpoints_.base_cycle && cycle < checkpoints_.previous_cycle,
+                       fmt::format("Cycle {0} is saved after cycle {1}, the increments written after cycle {0} no "
+                                   "longer apply to it",
+                                   cycle, checkpoints_.previous_cycle));
+
+  if (increment_due) {
+    saveIncrement(t, cycle);
+  } else if (restart_options_.num_files == 0 && restart_options_.protocol == "sidre_hdf5") {
+    datacoll_->Save();
+  } else {
+    // Mirrors MFEMSidreDataCollection::Save, which always writes one file per rank
+    datacoll_->UpdateStateToDS();
+    auto [num_ranks, rank] = getMPIInfo();
+    const int num_files =
+        (restart_options_.num_files > 0) ? std::min(restart_options_.num_files, num_ranks) : num_ranks;
+    const std::string file_path = fullCheckpointPath(collection_name_, cycle);
+
+    axom::sidre::IOManager writer(MPI_COMM_WORLD);
+    writer.write(datastore_->getRoot(), num_files, file_path, restart_options_.protocol);
+
+    // Add the blueprint index to the root file so the restart files can be visualized
+    if (rank == 0 && restart_options_.protocol == "sidre_hdf5") {
+      writer.writeGroupToRootFile(datastore_->getRoot()->getGroup(collection_name_ + "_global/blueprint_index"),
+                                  file_path + ".root");
+    }
+  }
+
+  if (!increment_due) {
+    profiling::counter("Restart bytes written") += totalBytes(*datastore_->getRoot());
+  }
+  if (restart_options_.incremental && !increment_due) {
+    recordCheckpoint(cycle, true);
+  }
+
+  timer.stop();
+  SLIC_INFO_ROOT(fmt::format("Wrote restart files for cycle {0} in {1:.3f} s", cycle, timer.elapsed()));
+}
+
+std::vector<std::pair<std::string, mfem::Vector*>> StateManager::checkpointedData()
+{
+  std::vector<std::pair<std::string, mfem::Vector*>> data;
+  for (auto& [name, field] : datacoll_->GetFieldMap()) {
+    data.emplace_back(name, field);
+  }
+  // The connectivity is static but the nodes of a deforming mesh are not
+  if (auto nodes = mesh().GetNodes()) {
+    data.emplace_back("mesh_nodes", nodes);
+  }
+  // The quadrature data is stored next to the datacollection, and is present after a restart has been loaded
+  auto root = datastore_->getRoot();
+  if (root->hasGroup(quadratureDataGroupName(collection_name_))) {
+    auto group = root->getGroup(quadratureDataGroupName(collection_name_));
+    for (auto i = group->getFirstValidViewIndex(); axom::sidre::indexIsValid(i); i = group->getNextValidViewIndex(i)) {
+      auto  view   = group->getView(i);
+      auto& vector = quadrature_vectors_[view->getName()];
+      vector.SetDataAndSize(view->getData(), static_cast<int>(view->getNumElements()));
+      data.emplace_back("quadrature_" + view->getName(), &vector);
+    }
+  }
+  return data;
+}
+
+void StateManager::saveIncrement(const double t, const int cycle)
+{
+  SLIC_ERROR_ROOT_IF(cycle <= checkpoints_.previous_cycle,
+                     fmt::format("Cannot write an increment for cycle {0}, which is not after the previous checkpoint "
+                                 "at cycle {1}",
+                                 cycle, checkpoints_.previous_cycle));
+  axom::sidre::DataStore increment;
+  auto                   root = increment.getRoot();
+  root->createViewScalar("cycle", cycle);
+  root->createViewScalar("time", t);
+  root->createViewScalar("base_cycle", *checkpoints_.base_cycle);
+  root->createViewScalar("previous_cycle", checkpoints_.previous_cycle);
+
+  auto fields_grp = root->createGroup("fields");
+  for (auto& [name, values] : checkpointedData()) {
+    auto&     hashes     = checkpoints_.block_hashes[name];
+    const int num_blocks = (values->Size() + CHECKPOINT_BLOCK_SIZE - 1) / CHECKPOINT_BLOCK_SIZE;
+    hashes.resize(static_cast<std::size_t>(num_blocks));
+
+    std::vector<int> changed;
+    int              num_changed_values = 0;
+    for (int block = 0; block < num_blocks; block++) {
+      const int  begin = block * CHECKPOINT_BLOCK_SIZE;
+      const int  size  = std::min(CHECKPOINT_BLOCK_SIZE, values->Size() - begin);
+      const auto hash  = hashBlock(values->GetData() + begin, size);
+      if (hash != hashes[static_cast<std::size_t>(block)]) {
+        hashes[static_cast<std::size_t>(block)] = hash;
+        changed.push_back(block);
+        num_changed_values += size;
+      }
+    }
+
+    if (changed.empty()) {
+      continue;
+    }
+
+    auto field_grp = fields_grp->createGroup(name);
+    auto blocks    = field_grp->createViewAndAllocate("blocks", axom::sidre::INT_ID,
+                                                    static_cast<axom::sidre::IndexType>(changed.size()));
+    std::copy(changed.begin(), changed.end(), static_cast<int*>(blocks->getData()));
+
+    double* changed_values =
+        field_grp->createViewAndAllocate("values", axom::sidre::DOUBLE_ID, num_changed_values)->getData();
+    for (const int block : changed) {
+      const int begin = block * CHECKPOINT_BLOCK_SIZE;
+      const int size  = std::min(CHECKPOINT_BLOCK_SIZE, values->Size() - begin);
+      changed_values  = std::copy(values->GetData() + begin, values->GetData() + begin + size, changed_values);
+    }
+  }
+
+  auto [num_ranks, _] = getMPIInfo();
+  const int num_files =
+      (restart_options_.num_files > 0) ? std::min(restart_options_.num_files, num_ranks) : num_ranks;
+  axom::sidre::IOManager writer(MPI_COMM_WORLD);
+  writer.write(root, num_files, incrementPath(collection_name_, cycle), restart_options_.protocol);
+  profiling::counter("Restart bytes written") += totalBytes(*root);
+
+  recordCheckpoint(cycle, false);
+}
+
+void StateManager::recordCheckpoint(const int cycle, const bool full)
+{
+  checkpoints_.previous_cycle = cycle;
+  if (!full) {
+    // The hashes were updated as the increment was written
+    checkpoints_.num_increments++;
+    return;
+  }
+
+  checkpoints_.base_cycle     = cycle;
+  checkpoints_.num_increments = 0;
+  checkpoints_.block_hashes.clear();
+  for (auto& [name, values] : checkpointedData()) {
+    auto& hashes = checkpoints_.block_hashes[name];
+    for (int begin = 0; begin < values->Size(); begin += CHECKPOINT_BLOCK_SIZE) {
+      hashes.push_back(hashBlock(values->GetData() + begin, std::min(CHECKPOINT_BLOCK_SIZE, values->Size() - begin)));
+    }
+  }
+}
+
+void StateManager::setRestartOptions(const RestartOptions& options)
+{
+  SLIC_ERROR_ROOT_IF(options.num_files < 0, "The number of restart files must be non-negative");
+  SLIC_ERROR_ROOT_IF(options.full_checkpoint_interval < 0, "The full checkpoint interval must be non-negative");
+  SLIC_WARNING_ROOT_IF(options.compress && options.protocol != "sidre_hdf5",
+                       "Restart file compression is only supported by the sidre_hdf5 protocol");
+  restart_options_ = options;
+
+  // Conduit's HDF5 options are global, large arrays are stored in compressed chunks
+  conduit::Node hdf5_options;
+  hdf5_options["chunking/enabled"] = options.compress ? "true" : "false";
+  if (options.compress) {
+    hdf5_options["chunking/compression/method"] = "gzip";
+    hdf5_options["chunking/compression/level"]  = 5;
+  }
+  conduit::relay::io::hdf5_set_options(hdf5_options);
+}
+
+void StateManager::RestartOptions::defineInputFileSchema(axom::inlet::Container& container)
+{
+  container.addInt("num_files", "Number of files per restart dump, 0 for one file per rank").defaultValue(0);
+  container.addString("protocol", "Sidre I/O protocol of the restart files")
+      .validValues({"sidre_hdf5", "sidre_conduit_json", "sidre_json"})
+      .defaultValue("sidre_hdf5");
+  container.addBool("compress", "Compress large arrays with gzip (sidre_hdf5 only)").defaultValue(false);
+  container.addBool("incremental", "Only write the changed blocks of field data after the first checkpoint")
+      .defaultValue(false);
+  container.addInt("full_checkpoint_interval", "Number of incremental checkpoints between full checkpoints")
+      .defaultValue(10);
 }
 
 void StateManager::setMesh(std::unique_ptr<mfem::ParMesh> mesh)
@@ -93,3 +473,16 @@ mfem::ParMesh& StateManager::mesh()
 }
 
 }  // namespace serac
+
+serac::StateManager::RestartOptions FromInlet<serac::StateManager::RestartOptions>::operator()(
+    const axom::inlet::Container& base)
+{
+  serac::StateManager::RestartOptions result;
+  result.num_files = base["num_files"];
+  result.protocol  = base["protocol"].get<std::string>();
+  result.compress  = base["compress"];
+
+  result.incremental              = base["incremental"];
+  result.full_checkpoint_interval = base["full_checkpoint_interval"];
+  return result;
+}
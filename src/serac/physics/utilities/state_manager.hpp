@@ -12,12 +12,19 @@
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "mfem.hpp"
+#include "axom/inlet.hpp"
 #include "axom/sidre/core/MFEMSidreDataCollection.hpp"
 
 #include "finite_element_state.hpp"
+#include "quadrature_data.hpp"
 
 namespace serac {
 
@@ -27,6 +34,49 @@ namespace serac {
  */
 class StateManager {
 public:
+  /**
+   * @brief The layout of the restart files written by StateManager::save
+   */
+  struct RestartOptions {
+    /**
+     * @brief The number of files per restart dump, or zero for one file per rank
+     *
+     * Each file is written by a group of ranks (N-to-M). Restart files can be read with any number of files.
+     */
+    int num_files = 0;
+
+    /**
+     * @brief The Sidre I/O protocol, e.g. sidre_hdf5 or sidre_conduit_json
+     */
+    std::string protocol = "sidre_hdf5";
+
+    /**
+     * @brief Whether large arrays are gzip-compressed (lossless, sidre_hdf5 only)
+     */
+    bool compress = false;
+
+    /**
+     * @brief Whether checkpoints after the first only store the blocks of field data that changed
+     *
+     * The mesh connectivity and the other static data are only written by full checkpoints
+     */
+    bool incremental = false;
+
+    /**
+     * @brief The number of incremental checkpoints between full checkpoints, or zero to only write the first one
+     *
+     * Loading a cycle reads its full checkpoint and every increment since, so this bounds the cost of a restart
+     */
+    int full_checkpoint_interval = 10;
+
+    /**
+     * @brief Input file parameters specific to this class
+     *
+     * @param[in] container Inlet container on which the input schema will be defined
+     **/
+    static void defineInputFileSchema(axom::inlet::Container& container);
+  };
+
   /**
    * @brief Initializes the StateManager with a sidre DataStore (into which state will be written/read)
    * @param[in] ds The DataStore to use
@@ -44,20 +94,63 @@ public:
    */
   static FiniteElementState newState(FiniteElementState::Options&& options = {});
 
+  /**
+   * @brief Factory method for creating new quadrature point state that is written to restart files
+   * @tparam T The state at a single quadrature point
+   * @param[in] name The name of the state, unique among the quadrature data of the datastore
+   * @param[in] points_per_element The number of quadrature points in each element of the mesh
+   * @param[in] initial The initial state at every quadrature point, ignored when restarting
+   * @note When restarting, the state is initialized with the committed state of the restart files
+   */
+  template <typename T>
+  static QuadratureData<T> newQuadratureData(const std::string& name, const int points_per_element,
+                                             const T& initial = T{})
+  {
+    const int num_elements = mesh().GetNE();
+    const int size         = QuadratureData<T>::storageSize(num_elements, points_per_element);
+    bool      loaded       = false;
+
+    QuadratureData<T> data(num_elements, points_per_element, quadratureDataStorage(name, size, loaded));
+    if (!loaded) {
+      data.fill(initial);
+    }
+    return data;
+  }
+
+  /**
+   * @brief Removes quadrature point state from the datastore, so that it is no longer written to restart files
+   * @param[in] name The name given to newQuadratureData
+   * @note Any QuadratureData created with the name no longer has valid storage
+   */
+  static void deleteQuadratureData(const std::string& name);
+
   /**
    * @brief Updates the Conduit Blueprint state in the datastore and saves to a file
    * @param[in] t The current sim time
    * @param[in] cycle The current iteration number of the simulation
+   * @note An incremental checkpoint is only written for a cycle after the previous checkpoint, a cycle that is saved
+   * again or out of order is written as a full checkpoint
    */
   static void save(const double t, const int cycle);
 
+  /**
+   * @brief Sets the layout of the restart files written by subsequent calls to save
+   * @param[in] options The number of files, protocol, and compression of the restart files
+   */
+  static void setRestartOptions(const RestartOptions& options);
+
   /**
    * @brief Resets the underlying global datacollection object
    */
   static void reset()
   {
     datacoll_.reset();
-    is_restart_ = false;
+    datastore_    = nullptr;
+    is_restart_   = false;
+    loaded_cycle_ = 0;
+    loaded_time_  = 0.0;
+    checkpoints_  = {};
+    quadrature_vectors_.clear();
   };
 
   /**
@@ -75,7 +168,67 @@ public:
    */
   static const std::string collectionName() { return collection_name_; }
 
+  /**
+   * @brief Returns the cycle of the loaded restart files, or zero if this is not a restart
+   */
+  static int loadedCycle() { return loaded_cycle_; }
+
+  /**
+   * @brief Returns the simulation time of the loaded restart files, or zero if this is not a restart
+   */
+  static double loadedTime() { return loaded_time_; }
+
 private:
+  /**
+   * @brief The incremental checkpoints written (or loaded) since the last full checkpoint
+   */
+  struct CheckpointHistory {
+    /**
+     * @brief The cycle of the full checkpoint that the increments are relative to
+     */
+    std::optional<int> base_cycle;
+    /**
+     * @brief The cycle of the most recent checkpoint
+     */
+    int previous_cycle = 0;
+    /**
+     * @brief The number of increments since the full checkpoint
+     */
+    int num_increments = 0;
+    /**
+     * @brief The hash of each block of each field at the most recent checkpoint
+     */
+    std::unordered_map<std::string, std::vector<std::uint64_t>> block_hashes;
+  };
+
+  /**
+   * @brief Returns the storage of the committed values of quadrature data
+   * @param[in] name The name of the quadrature data
+   * @param[in] size The number of values
+   * @param[out] loaded Whether the values were read from the restart files
+   */
+  static double* quadratureDataStorage(const std::string& name, const int size, bool& loaded);
+
+  /**
+   * @brief Returns the data that changes between checkpoints, i.e., the fields, the mesh nodes, and the quadrature
+   * data
+   */
+  static std::vector<std::pair<std::string, mfem::Vector*>> checkpointedData();
+
+  /**
+   * @brief Writes the blocks of the checkpointed data that changed since the previous checkpoint
+   * @param[in] t The current sim time
+   * @param[in] cycle The current iteration number of the simulation
+   */
+  static void saveIncrement(const double t, const int cycle);
+
+  /**
+   * @brief Records the checkpointed data so that the next increment can be computed
+   * @param[in] cycle The cycle of the checkpoint that was just written or loaded
+   * @param[in] full Whether the checkpoint was a full checkpoint
+   */
+  static void recordCheckpoint(const int cycle, const bool full);
+
   /**
    * @brief The datacollection instance
    *
@@ -83,10 +236,34 @@ private:
    * The object is constructed when the user calls StateManager::initialize.
    */
   static std::optional<axom::sidre::MFEMSidreDataCollection> datacoll_;
+  /**
+   * @brief The datastore that holds the datacollection, used to write restart files with a custom layout
+   */
+  static axom::sidre::DataStore* datastore_;
+  /**
+   * @brief The layout of the restart files
+   */
+  static RestartOptions restart_options_;
+  /**
+   * @brief The checkpoints written since the last full checkpoint
+   */
+  static CheckpointHistory checkpoints_;
+  /**
+   * @brief Views of the committed quadrature data as vectors, used to compute incremental checkpoints
+   */
+  static std::unordered_map<std::string, mfem::Vector> quadrature_vectors_;
   /**
    * @brief Whether this simulation has been restarted from another simulation
    */
   static bool is_restart_;
+  /**
+   * @brief The cycle of the loaded restart files
+   */
+  static int loaded_cycle_;
+  /**
+   * @brief The simulation time of the loaded restart files
+   */
+  static double loaded_time_;
   /**
    * @brief Name of the Sidre DataCollection
    */
@@ -94,3 +271,14 @@ private:
 };
 
 }  // namespace serac
+
+/**
+ * @brief Prototype the specialization for Inlet parsing
+ *
+ * @tparam The object to be created by Inlet
+ */
+template <>
+struct FromInlet<serac::StateManager::RestartOptions> {
+  /// @brief Returns created object from Inlet container
+  serac::StateManager::RestartOptions operator()(const axom::inlet::Container& base);
+};
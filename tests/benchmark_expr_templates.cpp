@@ -203,6 +203,107 @@ static void BM_large_expr_single_alloc_hypre_par_EXPR(benchmark::State& state)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+static void BM_mixed_expr_handwritten(benchmark::State& state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Number of rows is the argument that varies
+  const int rows  = static_cast<int>(state.range(0));
+  auto [lhs, rhs] = sample_vectors(rows);
+
+  // Arbitrary
+  const int cols = rows / 2;
+
+  auto [matrix, vec_in] = sample_matvec(rows, cols);
+
+  mfem::Vector result(rows);
+  mfem::Vector matvec(rows);
+
+  for (auto _ : state) {
+    // This code gets timed
+    matrix.Mult(vec_in, matvec);
+    const double* l = lhs.HostRead();
+    const double* r = rhs.HostRead();
+    const double* m = matvec.HostRead();
+    double*       x = result.HostWrite();
+    for (int i = 0; i < rows; i++) {
+      x[i] = -l[i] + r[i] * 3.0 - 0.3 * m[i];
+    }
+    benchmark::DoNotOptimize(x);
+    benchmark::ClobberMemory();
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void BM_mixed_expr_policy(benchmark::State& state, const serac::ExecutionPolicy policy)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Number of rows is the argument that varies
+  const int rows  = static_cast<int>(state.range(0));
+  auto [lhs, rhs] = sample_vectors(rows);
+
+  // Arbitrary
+  const int cols = rows / 2;
+
+  auto [matrix, vec_in] = sample_matvec(rows, cols);
+
+  mfem::Vector expr_result(rows);
+
+  for (auto _ : state) {
+    // This code gets timed
+    evaluate(-lhs + rhs * 3.0 - 0.3 * (matrix * vec_in), expr_result, policy);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void BM_large_expr_handwritten(benchmark::State& state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Number of rows is the argument that varies
+  const int rows  = static_cast<int>(state.range(0));
+  auto [lhs, rhs] = sample_vectors(rows);
+
+  mfem::Vector result(rows);
+
+  for (auto _ : state) {
+    // This code gets timed
+    const double* l = lhs.HostRead();
+    const double* r = rhs.HostRead();
+    double*       x = result.HostWrite();
+    for (int i = 0; i < rows; i++) {
+      x[i] = l[i] + r[i] + l[i] + r[i] + l[i] + r[i] + l[i] + r[i] + l[i] + r[i] + l[i] + r[i] + l[i] + r[i];
+    }
+    benchmark::DoNotOptimize(x);
+    benchmark::ClobberMemory();
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void BM_large_expr_policy(benchmark::State& state, const serac::ExecutionPolicy policy)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Number of rows is the argument that varies
+  const int rows  = static_cast<int>(state.range(0));
+  auto [lhs, rhs] = sample_vectors(rows);
+
+  mfem::Vector expr_result(rows);
+
+  for (auto _ : state) {
+    // This code gets timed
+    evaluate(lhs + rhs + lhs + rhs + lhs + rhs + lhs + rhs + lhs + rhs + lhs + rhs + lhs + rhs, expr_result, policy);
+  }
+
+  state.SetBytesProcessed(state.iterations() * 3 * rows * static_cast<long>(sizeof(double)));
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 BENCHMARK(BM_mixed_expr_MFEM)->RangeMultiplier(2)->Range(10, 10 << 10);
 BENCHMARK(BM_mixed_expr_EXPR)->RangeMultiplier(2)->Range(10, 10 << 10);
 BENCHMARK(BM_mixed_expr_single_alloc_EXPR)->RangeMultiplier(2)->Range(10, 10 << 10);
@@ -212,6 +313,19 @@ BENCHMARK(BM_large_expr_single_alloc_EXPR)->RangeMultiplier(2)->Range(10, 10 <<
 // Too slow
 BENCHMARK(BM_large_expr_single_alloc_hypre_par_EXPR)->RangeMultiplier(2)->Range(10, 10 << 10);
 
+// The evaluation policies against the loops they should match, the large expression up to sizes where threading pays
+// off (the mixed expression is limited by its dense matrix)
+BENCHMARK(BM_mixed_expr_handwritten)->Range(10, 10 << 10);
+BENCHMARK_CAPTURE(BM_mixed_expr_policy, sequential, serac::ExecutionPolicy::Sequential)->Range(10, 10 << 10);
+BENCHMARK_CAPTURE(BM_mixed_expr_policy, simd, serac::ExecutionPolicy::Simd)->Range(10, 10 << 10);
+BENCHMARK_CAPTURE(BM_mixed_expr_policy, threaded, serac::ExecutionPolicy::Threaded)->Range(10, 10 << 10);
+BENCHMARK_CAPTURE(BM_mixed_expr_policy, device, serac::ExecutionPolicy::Device)->Range(10, 10 << 10);
+BENCHMARK(BM_large_expr_handwritten)->Range(10, 10 << 16);
+BENCHMARK_CAPTURE(BM_large_expr_policy, sequential, serac::ExecutionPolicy::Sequential)->Range(10, 10 << 16);
+BENCHMARK_CAPTURE(BM_large_expr_policy, simd, serac::ExecutionPolicy::Simd)->Range(10, 10 << 16);
+BENCHMARK_CAPTURE(BM_large_expr_policy, threaded, serac::ExecutionPolicy::Threaded)->Range(10, 10 << 16);
+BENCHMARK_CAPTURE(BM_large_expr_policy, device, serac::ExecutionPolicy::Device)->Range(10, 10 << 16);
+
 //------------------------------------------------------------------------------
 #include "axom/slic/core/SimpleLogger.hpp"
 
@@ -428,6 +428,102 @@ TEST(expr_templates, complex_expr_lambda)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(expr_templates, nested_operator_expr_reuses_scratch)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int rows = 10;
+  auto [a, v]        = sample_vectors(rows);
+
+  // Same shape as the residual of the dynamic solid mechanics solver
+  mfem::DenseMatrix M = sample_matvec(rows, rows).first;
+  mfem::DenseMatrix C = sample_matvec(rows, rows).first;
+  C *= 0.5;
+  const double c1 = 0.25;
+
+  mfem::Vector mfem_result(rows);
+  mfem::Vector Ma(rows);
+  mfem::Vector v_plus_c1a(rows);
+  M.Mult(a, Ma);
+  add(v, c1, a, v_plus_c1a);
+  C.Mult(v_plus_c1a, mfem_result);
+  mfem_result += Ma;
+
+  mfem::Vector expr_result(rows);
+  evaluate(M * a + C * (v + c1 * a), expr_result);
+  const int allocations = serac::detail::scratchPool().allocations();
+
+  // Every intermediate vector of the second evaluation comes from the pool
+  expr_result = 0.0;
+  evaluate(M * a + C * (v + c1 * a), expr_result);
+  EXPECT_EQ(serac::detail::scratchPool().allocations(), allocations);
+
+  for (int i = 0; i < rows; i++) {
+    EXPECT_DOUBLE_EQ(mfem_result[i], expr_result[i]);
+  }
+
+  // The operator results are complete before the output is written, so the output may be an operand
+  evaluate(M * a + C * (v + c1 * a), a);
+  for (int i = 0; i < rows; i++) {
+    EXPECT_DOUBLE_EQ(mfem_result[i], a[i]);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(expr_templates, named_operator_expr_copies)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int rows = 10;
+  auto [a, v]        = sample_vectors(rows);
+  auto M             = sample_matvec(rows, rows).first;
+
+  mfem::Vector mfem_result(rows);
+  M.Mult(a, mfem_result);
+  mfem_result += v;
+
+  // A named expression that holds an operator result can be copied, and the copy composed into another expression
+  auto Ma        = M * a;
+  auto Ma_plus_v = decltype(Ma)(Ma) + v;
+
+  // As can an expression that contains one
+  const auto   residual = Ma_plus_v;
+  mfem::Vector expr_result(rows);
+  evaluate(residual, expr_result);
+  mfem::Vector original_result(rows);
+  evaluate(Ma_plus_v, original_result);
+
+  // The original is left intact
+  mfem::Vector Ma_result = Ma;
+  for (int i = 0; i < rows; i++) {
+    EXPECT_DOUBLE_EQ(mfem_result[i], expr_result[i]);
+    EXPECT_DOUBLE_EQ(mfem_result[i], original_result[i]);
+    EXPECT_DOUBLE_EQ(mfem_result[i] - v[i], Ma_result[i]);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(expr_templates, execution_policies_agree)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  // Large enough for several blocks (and threads) with a partial block at the end
+  constexpr int rows = 3 * serac::detail::EXPR_THREADING_THRESHOLD + 17;
+  auto [lhs, rhs]    = sample_vectors(rows);
+
+  constexpr int cols    = 12;
+  auto [matrix, vec_in] = sample_matvec(rows, cols);
+
+  mfem::Vector sequential_result(rows);
+  evaluate(-lhs + rhs * 3.0 - 0.3 * (matrix * vec_in) / 2.0, sequential_result, serac::ExecutionPolicy::Sequential);
+
+  for (auto policy : {serac::ExecutionPolicy::Simd, serac::ExecutionPolicy::Threaded, serac::ExecutionPolicy::Device}) {
+    mfem::Vector expr_result(rows);
+    evaluate(-lhs + rhs * 3.0 - 0.3 * (matrix * vec_in) / 2.0, expr_result, policy);
+    for (int i = 0; i < rows; i++) {
+      EXPECT_DOUBLE_EQ(sequential_result[i], expr_result[i]);
+    }
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 //------------------------------------------------------------------------------
 #include "axom/slic/core/SimpleLogger.hpp"
 
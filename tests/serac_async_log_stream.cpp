@@ -0,0 +1,135 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "mpi.h"
+
+#include "serac/infrastructure/async_log_stream.hpp"
+
+namespace serac {
+
+TEST(serac_async_log_stream, ring_buffer_wraps_around)
+{
+  logger::detail::RingBuffer<std::string> ring(3);
+  EXPECT_EQ(ring.capacity(), 4u);
+
+  std::string value;
+  for (int i = 0; i < 10; i++) {
+    value = std::to_string(i);
+    EXPECT_TRUE(ring.tryPush(value));
+    value = std::to_string(i + 100);
+    EXPECT_TRUE(ring.tryPush(value));
+
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, std::to_string(i));
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, std::to_string(i + 100));
+  }
+  EXPECT_FALSE(ring.tryPop(value));
+  EXPECT_EQ(ring.pushed(), 20u);
+
+  for (int i = 0; i < 4; i++) {
+    value = "full";
+    EXPECT_TRUE(ring.tryPush(value));
+  }
+  value = "overflow";
+  EXPECT_FALSE(ring.tryPush(value));
+  EXPECT_EQ(value, "overflow");
+}
+
+TEST(serac_async_log_stream, messages_are_gathered_in_order)
+{
+  int rank      = 0;
+  int num_ranks = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  constexpr int      num_messages = 1000;
+  std::ostringstream console;
+  {
+    // A tiny queue and no forwarding interval exercise the waits and the forwarding on every message
+    logger::AsyncOptions options;
+    options.capacity = 4;
+    options.interval = std::chrono::milliseconds(0);
+
+    auto sink  = std::make_shared<logger::AsyncLogSink>(MPI_COMM_WORLD, options);
+    auto info  = std::make_unique<logger::AsyncLogStream>(sink, &console, "<RANK>:<MESSAGE>\n");
+    auto debug = std::make_unique<logger::AsyncLogStream>(sink, &console, "<RANK>:<LEVEL>:<MESSAGE>\n");
+    EXPECT_EQ(info->destination(), debug->destination());
+
+    for (int i = 0; i < num_messages; i++) {
+      auto& stream = (i % 2 == 0) ? info : debug;
+      auto  level  = (i % 2 == 0) ? axom::slic::message::Info : axom::slic::message::Debug;
+      stream->append(level, std::to_string(i), "", __FILE__, __LINE__, false);
+    }
+    info->flush();
+    debug->flush();
+  }
+
+  std::vector<int> next(static_cast<std::size_t>(num_ranks), 0);
+  std::istringstream lines(console.str());
+  std::string        line;
+  while (std::getline(lines, line)) {
+    const auto source = static_cast<std::size_t>(std::stoi(line.substr(0, line.find(':'))));
+    ASSERT_LT(source, next.size());
+    const int expected = next[source]++;
+    if (expected % 2 == 0) {
+      EXPECT_EQ(line, std::to_string(source) + ":" + std::to_string(expected));
+    } else {
+      EXPECT_EQ(line, std::to_string(source) + ":DEBUG:" + std::to_string(expected));
+    }
+  }
+
+  // Everything ends up on rank 0, and nothing is lost or duplicated
+  for (int source = 0; source < num_ranks; source++) {
+    EXPECT_EQ(next[static_cast<std::size_t>(source)], rank == 0 ? num_messages : 0);
+  }
+}
+
+TEST(serac_async_log_stream, errors_are_written_locally)
+{
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  std::ostringstream console;
+  {
+    auto sink   = std::make_shared<logger::AsyncLogSink>(MPI_COMM_WORLD);
+    auto stream = std::make_unique<logger::AsyncLogStream>(sink, &console, "<LEVEL>:<MESSAGE>\n");
+    stream->append(axom::slic::message::Warning, "before", "", __FILE__, __LINE__, false);
+    stream->append(axom::slic::message::Error, "failed on " + std::to_string(rank), "", __FILE__, __LINE__, false);
+
+    // The error was written without waiting on the other ranks
+    EXPECT_EQ(console.str(), "WARNING:before\nERROR:failed on " + std::to_string(rank) + "\n");
+  }
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
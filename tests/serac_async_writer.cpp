@@ -0,0 +1,103 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "mpi.h"
+
+#include "serac/infrastructure/async_writer.hpp"
+
+namespace serac {
+
+TEST(serac_async_writer, tasks_run_in_order)
+{
+  std::vector<int> order;
+  {
+    output::AsyncWriter writer(4);
+    for (int i = 0; i < 10; i++) {
+      writer.enqueue([&order, i]() { order.push_back(i); });
+    }
+    writer.flush();
+    EXPECT_EQ(writer.pending(), 0u);
+  }
+
+  ASSERT_EQ(order.size(), 10u);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(order[static_cast<std::size_t>(i)], i);
+  }
+}
+
+TEST(serac_async_writer, bounded_pending)
+{
+  std::atomic<int>  running{0};
+  std::atomic<int>  max_running{0};
+  std::atomic<bool> release{false};
+
+  output::AsyncWriter writer(1);
+  writer.enqueue([&]() {
+    running++;
+    max_running = std::max(max_running.load(), running.load());
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    running--;
+  });
+  EXPECT_EQ(writer.pending(), 1u);
+
+  // The second enqueue cannot return until the first task has completed
+  std::thread releaser([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release = true;
+  });
+  writer.enqueue([&]() { EXPECT_TRUE(release); });
+  writer.flush();
+  releaser.join();
+
+  EXPECT_EQ(max_running, 1);
+  EXPECT_EQ(writer.pending(), 0u);
+}
+
+TEST(serac_async_writer, failures_do_not_stop_the_writer)
+{
+  int completed = 0;
+  {
+    output::AsyncWriter writer;
+    writer.enqueue([]() { throw std::runtime_error("disk full"); });
+    writer.enqueue([&completed]() { completed++; });
+    // Flushing every live writer is what serac::exitGracefully does
+    output::flushAsyncWriters();
+  }
+  EXPECT_EQ(completed, 1);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -11,6 +11,8 @@
 #include <gtest/gtest.h>
 #include "mfem.hpp"
 
+#include "test_utilities.hpp"
+
 namespace serac {
 
 TEST(boundary_cond, simple_repeated_dofs)
@@ -40,6 +42,122 @@ TEST(boundary_cond, simple_repeated_dofs)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+/**
+ * @brief A diffusion form on a mesh whose whole boundary is essential, for comparing eliminations with MFEM's
+ */
+class EliminationTest : public ::testing::Test {
+protected:
+  EliminationTest() : par_mesh_(MPI_COMM_WORLD, mesh_), state_(par_mesh_), bcs_(par_mesh_), form_(&state_.space())
+  {
+    for (int i = 0; i < par_mesh_.GetNBE(); i++) {
+      par_mesh_.GetBdrElement(i)->SetAttribute(ATTR);
+    }
+    bcs_.addEssential({ATTR}, std::make_shared<mfem::ConstantCoefficient>(1), state_);
+
+    form_.AddDomainIntegrator(new mfem::DiffusionIntegrator(one_));
+    form_.Assemble(0);
+    form_.Finalize();
+  }
+
+  /**
+   * @brief The number of elements in each direction
+   */
+  static constexpr int N = 15;
+
+  /**
+   * @brief The attribute of every boundary element
+   */
+  static constexpr int ATTR = 1;
+
+  /**
+   * @brief The serial mesh
+   */
+  mfem::Mesh mesh_{N, N, mfem::Element::TRIANGLE};
+
+  /**
+   * @brief The distributed mesh
+   */
+  mfem::ParMesh par_mesh_;
+
+  /**
+   * @brief The state whose space the form is defined on
+   */
+  FiniteElementState state_;
+
+  /**
+   * @brief The essential boundary conditions on the whole boundary
+   */
+  BoundaryConditionManager bcs_;
+
+  /**
+   * @brief The diffusivity
+   */
+  mfem::ConstantCoefficient one_{1.0};
+
+  /**
+   * @brief The assembled diffusion form
+   */
+  mfem::ParBilinearForm form_;
+};
+
+TEST_F(EliminationTest, matches_mfem)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  mfem::HypreParVector x(&state_.space());
+  mfem::HypreParVector b(&state_.space());
+  x.Randomize(1);
+  b.Randomize(2);
+
+  std::unique_ptr<mfem::HypreParMatrix> expected(form_.ParallelAssemble());
+  std::unique_ptr<mfem::HypreParMatrix> eliminated(expected->EliminateRowsCols(bcs_.allEssentialDofs()));
+  mfem::Vector                          expected_rhs(b);
+  mfem::EliminateBC(*expected, *eliminated, bcs_.allEssentialDofs(), x, expected_rhs);
+
+  // The second matrix is eliminated with the plan of the first one
+  std::unique_ptr<mfem::HypreParMatrix> actual;
+  for (int i = 0; i < 2; i++) {
+    actual.reset(form_.ParallelAssemble());
+    bcs_.eliminateAllEssentialDofsFromMatrix(*actual);
+  }
+  mfem::Vector actual_rhs(b);
+  bcs_.eliminateAllEssentialDofsFromRHS(x, actual_rhs);
+
+  mfem::Vector expected_product(x.Size());
+  mfem::Vector actual_product(x.Size());
+  expected->Mult(b, expected_product);
+  actual->Mult(b, actual_product);
+  actual_product -= expected_product;
+  EXPECT_NEAR(actual_product.Normlinf(), 0.0, 1e-12);
+
+  actual_rhs -= expected_rhs;
+  EXPECT_NEAR(actual_rhs.Normlinf(), 0.0, 1e-12);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST_F(EliminationTest, same_counts_different_columns)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  std::unique_ptr<mfem::HypreParMatrix> original(form_.ParallelAssemble());
+  bcs_.eliminateAllEssentialDofsFromMatrix(*original);
+
+  // Reversing the local numbering of the degrees of freedom keeps the nonzero counts of every block, but moves them
+  std::unique_ptr<mfem::HypreParMatrix> assembled(form_.ParallelAssemble());
+  auto                                  expected = test_utils::reverseNumbering(*assembled, state_.space());
+  auto                                  actual   = test_utils::reverseNumbering(*assembled, state_.space());
+  delete expected->EliminateRowsCols(bcs_.allEssentialDofs());
+  bcs_.eliminateAllEssentialDofsFromMatrix(*actual);
+
+  mfem::HypreParVector b(&state_.space());
+  b.Randomize(2);
+  mfem::Vector expected_product(b.Size());
+  mfem::Vector actual_product(b.Size());
+  expected->Mult(b, expected_product);
+  actual->Mult(b, actual_product);
+  actual_product -= expected_product;
+  EXPECT_NEAR(actual_product.Normlinf(), 0.0, 1e-12);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 enum TestTag
 {
   Tag1 = 0,
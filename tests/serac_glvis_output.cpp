@@ -0,0 +1,80 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/glvis_output.hpp"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+#include "fmt/fmt.hpp"
+#include "mfem.hpp"
+
+namespace serac {
+
+void aggregateAndCheck(const int num_writers, const bool compress)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  mfem::Mesh    serial_mesh(4, 4, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+
+  mfem::H1_FECollection       fec(2, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+  mfem::ParGridFunction       temperature(&space);
+  mfem::FunctionCoefficient   exact([](const mfem::Vector& x) { return x(0) * x(0) + x(1); });
+  temperature.ProjectCoefficient(exact);
+
+  output::GLVisAggregator aggregator(MPI_COMM_WORLD, num_writers, compress);
+  auto write = aggregator.gather("glvis_output", 0, mesh, {{"temperature", &temperature}}, 8);
+  EXPECT_EQ(static_cast<bool>(write), aggregator.isWriter());
+  if (write) {
+    write();
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Each writer's files hold a contiguous block of the ranks' elements, so together they cover the whole mesh
+  if (mesh.GetMyRank() == 0) {
+    int num_elements = 0;
+    for (int group = 0; group < std::min(num_writers, mesh.GetNRanks()); group++) {
+      mfem::named_ifgzstream mesh_file(fmt::format("glvis_output-mesh.000000.{0:0>6}", group).c_str());
+      mfem::Mesh             merged_mesh(mesh_file, 1, 0);
+      num_elements += merged_mesh.GetNE();
+
+      mfem::named_ifgzstream field_file(fmt::format("glvis_output-temperature.000000.{0:0>6}", group).c_str());
+      mfem::GridFunction     merged_field(&merged_mesh, field_file);
+      EXPECT_NEAR(merged_field.ComputeL2Error(exact), 0.0, 1.0e-8);
+    }
+    EXPECT_EQ(num_elements, serial_mesh.GetNE());
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(glvis_output, single_writer) { aggregateAndCheck(1, false); }
+
+TEST(glvis_output, writer_per_rank_compressed) { aggregateAndCheck(2, true); }
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
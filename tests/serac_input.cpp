@@ -6,6 +6,8 @@
 
 #include "serac/infrastructure/input.hpp"
 
+#include <fstream>
+
 #include <gtest/gtest.h>
 #include "mfem.hpp"
 
@@ -243,6 +245,47 @@ TEST_F(InputTest, coef_build_scalar_from_vec)
   EXPECT_THROW(coef_opts.constructScalar(), SlicErrorException);
 }
 
+/**
+ * @brief Reads a time-only coefficient function that counts its interpreter calls, and returns the number of calls
+ * made by evaluating it at a few positions at one time
+ */
+int interpreterCallsAtOneTime(axom::inlet::Inlet& inlet)
+{
+  auto& coef_table = inlet.addStruct("coef_opts");
+  input::CoefficientInputOptions::defineInputFileSchema(coef_table);
+  auto coef_opts = coef_table.get<input::CoefficientInputOptions>();
+
+  auto&        lua_state = static_cast<axom::inlet::LuaReader&>(inlet.reader()).solState();
+  const int    calls     = lua_state["calls"].get<int>();
+  mfem::Vector x(3);
+  for (int i = 0; i < 4; i++) {
+    x = 0.5 * i;
+    EXPECT_DOUBLE_EQ(coef_opts.scalar_function(x, 1.25), 2.5);
+  }
+  return lua_state["calls"].get<int>() - calls;
+}
+
+TEST(InputInitialize, lua_functions_accelerated_while_inlet_alive)
+{
+  const std::string function = "calls = 0\ncoef_opts = { scalar_function = function(v, t)\n  calls = calls + 1\n"
+                               "  return 2 * t\nend }\n";
+  const std::string input_file_path = "serac_input_initialize.lua";
+  std::ofstream(input_file_path) << function;
+
+  {
+    axom::sidre::DataStore datastore;
+    auto                   inlet = input::initialize(datastore, input_file_path);
+    // The function only depends on the time, so the interpreter is only called once per time value
+    EXPECT_EQ(interpreterCallsAtOneTime(inlet), 1);
+  }
+
+  // An Inlet created without initialize can't find the sources, so the destroyed Lua state above mustn't be used
+  axom::sidre::DataStore datastore;
+  axom::inlet::Inlet     inlet(std::make_unique<axom::inlet::LuaReader>(), datastore.getRoot());
+  inlet.reader().parseString(function);
+  EXPECT_EQ(interpreterCallsAtOneTime(inlet), 4);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
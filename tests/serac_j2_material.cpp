@@ -0,0 +1,159 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/materials/j2_material.hpp"
+
+#include <cmath>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+namespace serac {
+
+namespace {
+
+const J2Material::Parameters parameters{.K = 100.0, .G = 40.0, .Hi = 1.0, .Hk = 2.3, .sigma_y = 3.0};
+
+std::unique_ptr<mfem::Mesh> unitMesh(const int dim)
+{
+  if (dim == 2) {
+    return std::make_unique<mfem::Mesh>(2, 2, mfem::Element::QUADRILATERAL);
+  }
+  return std::make_unique<mfem::Mesh>(2, 2, 2, mfem::Element::HEXAHEDRON);
+}
+
+// The Kirchhoff stress tau = J sigma, whose derivative is the tangent returned by evalTangentStiffness
+mfem::DenseMatrix kirchhoffStress(const J2Material& material, const mfem::DenseMatrix& du_dX, const bool finite_strain)
+{
+  mfem::DenseMatrix sigma;
+  material.evalStress(du_dX, sigma);
+  if (finite_strain) {
+    mfem::DenseMatrix F(du_dX);
+    for (int i = 0; i < F.Height(); i++) {
+      F(i, i) += 1.0;
+    }
+    sigma *= F.Det();
+  }
+  return sigma;
+}
+
+void checkConsistency(const int dim, const bool finite_strain)
+{
+  auto                         mesh = unitMesh(dim);
+  const mfem::IntegrationRule& ir   = mfem::IntRules.Get(mesh->GetElementBaseGeometry(0), 5);
+
+  QuadratureData<J2Material::State> state(mesh->GetNE(), ir.GetNPoints());
+  J2Material                        material(parameters, finite_strain, state);
+
+  const int                    element = 1;
+  mfem::ElementTransformation& T       = *mesh->GetElementTransformation(element);
+  material.setTransformation(T);
+
+  // Load into the plastic range, then continue from the committed state
+  mfem::DenseTensor du_dX(dim, dim, ir.GetNPoints()), sigma;
+  for (int k = 0; k < du_dX.TotalSize(); k++) {
+    du_dX.Data()[k] = 0.05 * std::sin(1.0 + 3.0 * k);
+  }
+  material.evalStresses(ir, du_dX, sigma);
+  state.commit();
+  for (int k = 0; k < du_dX.TotalSize(); k++) {
+    du_dX.Data()[k] += 0.05 * std::cos(2.0 * k);
+  }
+  material.evalStresses(ir, du_dX, sigma);
+
+  const double epsilon     = 1.0e-7;
+  int          num_plastic = 0;
+  for (int q = 0; q < ir.GetNPoints(); q++) {
+    num_plastic += state(element, q).pl_strain_inc > 0.0;
+
+    T.SetIntPoint(&ir.IntPoint(q));
+    mfem::DenseMatrix point_sigma;
+    material.evalStress(du_dX(q), point_sigma);
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        EXPECT_NEAR(point_sigma(i, j), sigma(i, j, q), 1.0e-12);
+      }
+    }
+
+    // c_ijkl = d tau_ij / dF_km F_lm
+    mfem_ext::Array4D<double> C;
+    material.evalTangentStiffness(du_dX(q), C);
+    const auto tau = kirchhoffStress(material, du_dX(q), finite_strain);
+    for (int k = 0; k < dim; k++) {
+      for (int m = 0; m < dim; m++) {
+        mfem::DenseMatrix perturbed(du_dX(q));
+        perturbed(k, m) += epsilon;
+        const auto dtau = kirchhoffStress(material, perturbed, finite_strain);
+        for (int i = 0; i < dim; i++) {
+          for (int j = 0; j < dim; j++) {
+            for (int l = 0; l < dim; l++) {
+              const double F_lm = (l == m) + (finite_strain ? du_dX(l, m, q) : 0.0);
+              C(i, j, k, l) -= (dtau(i, j) - tau(i, j)) / epsilon * F_lm;
+            }
+          }
+        }
+      }
+    }
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          for (int l = 0; l < dim; l++) {
+            EXPECT_NEAR(C(i, j, k, l), 0.0, 1.0e-3);
+          }
+        }
+      }
+    }
+  }
+  EXPECT_GT(num_plastic, 0);
+}
+
+}  // namespace
+
+TEST(j2_material, small_strain_2D) { checkConsistency(2, false); }
+TEST(j2_material, small_strain_3D) { checkConsistency(3, false); }
+TEST(j2_material, finite_strain_2D) { checkConsistency(2, true); }
+TEST(j2_material, finite_strain_3D) { checkConsistency(3, true); }
+
+TEST(j2_material, stress_stays_on_yield_surface)
+{
+  // Without kinematic hardening, the yield stress grows linearly with the plastic strain
+  J2Material::Parameters isotropic = parameters;
+  isotropic.Hk                     = 0.0;
+
+  J2Material::State state{};
+  for (int step = 1; step <= 10; step++) {
+    tensor<double, 3, 3> strain{};
+    strain[0][0]      = 0.03 * step;
+    strain[1][1]      = -0.015 * step;
+    strain[2][2]      = -0.015 * step;
+    const auto stress = J2Material::stress(isotropic, strain, state);
+    EXPECT_GT(state.pl_strain_inc, 0.0);
+    EXPECT_NEAR(std::sqrt(1.5) * norm(dev(stress)), isotropic.sigma_y + isotropic.Hi * state.pl_strain, 1.0e-10);
+  }
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/physics/operators/stdfunction_operator.hpp"
+#include "serac/physics/utilities/equation_solver.hpp"
+
+namespace serac {
+
+/**
+ * @brief The residual K u + u^3 - f of a nonlinear reaction-diffusion problem, with u = 0 on the boundary, and its
+ * assembled Jacobian K + 3 diag(u^2), whose boundary rows and columns are eliminated
+ */
+class ReactionDiffusion {
+public:
+  ReactionDiffusion(mfem::ParFiniteElementSpace& space) : space_(space), f_(space.GetTrueVSize())
+  {
+    mfem::ParBilinearForm     form(&space);
+    mfem::ConstantCoefficient one(1.0);
+    form.AddDomainIntegrator(new mfem::DiffusionIntegrator(one));
+    form.Assemble(0);
+    form.Finalize(0);
+    K_.reset(form.ParallelAssemble());
+
+    mfem::Array<int> boundary(space.GetMesh()->bdr_attributes.Max());
+    boundary = 1;
+    space.GetEssentialTrueDofs(boundary, ess_dofs_);
+
+    f_ = 10.0;
+    f_.SetSubVector(ess_dofs_, 0.0);
+  }
+
+  /**
+   * @brief Returns the residual, whose gradient counts the assemblies
+   */
+  mfem_ext::StdFunctionOperator residual()
+  {
+    return mfem_ext::StdFunctionOperator(
+        space_.GetTrueVSize(),
+        [this](const mfem::Vector& u, mfem::Vector& r) {
+          K_->Mult(u, r);
+          for (int i = 0; i < u.Size(); i++) {
+            r(i) += u(i) * u(i) * u(i) - f_(i);
+          }
+          for (auto dof : ess_dofs_) {
+            r(dof) = u(dof);
+          }
+        },
+        [this](const mfem::Vector& u) -> mfem::Operator& {
+          mfem::Vector reaction(u.Size());
+          for (int i = 0; i < u.Size(); i++) {
+            reaction(i) = 3.0 * u(i) * u(i);
+          }
+          mfem::SparseMatrix   diagonal(reaction);
+          mfem::HypreParMatrix D(space_.GetComm(), space_.GlobalTrueVSize(), space_.GetTrueDofOffsets(), &diagonal);
+          J_.reset(mfem::Add(1.0, *K_, 1.0, D));
+          delete J_->EliminateRowsCols(ess_dofs_);
+          assemblies_++;
+          return *J_;
+        });
+  }
+
+  /**
+   * @brief Returns the boundary true degrees of freedom
+   */
+  const mfem::Array<int>& essentialDofs() const { return ess_dofs_; }
+
+  /**
+   * @brief Returns the number of assembled Jacobians
+   */
+  int assemblies() const { return assemblies_; }
+
+private:
+  mfem::ParFiniteElementSpace&          space_;
+  std::unique_ptr<mfem::HypreParMatrix> K_;
+  std::unique_ptr<mfem::HypreParMatrix> J_;
+  mfem::Vector                          f_;
+  mfem::Array<int>                      ess_dofs_;
+  int                                   assemblies_ = 0;
+};
+
+TEST(jacobian_free, matches_assembled_newton)
+{
+  mfem::Mesh                  serial_mesh(8, 8, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh               mesh(MPI_COMM_WORLD, serial_mesh);
+  mfem::H1_FECollection       fec(1, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+
+  const IterativeSolverOptions linear_options{.rel_tol     = 1.0e-12,
+                                              .abs_tol     = 1.0e-14,
+                                              .print_level = -1,
+                                              .max_iter    = 500,
+                                              .lin_solver  = LinearSolver::GMRES,
+                                              .prec        = HypreSmootherPrec{mfem::HypreSmoother::Jacobi}};
+
+  NonlinearSolverOptions nonlinear_options{
+      .rel_tol = 1.0e-10, .abs_tol = 1.0e-12, .max_iter = 50, .print_level = -1};
+
+  ReactionDiffusion assembled_problem(space);
+  auto              assembled_residual = assembled_problem.residual();
+  mfem::Vector      zero(space.GetTrueVSize());
+  zero = 0.0;
+
+  mfem_ext::EquationSolver assembled(MPI_COMM_WORLD, linear_options, nonlinear_options);
+  assembled.SetOperator(assembled_residual);
+  mfem::Vector u_assembled(zero);
+  assembled.Mult(zero, u_assembled);
+  ASSERT_TRUE(assembled.NonlinearSolver().GetConverged());
+
+  nonlinear_options.jacobian_free = JacobianFreeOptions{.preconditioner_lag = 3};
+  ReactionDiffusion jacobian_free_problem(space);
+  auto              jacobian_free_residual = jacobian_free_problem.residual();
+
+  mfem_ext::EquationSolver jacobian_free(MPI_COMM_WORLD, linear_options, nonlinear_options);
+  jacobian_free.SetOperator(jacobian_free_residual);
+  jacobian_free.SetEssentialTrueDofs(jacobian_free_problem.essentialDofs());
+  mfem::Vector u_jacobian_free(zero);
+  jacobian_free.Mult(zero, u_jacobian_free);
+  ASSERT_TRUE(jacobian_free.NonlinearSolver().GetConverged());
+
+  mfem::Vector difference(u_jacobian_free);
+  difference -= u_assembled;
+  EXPECT_LT(mfem::ParNormlp(difference, mfem::infinity(), MPI_COMM_WORLD),
+            1.0e-6 * mfem::ParNormlp(u_assembled, mfem::infinity(), MPI_COMM_WORLD));
+
+  // The Jacobian is only assembled to update the preconditioner
+  const int newton_iterations = jacobian_free.NonlinearSolver().GetNumIterations();
+  EXPECT_EQ(jacobian_free_problem.assemblies(), (newton_iterations + 2) / 3);
+  EXPECT_LT(jacobian_free_problem.assemblies(), assembled_problem.assemblies());
+}
+
+TEST(jacobian_free, input_file_without_block)
+{
+  axom::sidre::DataStore datastore;
+  axom::inlet::Inlet     inlet(std::make_unique<axom::inlet::LuaReader>(), datastore.getRoot());
+  inlet.reader().parseString("solver = { nonlinear = { rel_tol = 1.0e-8 } }");
+  auto& solver_table = inlet.addStruct("solver", "Equation solver parameters");
+  mfem_ext::EquationSolver::DefineInputFileSchema(solver_table);
+  auto options = solver_table["nonlinear"].get<NonlinearSolverOptions>();
+
+  EXPECT_DOUBLE_EQ(options.rel_tol, 1.0e-8);
+  EXPECT_FALSE(options.jacobian_free);
+}
+
+TEST(jacobian_free, input_file_enabled)
+{
+  axom::sidre::DataStore datastore;
+  axom::inlet::Inlet     inlet(std::make_unique<axom::inlet::LuaReader>(), datastore.getRoot());
+  inlet.reader().parseString("solver = { nonlinear = { jacobian_free = { enabled = true, gamma = 0.5 } } }");
+  auto& solver_table = inlet.addStruct("solver", "Equation solver parameters");
+  mfem_ext::EquationSolver::DefineInputFileSchema(solver_table);
+  auto options = solver_table["nonlinear"].get<NonlinearSolverOptions>();
+
+  // The omitted fields take the defaults of JacobianFreeOptions
+  ASSERT_TRUE(options.jacobian_free);
+  const JacobianFreeOptions defaults;
+  EXPECT_EQ(options.jacobian_free->preconditioner_lag, defaults.preconditioner_lag);
+  EXPECT_DOUBLE_EQ(options.jacobian_free->initial_forcing_term, defaults.initial_forcing_term);
+  EXPECT_DOUBLE_EQ(options.jacobian_free->max_forcing_term, defaults.max_forcing_term);
+  EXPECT_DOUBLE_EQ(options.jacobian_free->gamma, 0.5);
+}
+
+TEST(jacobian_free, input_file_disabled)
+{
+  axom::sidre::DataStore datastore;
+  axom::inlet::Inlet     inlet(std::make_unique<axom::inlet::LuaReader>(), datastore.getRoot());
+  inlet.reader().parseString("solver = { nonlinear = { jacobian_free = { preconditioner_lag = 3 } } }");
+  auto& solver_table = inlet.addStruct("solver", "Equation solver parameters");
+  mfem_ext::EquationSolver::DefineInputFileSchema(solver_table);
+  auto options = solver_table["nonlinear"].get<NonlinearSolverOptions>();
+
+  EXPECT_FALSE(options.jacobian_free);
+}
+
+TEST(jacobian_free, input_file_gamma_range)
+{
+  // The forcing terms vanish for gamma = 0, which the solver rejects, so the schema does too
+  for (const auto& [gamma, valid] : {std::pair{"1.0", true}, std::pair{"0.0", false}, std::pair{"1.5", false}}) {
+    axom::sidre::DataStore datastore;
+    axom::inlet::Inlet     inlet(std::make_unique<axom::inlet::LuaReader>(), datastore.getRoot());
+    inlet.reader().parseString(
+        std::string("solver = { linear = { type = \"direct\", direct_options = { print_level = 0 } }, ") +
+        "nonlinear = { jacobian_free = { enabled = true, gamma = " + gamma + " } } }");
+    auto& solver_table = inlet.addStruct("solver", "Equation solver parameters");
+    mfem_ext::EquationSolver::DefineInputFileSchema(solver_table);
+    EXPECT_EQ(inlet.verify(), valid) << "gamma = " << gamma;
+  }
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
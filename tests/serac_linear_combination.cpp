@@ -0,0 +1,125 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/assembled_linear_combination.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "test_utilities.hpp"
+
+namespace serac {
+
+/**
+ * @brief Assembles the parallel matrix of a bilinear form with a single domain integrator
+ */
+std::unique_ptr<mfem::HypreParMatrix> assemble(mfem::ParFiniteElementSpace& space,
+                                               mfem::BilinearFormIntegrator* integrator, int skip_zeros)
+{
+  mfem::ParBilinearForm form(&space);
+  form.AddDomainIntegrator(integrator);
+  form.Assemble(skip_zeros);
+  form.Finalize(skip_zeros);
+  return std::unique_ptr<mfem::HypreParMatrix>(form.ParallelAssemble());
+}
+
+TEST(linear_combination, matches_hypre_sum)
+{
+  constexpr int               p = 2;
+  mfem::Mesh                  serial_mesh(6, 6, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh               mesh(MPI_COMM_WORLD, serial_mesh);
+  mfem::H1_FECollection       fec(p, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+  auto                      M = assemble(space, new mfem::MassIntegrator(one), 0);
+  auto                      K = assemble(space, new mfem::DiffusionIntegrator(one), 0);
+
+  // The lumped mass is diagonal, so it has a smaller sparsity than the other summands
+  auto C = assemble(space, new mfem::LumpedIntegrator(new mfem::MassIntegrator(one)), 1);
+
+  mfem::HypreParVector x(&space);
+  x.Randomize(1);
+  mfem::Vector expected(x.Size());
+  mfem::Vector actual(x.Size());
+
+  mfem_ext::AssembledLinearCombination combination;
+  EXPECT_FALSE(combination.hasSparsity());
+
+  for (double c0 : {0.5, 2.0, -1.0}) {
+    const double c1 = 3.0 * c0;
+    auto&        J  = combination.update({1.0, c1, c0}, {M.get(), C.get(), K.get()});
+
+    std::unique_ptr<mfem::HypreParMatrix> MC(mfem::Add(1.0, *M, c1, *C));
+    std::unique_ptr<mfem::HypreParMatrix> reference(mfem::Add(1.0, *MC, c0, *K));
+    reference->Mult(x, expected);
+    J.Mult(x, actual);
+
+    actual -= expected;
+    EXPECT_NEAR(actual.Normlinf(), 0.0, 1e-12 * expected.Normlinf());
+  }
+  EXPECT_TRUE(combination.hasSparsity());
+  EXPECT_GT(combination.memoryUsage().parts().at("summand maps"), 0);
+
+  // A different set of summands replaces the sparsity
+  auto& J = combination.update({2.0}, {M.get()});
+  M->Mult(x, expected);
+  J.Mult(x, actual);
+  actual.Add(-2.0, expected);
+  EXPECT_NEAR(actual.Normlinf(), 0.0, 1e-12 * expected.Normlinf());
+}
+
+TEST(linear_combination, same_counts_different_columns)
+{
+  constexpr int               p = 2;
+  mfem::Mesh                  serial_mesh(6, 6, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh               mesh(MPI_COMM_WORLD, serial_mesh);
+  mfem::H1_FECollection       fec(p, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+  auto                      M = assemble(space, new mfem::MassIntegrator(one), 0);
+
+  // Reversing the local numbering of the degrees of freedom keeps the nonzero counts of every block, but moves them
+  auto reversed = test_utils::reverseNumbering(*M, space);
+
+  mfem::HypreParVector x(&space);
+  x.Randomize(1);
+  mfem::Vector expected(x.Size());
+  mfem::Vector actual(x.Size());
+
+  mfem_ext::AssembledLinearCombination combination;
+  combination.update({1.0}, {M.get()});
+  auto& J = combination.update({1.0}, {reversed.get()});
+  reversed->Mult(x, expected);
+  J.Mult(x, actual);
+  actual -= expected;
+  EXPECT_NEAR(actual.Normlinf(), 0.0, 1e-12 * expected.Normlinf());
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
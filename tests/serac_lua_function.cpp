@@ -0,0 +1,115 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "mpi.h"
+
+#include "serac/infrastructure/lua_function.hpp"
+
+namespace serac {
+
+using input::LuaFunctionAnalysis;
+
+TEST(serac_lua_function, scalar_space_time)
+{
+  auto analysis = LuaFunctionAnalysis::analyze(R"(temp_func = function (v, t)
+    return 1.0 + 6.0 * v.x * t - 2.0 * v.y * t + (v.x - v.y) * v.x * v.x
+end)");
+  EXPECT_TRUE(analysis.depends_on_position);
+  ASSERT_TRUE(analysis.compiled);
+  EXPECT_EQ(analysis.compiled->numComponents(), 1);
+  EXPECT_EQ(analysis.compiled->requiredDimension(), 2);
+
+  const double x[2] = {0.3, -1.2};
+  const double t    = 0.7;
+  EXPECT_DOUBLE_EQ(analysis.compiled->evaluate(0, x, t),
+                   1.0 + 6.0 * x[0] * t - 2.0 * x[1] * t + (x[0] - x[1]) * x[0] * x[0]);
+}
+
+TEST(serac_lua_function, precedence_and_math)
+{
+  auto analysis = LuaFunctionAnalysis::analyze(
+      "function (v) return -v.x^2 + 2^-1 + 7 % -3 + 7 // 2 + math.sin(math.pi * v.z) + math.max(v.x, 1, v.y) end");
+  ASSERT_TRUE(analysis.compiled);
+  EXPECT_EQ(analysis.compiled->requiredDimension(), 3);
+
+  const double x[3] = {1.5, 4.0, 0.25};
+  EXPECT_DOUBLE_EQ(analysis.compiled->evaluate(0, x, 0.0),
+                   -(1.5 * 1.5) + 0.5 + (-2.0) + 3.0 + std::sin(M_PI * 0.25) + 4.0);
+}
+
+TEST(serac_lua_function, vector)
+{
+  auto analysis = LuaFunctionAnalysis::analyze(R"(
+    vector_function = function (v, t) -- comments are skipped
+        return Vector.new(v.y * t, -v.x)
+    end,)");
+  ASSERT_TRUE(analysis.compiled);
+  ASSERT_EQ(analysis.compiled->numComponents(), 2);
+
+  const double x[2] = {2.0, 3.0};
+  EXPECT_DOUBLE_EQ(analysis.compiled->evaluate(0, x, 0.5), 1.5);
+  EXPECT_DOUBLE_EQ(analysis.compiled->evaluate(1, x, 0.5), -2.0);
+}
+
+TEST(serac_lua_function, time_only)
+{
+  auto analysis = LuaFunctionAnalysis::analyze("function (v, t) return math.exp(-t) end");
+  EXPECT_FALSE(analysis.depends_on_position);
+  ASSERT_TRUE(analysis.compiled);
+  EXPECT_DOUBLE_EQ(analysis.compiled->evaluate(0, nullptr, 2.0), std::exp(-2.0));
+
+  // Not compilable, but still only a function of time
+  analysis = LuaFunctionAnalysis::analyze(R"(function (v, t)
+    if t < 1.0 then
+      return t
+    end
+    return 1.0
+  end)");
+  EXPECT_FALSE(analysis.depends_on_position);
+  EXPECT_FALSE(analysis.compiled);
+}
+
+TEST(serac_lua_function, unsupported)
+{
+  // Statements, globals, and unknown fields are left to the interpreter
+  auto analysis = LuaFunctionAnalysis::analyze(R"(function (v)
+    x = v.x
+    s = 0.1 / 64
+    return Vector.new(-s * x * x, s * x * x * (8.0 - x))
+  end)");
+  EXPECT_TRUE(analysis.depends_on_position);
+  EXPECT_FALSE(analysis.compiled);
+
+  EXPECT_FALSE(LuaFunctionAnalysis::analyze("function (v) return scale * v.x end").compiled);
+  EXPECT_FALSE(LuaFunctionAnalysis::analyze("function (v) return v.dim end").compiled);
+  EXPECT_FALSE(LuaFunctionAnalysis::analyze("not a function").compiled);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/memory_usage.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/physics/utilities/functional/functional.hpp"
+
+namespace serac {
+
+TEST(memory_usage, parts_of_subcomponents)
+{
+  MemoryUsage solver;
+  solver.add("AMG hierarchy", 100);
+
+  MemoryUsage usage;
+  usage.add("Jacobian", 30);
+  usage.add("work vectors", 8);
+  usage.add("work vectors", 16);
+  usage.add("nonlinear solver", solver);
+
+  EXPECT_EQ(usage.parts().size(), 3);
+  EXPECT_EQ(usage.parts().at("work vectors"), 24);
+  EXPECT_EQ(usage.parts().at("nonlinear solver/AMG hierarchy"), 100);
+  EXPECT_EQ(usage.total(), 154);
+}
+
+TEST(memory_usage, linear_algebra)
+{
+  mfem::Vector vector(10);
+  EXPECT_EQ(memory::bytes(vector), 10 * sizeof(double));
+
+  mfem::Array<int> array(7);
+  EXPECT_EQ(memory::bytes(array), 7 * sizeof(int));
+
+  mfem::SparseMatrix matrix(3);
+  for (int i = 0; i < 3; i++) {
+    matrix.Add(i, i, 1.0);
+  }
+  matrix.Add(0, 2, 1.0);
+  matrix.Finalize();
+  EXPECT_EQ(memory::bytes(matrix), 4 * sizeof(int) + 4 * (sizeof(int) + sizeof(double)));
+
+#ifdef __linux__
+  EXPECT_GT(memory::residentBytes(), 0);
+#endif
+  EXPECT_GT(memory::peakResidentBytes(), 0);
+}
+
+TEST(memory_usage, functional_and_amg)
+{
+  constexpr int               p = 2;
+  mfem::Mesh                  serial_mesh(4, 4, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh               mesh(MPI_COMM_WORLD, serial_mesh);
+  mfem::H1_FECollection       fec(p, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&space, &space);
+  residual.AddDomainIntegral(
+      Dimension<2>{},
+      [](auto /* x */, auto temperature) {
+        auto [u, du_dx] = temperature;
+        return std::tuple{u, du_dx};
+      },
+      mesh);
+
+  // The derivatives of the quadrature function are stored at every point from the start, the element matrices only
+  // once they are computed
+  auto usage = residual.memoryUsage();
+  EXPECT_GT(usage.parts().at("domain integrals/quadrature function derivatives"), 0);
+  EXPECT_EQ(usage.parts().at("element matrices"), 0);
+
+  std::unique_ptr<mfem::HypreParMatrix> K(residual.GetAssembledSparseMatrix().ParallelAssemble());
+  usage = residual.memoryUsage();
+  EXPECT_EQ(usage.parts().at("element matrices"), 9 * 9 * mesh.GetNE() * sizeof(double));
+  EXPECT_GT(usage.parts().at("assembled matrix/CSR"), 0);
+  EXPECT_GT(memory::bytes(*K), 0);
+
+  // The hierarchy is built by the first application
+  mfem::HypreBoomerAMG amg(*K);
+  amg.SetPrintLevel(0);
+  EXPECT_EQ(memory::bytes(amg), 0);
+  mfem::Vector b(K->Height()), x(K->Height());
+  b = 1.0;
+  x = 0.0;
+  amg.Mult(b, x);
+  EXPECT_GT(memory::bytes(amg), 0);
+
+  memory::report("Functional memory usage", usage);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
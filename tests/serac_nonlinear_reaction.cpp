@@ -0,0 +1,88 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/integrators/nonlinear_reaction_integrator.hpp"
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+namespace serac {
+
+TEST(nonlinear_reaction, dual_matches_hand_coded_derivative)
+{
+  mfem::Mesh                  serial_mesh(3, 3, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh               mesh(MPI_COMM_WORLD, serial_mesh);
+  mfem::H1_FECollection       fec(2, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+  mfem::FunctionCoefficient   scale([](const mfem::Vector& x) { return 1.0 + x(0); });
+
+  mfem_ext::NonlinearReactionIntegrator hand_coded([](double T) { return T * T * T + 2.0 * std::exp(0.5 * T); },
+                                                   [](double T) { return 3.0 * T * T + std::exp(0.5 * T); }, scale);
+
+  mfem_ext::NonlinearReactionIntegrator automatic(
+      mfem_ext::batchReaction([](auto T) {
+        using std::exp;
+        return T * T * T + 2.0 * exp(0.5 * T);
+      }),
+      scale);
+
+  mfem::Vector      state, expected_residual, residual, perturbed, perturbed_residual;
+  mfem::DenseMatrix expected_gradient, gradient;
+  for (int e = 0; e < space.GetNE(); e++) {
+    const mfem::FiniteElement& element = *space.GetFE(e);
+    state.SetSize(element.GetDof());
+    for (int i = 0; i < state.Size(); i++) {
+      state(i) = std::sin(1.0 + e + 2 * i);
+    }
+
+    hand_coded.AssembleElementVector(element, *space.GetElementTransformation(e), state, expected_residual);
+    hand_coded.AssembleElementGrad(element, *space.GetElementTransformation(e), state, expected_gradient);
+    automatic.AssembleElementVector(element, *space.GetElementTransformation(e), state, residual);
+    automatic.AssembleElementGrad(element, *space.GetElementTransformation(e), state, gradient);
+
+    for (int i = 0; i < state.Size(); i++) {
+      EXPECT_NEAR(residual(i), expected_residual(i), 1.0e-13);
+      for (int j = 0; j < state.Size(); j++) {
+        EXPECT_NEAR(gradient(i, j), expected_gradient(i, j), 1.0e-13);
+      }
+    }
+
+    // Check the gradient against a finite difference of the residual
+    const double epsilon = 1.0e-6;
+    for (int j = 0; j < state.Size(); j++) {
+      perturbed = state;
+      perturbed(j) += epsilon;
+      automatic.AssembleElementVector(element, *space.GetElementTransformation(e), perturbed, perturbed_residual);
+      for (int i = 0; i < state.Size(); i++) {
+        EXPECT_NEAR((perturbed_residual(i) - residual(i)) / epsilon, gradient(i, j), 1.0e-5);
+      }
+    }
+  }
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -0,0 +1,173 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "axom/inlet.hpp"
+#include "axom/sidre.hpp"
+
+#include "mpi.h"
+
+#include "serac/infrastructure/output_scheduler.hpp"
+
+namespace serac {
+
+using output::Cadence;
+using output::OutputEvent;
+using output::OutputScheduler;
+using output::ScheduleInputOptions;
+
+TEST(serac_output_scheduler, cycle_interval)
+{
+  Cadence cadence;
+  cadence.cycle_interval = 3;
+  OutputScheduler scheduler(cadence);
+
+  std::vector<int> written;
+  for (int cycle = 1; cycle <= 10; cycle++) {
+    if (scheduler.check(cycle, 0.1 * cycle)) {
+      written.push_back(cycle);
+    }
+  }
+  EXPECT_EQ(written, (std::vector<int>{3, 6, 9}));
+}
+
+TEST(serac_output_scheduler, time_interval)
+{
+  Cadence cadence;
+  cadence.time_interval = 0.25;
+  OutputScheduler scheduler(cadence);
+
+  // A timestep of 0.1 crosses each multiple of 0.25 once, without drifting
+  std::vector<int> written;
+  double           t = 0.0;
+  for (int cycle = 1; cycle <= 10; cycle++) {
+    t += 0.1;
+    if (scheduler.check(cycle, t)) {
+      written.push_back(cycle);
+    }
+  }
+  EXPECT_EQ(written, (std::vector<int>{3, 5, 8, 10}));
+}
+
+TEST(serac_output_scheduler, time_interval_large_step)
+{
+  Cadence cadence;
+  cadence.time_interval = 0.1;
+  OutputScheduler scheduler(cadence, 1.0);
+
+  EXPECT_FALSE(scheduler.check(1, 1.05));
+  // A step that skips several intervals only writes once
+  EXPECT_TRUE(scheduler.check(2, 1.35));
+  EXPECT_FALSE(scheduler.check(3, 1.38));
+  EXPECT_TRUE(scheduler.check(4, 1.4));
+}
+
+TEST(serac_output_scheduler, wall_time_interval)
+{
+  Cadence cadence;
+  cadence.wall_time_interval = 0.02;
+  OutputScheduler scheduler(cadence);
+
+  EXPECT_FALSE(scheduler.check(1, 1.0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_TRUE(scheduler.check(2, 2.0));
+  EXPECT_FALSE(scheduler.check(3, 3.0));
+}
+
+TEST(serac_output_scheduler, events)
+{
+  OutputScheduler last_step(Cadence::lastStepOnly());
+  EXPECT_FALSE(last_step.check(1, 1.0));
+  EXPECT_FALSE(last_step.check(2, 2.0, {OutputEvent::SolveFailure}));
+  EXPECT_TRUE(last_step.check(3, 3.0, {OutputEvent::LastStep}));
+
+  Cadence cadence;
+  cadence.cycle_interval = 100;
+  OutputScheduler failure(cadence);
+  EXPECT_TRUE(failure.check(1, 1.0, {OutputEvent::SolveFailure}));
+
+  OutputScheduler never(Cadence::never());
+  EXPECT_FALSE(never.check(1, 1.0, {OutputEvent::LastStep, OutputEvent::SolveFailure}));
+}
+
+TEST(serac_output_scheduler, is_due_does_not_record)
+{
+  Cadence cadence;
+  cadence.time_interval = 1.0;
+  OutputScheduler scheduler(cadence);
+
+  EXPECT_TRUE(scheduler.isDue(1, 1.0));
+  EXPECT_TRUE(scheduler.isDue(1, 1.0));
+  scheduler.recordOutput(1.0);
+  EXPECT_FALSE(scheduler.isDue(2, 1.5));
+}
+
+TEST(serac_output_scheduler, input_file_restart_only)
+{
+  axom::sidre::DataStore datastore;
+  axom::inlet::Inlet     inlet(std::make_unique<axom::inlet::LuaReader>(), datastore.getRoot());
+  inlet.reader().parseString("output_schedule = { restart = { cycle_interval = 5, on_last_step = false } }");
+  auto& schedule_table = inlet.addStruct("output_schedule", "Output cadences");
+  ScheduleInputOptions::defineInputFileSchema(schedule_table);
+  auto options = schedule_table.get<ScheduleInputOptions>();
+
+  ASSERT_TRUE(options.restart);
+  EXPECT_EQ(options.restart->cycle_interval.value_or(0), 5);
+  EXPECT_FALSE(options.restart->on_last_step);
+  EXPECT_TRUE(options.restart->on_solve_failure);
+
+  // The cadences that weren't given keep the driver defaults, so visualization is written every cycle
+  EXPECT_FALSE(options.visualization);
+  EXPECT_FALSE(options.fields);
+  OutputScheduler visualization(options.visualization.value_or(Cadence::everyCycle()));
+  for (int cycle = 1; cycle <= 3; cycle++) {
+    EXPECT_TRUE(visualization.check(cycle, 0.1 * cycle));
+  }
+}
+
+TEST(serac_output_scheduler, input_file_flag_only)
+{
+  axom::sidre::DataStore datastore;
+  axom::inlet::Inlet     inlet(std::make_unique<axom::inlet::LuaReader>(), datastore.getRoot());
+  inlet.reader().parseString("output_schedule = { fields = { on_solve_failure = false } }");
+  auto& schedule_table = inlet.addStruct("output_schedule", "Output cadences");
+  ScheduleInputOptions::defineInputFileSchema(schedule_table);
+  auto options = schedule_table.get<ScheduleInputOptions>();
+
+  ASSERT_TRUE(options.fields);
+  EXPECT_FALSE(options.fields->cycle_interval);
+  EXPECT_TRUE(options.fields->on_last_step);
+  EXPECT_FALSE(options.fields->on_solve_failure);
+  EXPECT_FALSE(options.visualization);
+  EXPECT_FALSE(options.restart);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
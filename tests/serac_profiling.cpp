@@ -5,6 +5,9 @@
 // SPDX-License-Identifier: (BSD-3-Clause)
 
 #include <exception>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -12,6 +15,7 @@
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/mesh_utils.hpp"
+#include "serac/physics/utilities/functional/functional.hpp"
 #include <cstring>
 
 namespace serac {
@@ -149,6 +153,132 @@ TEST(serac_profiling, temp_rvalue_reference_expr)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+/**
+ * @brief Returns the name of its built-in timer, which is its signature
+ */
+std::string timedFunction(int)
+{
+  SERAC_MARK_FUNCTION;
+  return SERAC_FUNCTION_SIGNATURE;
+}
+
+/**
+ * @brief Returns the name of its built-in timer, which differs from that of the other overload
+ */
+std::string timedFunction(double)
+{
+  SERAC_MARK_FUNCTION;
+  return SERAC_FUNCTION_SIGNATURE;
+}
+
+TEST(serac_profiling, builtin_timers_and_counters)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  profiling::resetTimersAndCounters();
+
+  // The built-in timers do not depend on Caliper being enabled
+  std::string int_timer_name;
+  for (int i = 0; i < 3; i++) {
+    int_timer_name = timedFunction(i);
+  }
+  const auto double_timer_name = timedFunction(1.0);
+
+  // Overloads are timed separately
+  EXPECT_NE(int_timer_name, double_timer_name);
+  EXPECT_EQ(profiling::timer(int_timer_name).calls, 3);
+  EXPECT_EQ(profiling::timer(double_timer_name).calls, 1);
+
+  SERAC_MARK_START("outer");
+  SERAC_MARK_START("outer");
+  SERAC_MARK_END("outer");
+  SERAC_MARK_END("outer");
+  EXPECT_EQ(profiling::timer("outer").calls, 2);
+
+  // A region name built at runtime finds the same timer as a literal
+  SERAC_MARK_START(profiling::concat("out", "er").c_str());
+  SERAC_MARK_END("outer");
+  EXPECT_EQ(profiling::timer("outer").calls, 3);
+
+  {
+    SERAC_PROFILE_SCOPE(profiling::concat("scope_", 1));
+  }
+  EXPECT_EQ(SERAC_PROFILE_EXPR_LOOP("expr_loop", 1 + 1, 4), 2);
+  EXPECT_EQ(profiling::timer("scope_1").calls, 1);
+  EXPECT_EQ(profiling::timer("expr_loop").calls, 4);
+  EXPECT_GE(profiling::timer("expr_loop").nanoseconds, 0);
+
+  // Counters are updated atomically
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 1000; j++) {
+        profiling::counter("test iterations")++;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(profiling::counter("test iterations"), 4000);
+
+  // Only one rank has this counter, the summary is still collective
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    profiling::counter("root only") += 5;
+  }
+  profiling::reportTimersAndCounters();
+
+  profiling::resetTimersAndCounters();
+  EXPECT_EQ(profiling::counter("test iterations"), 0);
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(serac_profiling, functional_kernel_performance)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  constexpr int               p    = 1;
+  auto                        mesh = mesh::refineAndDistribute(buildCuboidMesh(2, 2, 2));
+  mfem::H1_FECollection       fec(p, mesh->Dimension());
+  mfem::ParFiniteElementSpace space(mesh.get(), &fec);
+
+  Functional<H1<p>(H1<p>)> residual(&space, &space);
+  residual.AddDomainIntegral(
+      Dimension<3>{},
+      [](auto /* x */, auto temperature) {
+        auto [u, du_dx] = temperature;
+        return std::tuple{u, du_dx};
+      },
+      *mesh);
+
+  mfem::Vector U(space.GetTrueVSize()), R(space.GetTrueVSize());
+  U = 1.0;
+  for (int i = 0; i < 3; i++) {
+    residual.Mult(U, R);
+  }
+
+  auto kernels = residual.kernelPerformance();
+  ASSERT_EQ(kernels.size(), 2);
+  EXPECT_EQ(kernels[0].name, "domain integral 0/evaluation");
+  EXPECT_EQ(kernels[0].calls, 3);
+  EXPECT_EQ(kernels[1].name, "domain integral 0/gradient");
+  EXPECT_EQ(kernels[1].calls, 0);
+
+  // The element DOF values and residuals, and the Jacobians and positions at the 8 quadrature points, are the least
+  // that the evaluation kernel moves
+  const double minimum_bytes = mesh->GetNE() * (3 * 8 + 8 * 12) * sizeof(double);
+  EXPECT_GT(kernels[0].cost.bytes, minimum_bytes);
+  EXPECT_GT(kernels[0].cost.flops, 0.0);
+  EXPECT_GT(kernels[0].cost.arithmeticIntensity(), 0.0);
+
+  const double bandwidth = profiling::streamBandwidth(MPI_COMM_WORLD, 1 << 20);
+  EXPECT_GT(bandwidth, 0.0);
+  profiling::reportKernelPerformance("Functional kernels", kernels, bandwidth);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
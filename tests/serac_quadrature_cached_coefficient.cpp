@@ -0,0 +1,144 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/coefficients/quadrature_cached_coefficient.hpp"
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+namespace serac {
+
+double sourceFunction(const mfem::Vector& x) { return x(0) * x(0) + std::sin(x(1)); }
+
+class QuadratureCacheTest : public ::testing::Test {
+protected:
+  QuadratureCacheTest()
+      : serial_mesh_(4, 4, mfem::Element::QUADRILATERAL),
+        mesh_(MPI_COMM_WORLD, serial_mesh_),
+        fec_(1, mesh_.Dimension()),
+        space_(&mesh_, &fec_)
+  {
+  }
+
+  /**
+   * @brief Returns a coefficient that counts the number of times it is evaluated
+   */
+  std::unique_ptr<mfem::Coefficient> countingCoefficient()
+  {
+    return std::make_unique<mfem::FunctionCoefficient>([this](const mfem::Vector& x) {
+      num_evaluations_++;
+      return sourceFunction(x);
+    });
+  }
+
+  /**
+   * @brief Assembles the load vector of a coefficient
+   */
+  mfem::Vector assemble(mfem::Coefficient& coef, const int b = 0)
+  {
+    mfem::ParLinearForm form(&space_);
+    form.AddDomainIntegrator(new mfem::DomainLFIntegrator(coef, 2, b));
+    form.Assemble();
+    return form;
+  }
+
+  mfem::Mesh                  serial_mesh_;
+  mfem::ParMesh               mesh_;
+  mfem::H1_FECollection       fec_;
+  mfem::ParFiniteElementSpace space_;
+  int                         num_evaluations_ = 0;
+};
+
+TEST_F(QuadratureCacheTest, evaluates_once_per_point)
+{
+  // The default rule of mfem::DomainLFIntegrator is of order 2p
+  mfem_ext::QuadratureCachedCoefficient cached(countingCoefficient(), mesh_, 2);
+
+  mfem::FunctionCoefficient reference(sourceFunction);
+  mfem::Vector              expected = assemble(reference);
+
+  const int num_points = mesh_.GetNE() * mfem::IntRules.Get(mfem::Geometry::SQUARE, 2).GetNPoints();
+
+  mfem::Vector actual = assemble(cached);
+  EXPECT_EQ(num_evaluations_, num_points);
+  for (int i = 0; i < expected.Size(); i++) {
+    EXPECT_DOUBLE_EQ(actual(i), expected(i));
+  }
+
+  // The second assembly only reads the cached values
+  actual = assemble(cached);
+  EXPECT_EQ(num_evaluations_, num_points);
+  for (int i = 0; i < expected.Size(); i++) {
+    EXPECT_DOUBLE_EQ(actual(i), expected(i));
+  }
+
+  cached.invalidate();
+  assemble(cached);
+  EXPECT_EQ(num_evaluations_, 2 * num_points);
+
+  // Only a change of time discards the values
+  cached.setTime(1.0);
+  assemble(cached);
+  EXPECT_EQ(num_evaluations_, 3 * num_points);
+  cached.setTime(1.0);
+  assemble(cached);
+  EXPECT_EQ(num_evaluations_, 3 * num_points);
+  EXPECT_DOUBLE_EQ(cached.coefficient().GetTime(), 1.0);
+}
+
+TEST_F(QuadratureCacheTest, other_rules_pass_through)
+{
+  mfem_ext::QuadratureCachedCoefficient cached(countingCoefficient(), mesh_, 2);
+
+  mfem::FunctionCoefficient reference(sourceFunction);
+  mfem::Vector              expected = assemble(reference, 2);
+
+  // A rule of order 4 does not match the cached points, so every evaluation goes to the wrapped coefficient
+  const int num_points = mesh_.GetNE() * mfem::IntRules.Get(mfem::Geometry::SQUARE, 4).GetNPoints();
+  for (int repeat = 1; repeat <= 2; repeat++) {
+    mfem::Vector actual = assemble(cached, 2);
+    EXPECT_EQ(num_evaluations_, repeat * num_points);
+    for (int i = 0; i < expected.Size(); i++) {
+      EXPECT_DOUBLE_EQ(actual(i), expected(i));
+    }
+  }
+}
+
+TEST_F(QuadratureCacheTest, constant)
+{
+  mfem_ext::QuadratureCachedCoefficient cached(std::make_unique<mfem::ConstantCoefficient>(2.5), mesh_, 2);
+
+  mfem::ConstantCoefficient reference(2.5);
+  mfem::Vector              expected = assemble(reference);
+  mfem::Vector              actual   = assemble(cached);
+  for (int i = 0; i < expected.Size(); i++) {
+    EXPECT_DOUBLE_EQ(actual(i), expected(i));
+  }
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/utilities/quadrature_data.hpp"
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/physics/utilities/functional/functional.hpp"
+#include "serac/physics/utilities/state_manager.hpp"
+
+namespace serac {
+
+struct State {
+  tensor<double, 2, 2> strain;
+  double               evaluations;
+};
+
+TEST(quadrature_data, commit_and_rollback)
+{
+  QuadratureData<State> data(3, 4, State{{{{1.0, 2.0}, {3.0, 4.0}}}, 0.0});
+  static_assert(QuadratureData<State>::num_components == 5);
+  EXPECT_EQ(data.size(), 12);
+
+  // Each component is contiguous across the quadrature points
+  for (int i = 0; i < data.size(); i++) {
+    EXPECT_EQ(data.component(2)[i], 3.0);
+    EXPECT_EQ(data.component(4)[i], 0.0);
+  }
+
+  State state        = data(2, 1);
+  state.strain[0][1] = -2.0;
+  state.evaluations  = 1.0;
+  data.set(2, 1, state);
+  EXPECT_EQ(data.component(1)[2 * 4 + 1], -2.0);
+  EXPECT_EQ(data(2, 1).evaluations, 1.0);
+  EXPECT_EQ(data.committed(2, 1).evaluations, 0.0);
+
+  data.commit();
+  EXPECT_EQ(data.committed(2, 1).strain[0][1], -2.0);
+
+  state.evaluations = 2.0;
+  data.set(2, 1, state);
+  data.rollback();
+  EXPECT_EQ(data(2, 1).evaluations, 1.0);
+  EXPECT_EQ(data(2, 0).strain[1][1], 4.0);
+}
+
+TEST(quadrature_data, functional_integrand_updates_state)
+{
+  mfem::Mesh                  serial_mesh(4, 4, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh               mesh(MPI_COMM_WORLD, serial_mesh);
+  mfem::H1_FECollection       fec(1, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+
+  // A linear element is integrated with 2x2 points
+  QuadratureData<State> data(mesh.GetNE(), 4);
+
+  Functional<H1<1>(H1<1>)> residual(&space, &space);
+  residual.AddDomainIntegral(
+      Dimension<2>{},
+      [](auto /* x */, auto temperature, State& state) {
+        auto [u, du_dx] = temperature;
+        state.evaluations += 1.0;
+        return std::tuple{u, du_dx};
+      },
+      mesh, data);
+
+  mfem::Vector U(space.GetTrueVSize());
+  U = 1.0;
+
+  // Every evaluation starts from the committed state
+  residual(U);
+  residual(U);
+  EXPECT_EQ(data(0, 0).evaluations, 1.0);
+
+  data.commit();
+  residual(U);
+  for (int i = 0; i < data.size(); i++) {
+    EXPECT_EQ(data.component(4)[i], 2.0);
+  }
+
+  data.rollback();
+  EXPECT_EQ(data(mesh.GetNE() - 1, 3).evaluations, 1.0);
+}
+
+TEST(quadrature_data, restart)
+{
+  const int points_per_element = 4;
+  {
+    axom::sidre::DataStore datastore;
+    StateManager::initialize(datastore, "quadrature_data");
+    mfem::Mesh serial_mesh(2, 2, mfem::Element::QUADRILATERAL);
+    StateManager::setMesh(std::make_unique<mfem::ParMesh>(MPI_COMM_WORLD, serial_mesh));
+
+    auto data = StateManager::newQuadratureData<State>("state", points_per_element, State{{}, 3.0});
+    EXPECT_EQ(data(1, 2).evaluations, 3.0);
+
+    State state       = data(1, 2);
+    state.evaluations = 5.0;
+    data.set(1, 2, state);
+    data.commit();
+
+    // Only the committed state is written
+    state.evaluations = 7.0;
+    data.set(1, 2, state);
+    StateManager::save(1.0, 1);
+  }
+
+  axom::sidre::DataStore datastore;
+  StateManager::initialize(datastore, "quadrature_data", 1);
+  auto data = StateManager::newQuadratureData<State>("state", points_per_element, State{{}, 3.0});
+  EXPECT_EQ(data(1, 2).evaluations, 5.0);
+  EXPECT_EQ(data.committed(1, 1).evaluations, 3.0);
+  StateManager::reset();
+}
+
+TEST(quadrature_data, delete_and_recreate)
+{
+  axom::sidre::DataStore datastore;
+  StateManager::initialize(datastore, "quadrature_data_delete");
+  mfem::Mesh serial_mesh(2, 2, mfem::Element::QUADRILATERAL);
+  StateManager::setMesh(std::make_unique<mfem::ParMesh>(MPI_COMM_WORLD, serial_mesh));
+
+  {
+    auto data = StateManager::newQuadratureData<State>("state", 4, State{{}, 3.0});
+    EXPECT_EQ(data(0, 0).evaluations, 3.0);
+  }
+
+  // The name can be reused once the state is removed from the datastore
+  StateManager::deleteQuadratureData("state");
+  auto data = StateManager::newQuadratureData<State>("state", 4, State{{}, 1.0});
+  EXPECT_EQ(data(0, 0).evaluations, 1.0);
+  StateManager::reset();
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -6,6 +6,8 @@
 
 #include "serac/physics/solid.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include <gtest/gtest.h>
@@ -120,6 +122,71 @@ TEST(solid_solver, qs_custom_solve)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+/**
+ * @brief Stretches a plastic bar in one step and returns the largest committed value of its internal state
+ *
+ * @param[in] datastore The datastore holding the quadrature data
+ * @param[in] name The name of the physics module
+ * @param[in] max_iter The maximum number of Newton iterations
+ * @param[out] converged Whether the step converged
+ */
+double stretchPlasticBar(axom::sidre::DataStore& datastore, const std::string& name, const int max_iter,
+                         bool& converged)
+{
+  const IterativeSolverOptions linear_options{.rel_tol     = 1.0e-10,
+                                              .abs_tol     = 1.0e-12,
+                                              .print_level = 0,
+                                              .max_iter    = 500,
+                                              .lin_solver  = LinearSolver::GMRES,
+                                              .prec        = HypreSmootherPrec{mfem::HypreSmoother::Jacobi}};
+  const NonlinearSolverOptions nonlinear_options{
+      .rel_tol = 1.0e-8, .abs_tol = 1.0e-10, .max_iter = max_iter, .print_level = 0};
+
+  Solid solid(1, {linear_options, nonlinear_options}, GeometricNonlinearities::On, FinalMeshOption::Reference, name);
+  auto  stretch = std::make_shared<mfem::VectorFunctionCoefficient>(2, [](const mfem::Vector& x, mfem::Vector& u) {
+    u    = 0.0;
+    u(0) = 0.02 * x(0);
+  });
+  solid.setDisplacementBCs({2, 4}, stretch);
+  solid.setPlasticMaterialParameters({.K = 100.0, .G = 40.0, .Hi = 1.0, .Hk = 2.3, .sigma_y = 0.5});
+  solid.completeSetup();
+
+  double dt = 1.0;
+  solid.advanceTimestep(dt);
+  converged = solid.converged();
+
+  // The committed state is the one written to the restart files
+  auto view = datastore.getRoot()
+                  ->getGroup(StateManager::collectionName() + "_quadrature_data")
+                  ->getView(solid.displacement().name() + "_plastic_state");
+  const double* committed = view->getData();
+  double        largest   = 0.0;
+  for (axom::sidre::IndexType i = 0; i < view->getNumElements(); i++) {
+    largest = std::max(largest, std::abs(committed[i]));
+  }
+  return largest;
+}
+
+TEST(solid_solver, failed_step_discards_plastic_state)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  axom::sidre::DataStore datastore;
+  StateManager::initialize(datastore, "plastic_bar");
+  StateManager::setMesh(mesh::refineAndDistribute(buildRectangleMesh(4, 4)));
+
+  // The plastic state of a converged step is committed
+  bool converged = false;
+  EXPECT_GT(stretchPlasticBar(datastore, "converged", 20, converged), 0.0);
+  EXPECT_TRUE(converged);
+
+  // A single Newton iteration does not converge, and its trial state must not become the history of the next attempt
+  EXPECT_EQ(stretchPlasticBar(datastore, "failed", 1, converged), 0.0);
+  EXPECT_FALSE(converged);
+
+  StateManager::reset();
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,123 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/step_log.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac::profiling {
+
+namespace {
+
+std::vector<std::string> readLines(const std::string& file_name)
+{
+  std::ifstream            file(file_name);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+// Runs two timesteps, the first of which does some work in each phase
+void writeSteps(StepLog& log)
+{
+  log.beginStep();
+  timer("Assembly").nanoseconds += 2'000'000'000;
+  timer("Linear solve").nanoseconds += 500'000'000;
+  counter("Newton iterations") += 3;
+  counter("Krylov iterations") += 42;
+  log.endStep({.cycle                   = 1,
+               .time                    = 0.25,
+               .dt                      = 0.25,
+               .converged               = true,
+               .nonlinear_residual_norm = 1.0e-9,
+               .linear_residual_norm    = 1.0e-12});
+
+  log.beginStep();
+  log.endStep({.cycle                   = 2,
+               .time                    = 0.5,
+               .dt                      = 0.25,
+               .converged               = false,
+               .nonlinear_residual_norm = std::nan(""),
+               .linear_residual_norm    = 0.0});
+}
+
+}  // namespace
+
+TEST(step_log, json_lines)
+{
+  resetTimersAndCounters();
+  {
+    StepLog log("step_log.jsonl");
+    EXPECT_EQ(log.format(), StepLog::Format::JSONLines);
+    writeSteps(log);
+  }
+
+  const auto lines = readLines("step_log.jsonl");
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0].find("{\"step\": 1, \"time\": 0.25, \"dt\": 0.25, \"converged\": true"), 0);
+  EXPECT_NE(lines[0].find("\"assembly_time\": 2,"), std::string::npos);
+  EXPECT_NE(lines[0].find("\"linear_solve_time\": 0.5,"), std::string::npos);
+  EXPECT_NE(lines[0].find("\"newton_iterations\": 3,"), std::string::npos);
+  EXPECT_NE(lines[0].find("\"krylov_iterations\": 42,"), std::string::npos);
+
+  // The values are the changes over the timestep, and JSON has no NaN
+  EXPECT_NE(lines[1].find("\"converged\": false"), std::string::npos);
+  EXPECT_NE(lines[1].find("\"assembly_time\": 0,"), std::string::npos);
+  EXPECT_NE(lines[1].find("\"newton_iterations\": 0,"), std::string::npos);
+  EXPECT_NE(lines[1].find("\"nonlinear_residual_norm\": null,"), std::string::npos);
+  EXPECT_EQ(lines[1].back(), '}');
+}
+
+TEST(step_log, csv)
+{
+  resetTimersAndCounters();
+  {
+    StepLog log("step_log.csv");
+    EXPECT_EQ(log.format(), StepLog::Format::CSV);
+    writeSteps(log);
+  }
+
+  const auto lines = readLines("step_log.csv");
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0],
+            "step,time,dt,converged,wall_time,assembly_time,linear_solver_setup_time,linear_solve_time,output_time,"
+            "newton_iterations,krylov_iterations,nonlinear_residual_norm,linear_residual_norm,peak_memory_bytes");
+  EXPECT_EQ(lines[1].find("1,0.25,0.25,1,"), 0);
+  EXPECT_NE(lines[1].find(",2,0,0.5,0,3,42,1e-09,1e-12,"), std::string::npos);
+  EXPECT_EQ(lines[2].find("2,0.5,0.25,0,"), 0);
+  EXPECT_NE(lines[2].find(",0,0,0,0,0,0,nan,0,"), std::string::npos);
+}
+
+}  // namespace serac::profiling
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
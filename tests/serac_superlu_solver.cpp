@@ -0,0 +1,105 @@
+// Copyright (c) 2019-2021, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/superlu_solver.hpp"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/infrastructure/profiling.hpp"
+
+namespace serac {
+
+/**
+ * @brief Assembles the parallel matrix of a bilinear form with a single domain integrator
+ */
+std::unique_ptr<mfem::HypreParMatrix> assemble(mfem::ParFiniteElementSpace& space,
+                                               mfem::BilinearFormIntegrator* integrator, int skip_zeros)
+{
+  mfem::ParBilinearForm form(&space);
+  form.AddDomainIntegrator(integrator);
+  form.Assemble(skip_zeros);
+  form.Finalize(skip_zeros);
+  return std::unique_ptr<mfem::HypreParMatrix>(form.ParallelAssemble());
+}
+
+/**
+ * @brief Returns the relative residual of a solution of A x = b
+ */
+double relativeResidual(const mfem::HypreParMatrix& A, const mfem::Vector& b, const mfem::Vector& x)
+{
+  mfem::Vector r(b.Size());
+  A.Mult(x, r);
+  r -= b;
+  return mfem::ParNormlp(r, mfem::infinity(), A.GetComm()) / mfem::ParNormlp(b, mfem::infinity(), A.GetComm());
+}
+
+TEST(superlu_solver, reuses_analysis_for_same_sparsity)
+{
+  constexpr int               p = 2;
+  mfem::Mesh                  serial_mesh(6, 6, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh               mesh(MPI_COMM_WORLD, serial_mesh);
+  mfem::H1_FECollection       fec(p, mesh.Dimension());
+  mfem::ParFiniteElementSpace space(&mesh, &fec);
+
+  mfem::ConstantCoefficient one(1.0);
+  auto                      M = assemble(space, new mfem::MassIntegrator(one), 0);
+  auto                      K = assemble(space, new mfem::DiffusionIntegrator(one), 0);
+
+  // The lumped mass is diagonal, so it has a different sparsity
+  auto C = assemble(space, new mfem::LumpedIntegrator(new mfem::MassIntegrator(one)), 1);
+
+  mfem::HypreParVector b(&space);
+  b.Randomize(1);
+  mfem::Vector x(b.Size());
+
+  profiling::resetTimersAndCounters();
+  mfem_ext::SuperLUSolver solver(MPI_COMM_WORLD);
+
+  for (double c : {1.0, 2.0, 100.0}) {
+    std::unique_ptr<mfem::HypreParMatrix> A(mfem::Add(1.0, *M, c, *K));
+    solver.SetOperator(*A);
+    solver.Mult(b, x);
+    EXPECT_LT(relativeResidual(*A, b, x), 1e-10);
+
+    // A second solve uses the same factors
+    solver.Mult(b, x);
+    EXPECT_LT(relativeResidual(*A, b, x), 1e-10);
+  }
+  EXPECT_EQ(profiling::counter("Direct solver analyses").load(), 1);
+  EXPECT_EQ(profiling::counter("Direct solver refactorizations").load(), 2);
+  EXPECT_GT(solver.memoryUsage().parts().at("matrix"), 0);
+
+  // A new sparsity is analyzed from scratch
+  solver.SetOperator(*C);
+  solver.Mult(b, x);
+  EXPECT_LT(relativeResidual(*C, b, x), 1e-10);
+  EXPECT_EQ(profiling::counter("Direct solver analyses").load(), 2);
+}
+
+}  // namespace serac
+
+//------------------------------------------------------------------------------
+#include "axom/slic/core/SimpleLogger.hpp"
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;  // create & initialize test logger, finalized when
+                                    // exiting main scope
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -8,6 +8,7 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include <gtest/gtest.h>
@@ -69,6 +70,203 @@ TEST(thermal_solver, dyn_imp_solve_restart)
   serac::StateManager::reset();
 }
 
+/**
+ * @brief Runs the restart test with a non-default restart file layout
+ *
+ * @param[in] test_name The prefix of the output files
+ * @param[in] restart_options The restart file layout
+ */
+void runRestartTest(const std::string& test_name, const StateManager::RestartOptions& restart_options)
+{
+  StateManager::setRestartOptions(restart_options);
+
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    const std::string input_file_path =
+        std::string(SERAC_REPO_DIR) + "/data/input_files/tests/thermal_conduction/dyn_imp_solve.lua";
+    test_utils::runModuleTest<ThermalConduction>(input_file_path, test_name + "_first_phase");
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+
+  serac::StateManager::reset();
+
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    const std::string input_file_path =
+        std::string(SERAC_REPO_DIR) + "/data/input_files/tests/thermal_conduction/dyn_imp_solve_restart.lua";
+    const int restart_cycle = 5;
+    test_utils::runModuleTest<ThermalConduction>(input_file_path, test_name + "_second_phase", restart_cycle);
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+
+  serac::StateManager::reset();
+  StateManager::setRestartOptions({});
+}
+
+TEST(thermal_solver, dyn_imp_solve_restart_single_file)
+{
+  // Aggregate the restart data from all ranks into one compressed file
+  StateManager::RestartOptions restart_options;
+  restart_options.num_files = 1;
+  restart_options.compress  = true;
+  runRestartTest("dyn_imp_solve_restart_single_file", restart_options);
+}
+
+TEST(thermal_solver, dyn_imp_solve_restart_incremental)
+{
+  // The initial output is a full checkpoint and the restart cycle is reconstructed from an increment
+  StateManager::RestartOptions restart_options;
+  restart_options.incremental = true;
+  runRestartTest("dyn_imp_solve_restart_incremental", restart_options);
+}
+
+/**
+ * @brief Builds a quasistatic thermal problem, whose temperature is loaded from the restart files when restarting
+ * @param[in] source The thermal source, which determines the temperature after a step
+ */
+std::unique_ptr<ThermalConduction> buildRestartChainProblem(const double source)
+{
+  auto thermal = std::make_unique<ThermalConduction>(1, ThermalConduction::defaultQuasistaticOptions(), "chain");
+  thermal->setTemperatureBCs({1, 2, 3, 4}, std::make_shared<mfem::ConstantCoefficient>(1.0));
+  thermal->setSource(std::make_unique<mfem::ConstantCoefficient>(source));
+  thermal->completeSetup();
+  return thermal;
+}
+
+TEST(thermal_solver, incremental_restart_of_restart)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  StateManager::RestartOptions restart_options;
+  restart_options.incremental = true;
+  StateManager::setRestartOptions(restart_options);
+  double dt = 1.0;
+
+  // Cycle 0 is a full checkpoint and cycles 1 and 2 are increments
+  mfem::Vector first_phase;
+  {
+    axom::sidre::DataStore datastore;
+    StateManager::initialize(datastore, "restart_chain");
+    StateManager::setMesh(mesh::refineAndDistribute(buildRectangleMesh(4, 4)));
+    auto thermal = buildRestartChainProblem(10.0);
+    StateManager::save(thermal->time(), thermal->cycle());
+    for (int i = 0; i < 2; i++) {
+      thermal->advanceTimestep(dt);
+      StateManager::save(thermal->time(), thermal->cycle());
+    }
+    first_phase = thermal->temperature().gridFunc();
+    thermal.reset();
+    StateManager::reset();
+  }
+
+  // The restarted module continues from cycle 2, so saving it again starts a new chain instead of an increment of
+  // cycle 2 that refers to itself
+  mfem::Vector second_phase;
+  {
+    axom::sidre::DataStore datastore;
+    StateManager::initialize(datastore, "restart_chain", 2);
+    auto thermal = buildRestartChainProblem(20.0);
+    EXPECT_EQ(thermal->cycle(), 2);
+
+    mfem::Vector difference(thermal->temperature().gridFunc());
+    difference -= first_phase;
+    EXPECT_LT(difference.Normlinf(), 1.0e-12 * first_phase.Normlinf());
+
+    StateManager::save(thermal->time(), thermal->cycle());
+    thermal->advanceTimestep(dt);
+    StateManager::save(thermal->time(), thermal->cycle());
+    second_phase = thermal->temperature().gridFunc();
+    thermal.reset();
+    StateManager::reset();
+  }
+
+  {
+    axom::sidre::DataStore datastore;
+    StateManager::initialize(datastore, "restart_chain", 3);
+    auto thermal = buildRestartChainProblem(20.0);
+    EXPECT_EQ(thermal->cycle(), 3);
+
+    mfem::Vector difference(thermal->temperature().gridFunc());
+    difference -= second_phase;
+    EXPECT_LT(difference.Normlinf(), 1.0e-12 * second_phase.Normlinf());
+    thermal.reset();
+    StateManager::reset();
+  }
+
+  StateManager::setRestartOptions({});
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/**
+ * @brief A conductivity 1 + T / 2 of the temperature iterate the nonlinear solver is evaluating
+ */
+class IterateConductivity : public mfem::Coefficient {
+public:
+  IterateConductivity(FiniteElementState& temperature) : temperature_(temperature), values_(&temperature.space()) {}
+
+  double Eval(mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip) override
+  {
+    // The nonlinear solver updates the true vector in place, so the values are refreshed whenever it changes
+    const mfem::Vector& iterate = temperature_.trueVec();
+    if (iterate_.Size() != iterate.Size() ||
+        !std::equal(iterate.HostRead(), iterate.HostRead() + iterate.Size(), iterate_.HostRead())) {
+      iterate_ = iterate;
+      values_.SetFromTrueDofs(iterate_);
+    }
+    return 1.0 + 0.5 * values_.GetValue(T, ip);
+  }
+
+private:
+  FiniteElementState&   temperature_;
+  mfem::Vector          iterate_;
+  mfem::ParGridFunction values_;
+};
+
+/**
+ * @brief Solves a quasistatic step with a conductivity that depends on the temperature iterate
+ */
+mfem::Vector solveWithIterateConductivity(const std::string& name, bool cache_element_matrices)
+{
+  auto linear_options    = ThermalConduction::defaultLinearOptions();
+  linear_options.rel_tol = 1.0e-12;
+
+  auto options                   = ThermalConduction::defaultQuasistaticOptions();
+  options.T_lin_options          = linear_options;
+  options.T_nonlin_options       = {.rel_tol = 1.0e-10, .abs_tol = 1.0e-12, .max_iter = 100, .print_level = 0};
+  options.cache_element_matrices = cache_element_matrices;
+
+  ThermalConduction thermal(1, options, name);
+  auto boundary_temperature =
+      std::make_shared<mfem::FunctionCoefficient>([](const mfem::Vector& x) { return 1.0 + x(0); });
+  thermal.setTemperatureBCs({1, 2, 3, 4}, boundary_temperature);
+  thermal.setConductivity(std::make_unique<IterateConductivity>(thermal.temperature()), true);
+  thermal.setSource(std::make_unique<mfem::ConstantCoefficient>(10.0));
+  thermal.completeSetup();
+
+  double dt = 1.0;
+  thermal.advanceTimestep(dt);
+  return thermal.temperature().trueVec();
+}
+
+TEST(thermal_solver, iterate_dependent_conductivity_ignores_cache)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore);
+
+  // Every rank solves the whole problem, so that the conductivity reads the iterate without communication
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildRectangleMesh(6, 6), 0, 0, MPI_COMM_SELF));
+
+  mfem::Vector uncached = solveWithIterateConductivity("uncached", false);
+  mfem::Vector cached   = solveWithIterateConductivity("cached", true);
+
+  mfem::Vector difference(cached);
+  difference -= uncached;
+  EXPECT_LT(difference.Normlinf(), 1.0e-8 * uncached.Normlinf());
+
+  serac::StateManager::reset();
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 
 #include "serac/coefficients/coefficient_extensions.hpp"
 
+#include <cmath>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -85,7 +86,8 @@ void SolveLinear(std::shared_ptr<mfem::ParFiniteElementSpace> pfes_, mfem::Array
 
 // Solve the same linear system using a newton solver
 void SolveNonlinear(std::shared_ptr<mfem::ParFiniteElementSpace> pfes_, mfem::Array<int>& ess_tdof_list,
-                    mfem::ParGridFunction& temp)
+                    mfem::ParGridFunction&               temp,
+                    const mfem_ext::ElementMatrixStorage storage = mfem_ext::ElementMatrixStorage::None)
 {
   mfem::ConstantCoefficient one(1.);
 
@@ -93,7 +95,7 @@ void SolveNonlinear(std::shared_ptr<mfem::ParFiniteElementSpace> pfes_, mfem::Ar
 
   auto diffusion = std::make_shared<mfem::DiffusionIntegrator>(one);
 
-  A_nonlin.AddDomainIntegrator(new mfem_ext::BilinearToNonlinearFormIntegrator(diffusion));
+  A_nonlin.AddDomainIntegrator(new mfem_ext::BilinearToNonlinearFormIntegrator(diffusion, storage));
   A_nonlin.SetEssentialTrueDofs(ess_tdof_list);
 
   mfem::ConstantCoefficient coeff_zero(0.0);
@@ -204,6 +206,17 @@ TEST_F(WrapperTests, nonlinear_linear_thermal)
     EXPECT_NEAR(t_lin[i], t_nonlin[i], 1.e-12);
   }
 
+  // Solve the same problem keeping the element matrices between residual evaluations
+  for (auto storage : {mfem_ext::ElementMatrixStorage::Full, mfem_ext::ElementMatrixStorage::Symmetric}) {
+    mfem::ParGridFunction t_stored(pfes_.get());
+    t_stored = t_ess;
+    SolveNonlinear(pfes_, ess_tdof_list, t_stored, storage);
+
+    for (int i = 0; i < t_lin.Size(); i++) {
+      EXPECT_NEAR(t_lin[i], t_stored[i], 1.e-12);
+    }
+  }
+
   // Solve the same nonlinear problem with the MixedBilinearToNonlinearformIntegrator
   mfem::ParGridFunction t_mixed_nonlin(pfes_.get());
   t_mixed_nonlin = t_ess;
@@ -215,6 +228,43 @@ TEST_F(WrapperTests, nonlinear_linear_thermal)
   }
 }
 
+TEST_F(WrapperTests, element_matrix_storage)
+{
+  mfem::FunctionCoefficient kappa([](const mfem::Vector& x) { return 1.0 + x[0] * x[1]; });
+  auto                      diffusion = std::make_shared<mfem::DiffusionIntegrator>(kappa);
+
+  mfem_ext::BilinearToNonlinearFormIntegrator reassembled(diffusion);
+  mfem_ext::BilinearToNonlinearFormIntegrator full(diffusion, mfem_ext::ElementMatrixStorage::Full);
+  mfem_ext::BilinearToNonlinearFormIntegrator symmetric(diffusion, mfem_ext::ElementMatrixStorage::Symmetric);
+
+  mfem::Vector      elfun, expected_vect, actual_vect;
+  mfem::DenseMatrix expected_mat, actual_mat;
+  for (int repeat = 0; repeat < 2; repeat++) {
+    for (int e = 0; e < pfes_->GetNE(); e++) {
+      const mfem::FiniteElement& el = *pfes_->GetFE(e);
+      elfun.SetSize(el.GetDof());
+      for (int i = 0; i < elfun.Size(); i++) {
+        elfun(i) = std::sin(1.0 + e + i + repeat);
+      }
+
+      reassembled.AssembleElementVector(el, *pfes_->GetElementTransformation(e), elfun, expected_vect);
+      reassembled.AssembleElementGrad(el, *pfes_->GetElementTransformation(e), elfun, expected_mat);
+
+      for (auto* stored : {&full, &symmetric}) {
+        stored->AssembleElementVector(el, *pfes_->GetElementTransformation(e), elfun, actual_vect);
+        stored->AssembleElementGrad(el, *pfes_->GetElementTransformation(e), elfun, actual_mat);
+        for (int i = 0; i < expected_vect.Size(); i++) {
+          EXPECT_NEAR(actual_vect(i), expected_vect(i), 1.e-12);
+          for (int j = 0; j < expected_vect.Size(); j++) {
+            EXPECT_NEAR(actual_mat(i, j), expected_mat(i, j), 1.e-12);
+          }
+        }
+      }
+    }
+    full.invalidateElementMatrices();
+  }
+}
+
 TEST_F(WrapperTests, Transformed)
 {
   // Setup problem
@@ -231,6 +231,18 @@ void runModuleTest(const std::string& input_file, const std::string& test_name,
 template void runModuleTest<Solid>(const std::string&, const std::string&, std::optional<int>);
 template void runModuleTest<ThermalConduction>(const std::string&, const std::string&, std::optional<int>);
 
+std::unique_ptr<mfem::HypreParMatrix> reverseNumbering(mfem::HypreParMatrix& A, mfem::ParFiniteElementSpace& space)
+{
+  const int          size = space.GetTrueVSize();
+  mfem::SparseMatrix reversal(size, size);
+  for (int i = 0; i < size; i++) {
+    reversal.Add(i, size - 1 - i, 1.0);
+  }
+  reversal.Finalize();
+  mfem::HypreParMatrix P(space.GetComm(), space.GlobalTrueVSize(), space.GetTrueDofOffsets(), &reversal);
+  return std::unique_ptr<mfem::HypreParMatrix>(mfem::RAP(&A, &P));
+}
+
 }  // end namespace test_utils
 
 }  // end namespace serac
@@ -5,7 +5,11 @@
 // SPDX-License-Identifier: (BSD-3-Clause)
 #pragma once
 
+#include <memory>
+
 #include <gtest/gtest.h>
+#include "mfem.hpp"
+
 #include "serac/infrastructure/input.hpp"
 
 namespace serac::test_utils {
@@ -27,6 +31,16 @@ void defineTestSchema(axom::inlet::Inlet& inlet);
 template <typename PhysicsModule>
 void runModuleTest(const std::string& input_file, const std::string& test_name, std::optional<int> restart_cycle = {});
 
+/**
+ * @brief Returns P^T A P for the permutation P that reverses the local numbering of the true degrees of freedom
+ *
+ * The result has the nonzero counts of A in every block, but in different columns.
+ *
+ * @param[in] A The matrix to renumber
+ * @param[in] space The finite element space of the rows and columns of A
+ */
+std::unique_ptr<mfem::HypreParMatrix> reverseNumbering(mfem::HypreParMatrix& A, mfem::ParFiniteElementSpace& space);
+
 class InputFileTest : public ::testing::TestWithParam<std::string> {
 };
 